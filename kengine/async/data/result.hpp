@@ -2,10 +2,43 @@
 
 // stl
 #include <future>
+#include <memory>
+
+// kengine
+#include "kengine/async/helpers/task_state.hpp"
 
 namespace kengine::async {
 	template<typename T>
 	struct result {
 		std::future<T> future;
 	};
-}
\ No newline at end of file
+
+	// Result of a task running on the async thread pool
+	template<typename T>
+	struct pooled_result {
+		std::shared_ptr<typed_task_state<T>> state;
+
+		pooled_result(std::shared_ptr<typed_task_state<T>> state) noexcept
+			: state(std::move(state)) {}
+
+		pooled_result(pooled_result &&) noexcept = default;
+		pooled_result & operator=(pooled_result && other) noexcept {
+			release();
+			state = std::move(other.state);
+			return *this;
+		}
+
+		// Like a future returned by std::async, block until the task is done so it can't outlive what it references
+		~pooled_result() noexcept {
+			release();
+		}
+
+		void release() noexcept {
+			if (!state)
+				return;
+			state->cancel();
+			state->wait();
+			state = nullptr;
+		}
+	};
+}
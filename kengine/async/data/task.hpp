@@ -6,10 +6,14 @@
 
 // stl
 #include <chrono>
+#include <memory>
 
 // putils
 #include "putils/string.hpp"
 
+// kengine
+#include "kengine/async/helpers/task_state.hpp"
+
 namespace kengine::async {
 	//! putils reflect all
 	//! used_types: [refltype::string]
@@ -20,6 +24,9 @@ namespace kengine::async {
 
 		//! putils reflect off
 		std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
+
+		//! putils reflect off
+		std::shared_ptr<task_state> state; // Only set for tasks running on the async thread pool
 	};
 }
 
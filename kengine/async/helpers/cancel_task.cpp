@@ -0,0 +1,30 @@
+#include "cancel_task.hpp"
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/async/data/task.hpp"
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::async {
+	bool cancel_task(entt::registry & r, entt::entity e) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto async_task = r.try_get<task>(e);
+		if (!async_task) {
+			kengine_logf(r, verbose, "async", "No async task to cancel in {}", e);
+			return false;
+		}
+
+		if (!async_task->state) {
+			kengine_logf(r, warning, "async", "Async task '{}' can't be cancelled, as it wasn't started on the thread pool", async_task->name);
+			return false;
+		}
+
+		kengine_logf(r, log, "async", "Cancelling async task '{}'", async_task->name);
+		async_task->state->cancel();
+		return true;
+	}
+}
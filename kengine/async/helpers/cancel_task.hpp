@@ -0,0 +1,8 @@
+#pragma once
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+namespace kengine::async {
+	KENGINE_ASYNC_EXPORT bool cancel_task(entt::registry & r, entt::entity e) noexcept;
+}
@@ -9,6 +9,7 @@
 // kengine
 #include "kengine/async/data/result.hpp"
 #include "kengine/async/data/task.hpp"
+#include "kengine/async/helpers/task_state.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 
@@ -47,6 +48,35 @@ namespace kengine::async {
 			func(e, std::move(data));
 		}
 
-		return r.view<result<T>>().empty();
+		// Tasks running on the thread pool report themselves once complete, so running ones are never touched
+		if (const auto queue = find_completion_queue<T>(r))
+			queue->consume_all([&](std::shared_ptr<typed_task_state<T>> && state) {
+				const auto e = state->e;
+				const auto pooled = r.try_get<pooled_result<T>>(e);
+				if (!pooled || pooled->state != state) {
+					kengine_logf(r, verbose, log_category, "Ignoring completed async task for {}, as its result was removed", e);
+					return;
+				}
+
+				const auto & async_task = r.get<task>(e);
+				const auto time_running = now - async_task.start;
+				if (state->status == task_status::cancelled || state->stop.stop_requested()) {
+					kengine_logf(r, log, log_category, "Async task '{}' cancelled after {:%S}s", async_task.name, time_running);
+					r.erase<task>(e);
+					r.erase<pooled_result<T>>(e);
+					return;
+				}
+
+				kengine_logf(r, log, log_category, "Async task '{}' completed after {:%S}s", async_task.name, time_running);
+
+				auto data = std::move(*state->value);
+
+				r.erase<task>(e);
+				r.erase<pooled_result<T>>(e);
+
+				func(e, std::move(data));
+			});
+
+		return r.view<result<T>>().empty() && r.view<pooled_result<T>>().empty();
 	}
 }
\ No newline at end of file
@@ -3,16 +3,41 @@
 // stl
 #include <concepts>
 #include <future>
+#include <stop_token>
+#include <type_traits>
 
 // entt
 #include <entt/entity/fwd.hpp>
 
 // kengine
 #include "kengine/async/data/task.hpp"
+#include "kengine/core/helpers/thread_pool.hpp"
 
 namespace kengine::async {
+	using priority = thread_pool::priority;
+
+	template<typename Func>
+	concept task_function = std::invocable<Func> || std::invocable<Func, std::stop_token>;
+
+	template<typename Func, bool TakesStopToken = std::invocable<Func, std::stop_token>>
+	struct task_return_type {
+		using type = std::decay_t<std::invoke_result_t<Func>>;
+	};
+
+	template<typename Func>
+	struct task_return_type<Func, true> {
+		using type = std::decay_t<std::invoke_result_t<Func, std::stop_token>>;
+	};
+
+	// Must be called before start_task may run on other threads, typically from a system's constructor
+	template<typename T>
+	void prepare_tasks(entt::registry & r) noexcept;
+
 	template<typename T>
 	void start_task(entt::registry & r, entt::entity e, const task::string & task_name, std::future<T> && future) noexcept;
+
+	template<task_function Func>
+	void start_task(entt::registry & r, entt::entity e, const task::string & task_name, Func && func, priority task_priority = priority::normal) noexcept;
 }
 
-#include "start_task.inl"
\ No newline at end of file
+#include "start_task.inl"
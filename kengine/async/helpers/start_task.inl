@@ -3,10 +3,17 @@
 // kengine
 #include "kengine/async/data/result.hpp"
 #include "kengine/async/data/task.hpp"
+#include "kengine/async/helpers/task_state.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 
 namespace kengine::async {
+	template<typename T>
+	void prepare_tasks(entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		create_completion_queue<T>(r);
+	}
+
 	template<typename T>
 	void start_task(entt::registry & r, entt::entity e, const task::string & task_name, std::future<T> && future) noexcept {
 		KENGINE_PROFILING_SCOPE;
@@ -15,4 +22,36 @@ namespace kengine::async {
 		r.emplace<task>(e, task_name);
 		r.emplace<result<T>>(e, std::move(future));
 	}
-}
\ No newline at end of file
+
+	template<task_function Func>
+	void start_task(entt::registry & r, entt::entity e, const task::string & task_name, Func && func, priority task_priority) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		static constexpr bool takes_stop_token = std::invocable<Func, std::stop_token>;
+		using return_type = typename task_return_type<Func>::type;
+
+		kengine_logf(r, log, "async", "Async task '{}' starting on thread pool", task_name);
+
+		auto state = std::make_shared<typed_task_state<return_type>>();
+		state->e = e;
+
+		auto & new_task = r.emplace<task>(e, task_name);
+		new_task.state = state;
+		r.emplace<pooled_result<return_type>>(e, state);
+
+		get_thread_pool().push(
+			[state, queue = get_completion_queue<return_type>(r), func = std::forward<Func>(func)]() mutable noexcept {
+				// Cancelled tasks are skipped, but still reported so that their components get cleaned up
+				if (state->try_start()) {
+					if constexpr (takes_stop_token)
+						state->value.emplace(func(state->stop.get_token()));
+					else
+						state->value.emplace(func());
+					state->finish();
+				}
+				queue->push(std::move(state));
+			},
+			task_priority
+		);
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+// stl
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+
+// entt
+#include <entt/entity/entity.hpp>
+#include <entt/entity/fwd.hpp>
+
+namespace kengine::async {
+	enum class task_status {
+		pending,
+		running,
+		complete,
+		cancelled,
+	};
+
+	// Shared between the main thread and the worker running the task
+	struct task_state {
+		std::atomic<task_status> status = task_status::pending;
+		std::stop_source stop;
+
+		std::mutex mutex;
+		std::condition_variable condition;
+
+		bool try_start() noexcept;
+		void finish() noexcept;
+		void cancel() noexcept;
+		void wait() noexcept;
+	};
+
+	template<typename T>
+	struct typed_task_state : task_state {
+		entt::entity e = entt::null;
+		std::optional<T> value;
+	};
+
+	// Lock-free multi-producer single-consumer queue of completed tasks
+	template<typename T>
+	struct completion_queue {
+		struct node {
+			std::shared_ptr<typed_task_state<T>> state;
+			node * next = nullptr;
+		};
+
+		std::atomic<node *> head = nullptr;
+
+		completion_queue() noexcept = default;
+		~completion_queue() noexcept;
+
+		completion_queue(const completion_queue &) = delete;
+		completion_queue & operator=(const completion_queue &) = delete;
+
+		void push(std::shared_ptr<typed_task_state<T>> state) noexcept;
+
+		// Calls func for each completed task, in order of completion
+		template<std::invocable<std::shared_ptr<typed_task_state<T>> &&> Func>
+		void consume_all(Func && func) noexcept;
+	};
+
+	// Queues are shared with the worker threads, so they're stored by pointer in the registry's context
+	// The context can't be safely modified once systems run in parallel, so queues are created up front by prepare_tasks
+	template<typename T>
+	void create_completion_queue(entt::registry & r) noexcept;
+
+	template<typename T>
+	const std::shared_ptr<completion_queue<T>> & get_completion_queue(entt::registry & r) noexcept;
+
+	template<typename T>
+	completion_queue<T> * find_completion_queue(entt::registry & r) noexcept;
+}
+
+#include "task_state.inl"
@@ -0,0 +1,91 @@
+#include "task_state.hpp"
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/assert/helpers/kengine_assert.hpp"
+
+namespace kengine::async {
+	inline bool task_state::try_start() noexcept {
+		auto expected = task_status::pending;
+		return status.compare_exchange_strong(expected, task_status::running);
+	}
+
+	inline void task_state::finish() noexcept {
+		{
+			const std::lock_guard lock(mutex);
+			status = task_status::complete;
+		}
+		condition.notify_all();
+	}
+
+	inline void task_state::cancel() noexcept {
+		stop.request_stop();
+		auto expected = task_status::pending;
+		status.compare_exchange_strong(expected, task_status::cancelled);
+	}
+
+	inline void task_state::wait() noexcept {
+		std::unique_lock lock(mutex);
+		condition.wait(lock, [this] { return status != task_status::running; });
+	}
+
+	template<typename T>
+	completion_queue<T>::~completion_queue() noexcept {
+		consume_all([](auto &&) {});
+	}
+
+	template<typename T>
+	void completion_queue<T>::push(std::shared_ptr<typed_task_state<T>> state) noexcept {
+		const auto new_node = new node{ std::move(state), head.load(std::memory_order_relaxed) };
+		while (!head.compare_exchange_weak(new_node->next, new_node, std::memory_order_release, std::memory_order_relaxed))
+			;
+	}
+
+	template<typename T>
+	template<std::invocable<std::shared_ptr<typed_task_state<T>> &&> Func>
+	void completion_queue<T>::consume_all(Func && func) noexcept {
+		// Take the whole list at once, then reverse it since it was built as a stack
+		node * reversed = nullptr;
+		auto current = head.exchange(nullptr, std::memory_order_acquire);
+		while (current) {
+			const auto next = current->next;
+			current->next = reversed;
+			reversed = current;
+			current = next;
+		}
+
+		while (reversed) {
+			const auto next = reversed->next;
+			func(std::move(reversed->state));
+			delete reversed;
+			reversed = next;
+		}
+	}
+
+	template<typename T>
+	void create_completion_queue(entt::registry & r) noexcept {
+		using queue_ptr = std::shared_ptr<completion_queue<T>>;
+		if (!r.ctx().contains<queue_ptr>())
+			r.ctx().emplace<queue_ptr>(std::make_shared<completion_queue<T>>());
+	}
+
+	template<typename T>
+	const std::shared_ptr<completion_queue<T>> & get_completion_queue(entt::registry & r) noexcept {
+		using queue_ptr = std::shared_ptr<completion_queue<T>>;
+		if (const auto queue = r.ctx().find<queue_ptr>())
+			return *queue;
+
+		// Only safe if no other system is running, which is why systems call prepare_tasks when they're created
+		kengine_assert_failed(r, "Async task started without calling prepare_tasks for its return type");
+		create_completion_queue<T>(r);
+		return r.ctx().get<queue_ptr>();
+	}
+
+	template<typename T>
+	completion_queue<T> * find_completion_queue(entt::registry & r) noexcept {
+		const auto queue = r.ctx().find<std::shared_ptr<completion_queue<T>>>();
+		return queue ? queue->get() : nullptr;
+	}
+}
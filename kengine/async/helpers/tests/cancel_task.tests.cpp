@@ -0,0 +1,61 @@
+// stl
+#include <atomic>
+
+// gtest
+#include <gtest/gtest.h>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/async/data/task.hpp"
+#include "kengine/async/helpers/cancel_task.hpp"
+#include "kengine/async/helpers/process_results.hpp"
+#include "kengine/async/helpers/start_task.hpp"
+
+TEST(async, cancel_task_no_task) {
+	entt::registry r;
+	const auto e = r.create();
+	EXPECT_FALSE(kengine::async::cancel_task(r, e));
+}
+
+TEST(async, cancel_task_future) {
+	entt::registry r;
+	const auto e = r.create();
+	kengine::async::start_task(
+		r, e,
+		"task_name",
+		std::async(std::launch::deferred, [] { return 42; })
+	);
+	EXPECT_FALSE(kengine::async::cancel_task(r, e));
+}
+
+TEST(async, cancel_task_stop_token) {
+	entt::registry r;
+	kengine::async::prepare_tasks<int>(r);
+	const auto e = r.create();
+
+	std::atomic<bool> started = false;
+	kengine::async::start_task(
+		r, e,
+		"task_name",
+		[&](std::stop_token stop) {
+			started = true;
+			while (!stop.stop_requested())
+				;
+			return 42;
+		}
+	);
+
+	while (!started)
+		;
+	EXPECT_TRUE(kengine::async::cancel_task(r, e));
+
+	int processed = 0;
+	while (!kengine::async::process_results<int>(r, [&](entt::entity, int) {
+		++processed;
+	}))
+		;
+	EXPECT_EQ(processed, 0);
+	EXPECT_FALSE(r.all_of<kengine::async::task>(e));
+}
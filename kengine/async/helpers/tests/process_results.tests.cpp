@@ -94,3 +94,70 @@ TEST(async, process_results_async_side_effect) {
 	EXPECT_EQ(processed, 1);
 	EXPECT_EQ(result, 42);
 }
+
+TEST(async, process_results_thread_pool_return_value) {
+	entt::registry r;
+	kengine::async::prepare_tasks<int>(r);
+	const auto e = r.create();
+	kengine::async::start_task(
+		r, e,
+		kengine::async::task::string("{} {}", "hello", 0),
+		[] {
+			return 42;
+		}
+	);
+
+	int processed = 0;
+	while (!kengine::async::process_results<int>(r, [&](entt::entity processed_entity, int result) {
+		++processed;
+		EXPECT_EQ(processed_entity, e);
+		EXPECT_EQ(result, 42);
+	}))
+		;
+	EXPECT_EQ(processed, 1);
+	EXPECT_FALSE(r.all_of<kengine::async::task>(e));
+}
+
+TEST(async, process_results_thread_pool_many_tasks) {
+	entt::registry r;
+	kengine::async::prepare_tasks<int>(r);
+	for (int i = 0; i < 100; ++i)
+		kengine::async::start_task(
+			r, r.create(),
+			kengine::async::task::string("task {}", i),
+			[i] {
+				return i;
+			},
+			i % 2 ? kengine::async::priority::high : kengine::async::priority::low
+		);
+
+	int processed = 0;
+	int sum = 0;
+	while (!kengine::async::process_results<int>(r, [&](entt::entity, int result) {
+		++processed;
+		sum += result;
+	}))
+		;
+	EXPECT_EQ(processed, 100);
+	EXPECT_EQ(sum, 99 * 100 / 2);
+}
+
+TEST(async, process_results_thread_pool_destroyed_entity) {
+	entt::registry r;
+	kengine::async::prepare_tasks<int>(r);
+	const auto e = r.create();
+	kengine::async::start_task(
+		r, e,
+		kengine::async::task::string("{} {}", "hello", 0),
+		[] {
+			return 42;
+		}
+	);
+	r.destroy(e);
+
+	int processed = 0;
+	EXPECT_TRUE(kengine::async::process_results<int>(r, [&](entt::entity, int) {
+		++processed;
+	}));
+	EXPECT_EQ(processed, 0);
+}
@@ -1,3 +1,8 @@
+// stl
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 // gtest
 #include <gtest/gtest.h>
 
@@ -35,3 +40,54 @@ TEST(async, start_task_formatted_name) {
 	);
 	EXPECT_EQ(r.get<kengine::async::task>(e).name, "hello 0");
 }
+
+TEST(async, prepare_tasks) {
+	entt::registry r;
+	EXPECT_EQ(kengine::async::find_completion_queue<int>(r), nullptr);
+
+	kengine::async::prepare_tasks<int>(r);
+	const auto queue = kengine::async::find_completion_queue<int>(r);
+	EXPECT_NE(queue, nullptr);
+
+	// Preparing again keeps the existing queue, which running tasks may hold
+	kengine::async::prepare_tasks<int>(r);
+	EXPECT_EQ(kengine::async::find_completion_queue<int>(r), queue);
+}
+
+TEST(async, start_task_thread_pool_component_created) {
+	entt::registry r;
+	kengine::async::prepare_tasks<int>(r);
+	const auto e = r.create();
+	kengine::async::start_task(
+		r, e,
+		"task_name",
+		[] { return 42; }
+	);
+
+	EXPECT_TRUE(r.all_of<kengine::async::task>(e));
+	EXPECT_EQ(r.get<kengine::async::task>(e).name, "task_name");
+	EXPECT_NE(r.get<kengine::async::task>(e).state, nullptr);
+}
+
+TEST(async, start_task_thread_pool_destroy_waits) {
+	std::atomic<bool> done = false;
+	{
+		entt::registry r;
+		kengine::async::prepare_tasks<int>(r);
+		const auto e = r.create();
+		kengine::async::start_task(
+			r, e,
+			"task_name",
+			[&] {
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				done = true;
+				return 0;
+			}
+		);
+
+		// Make sure the task has started, so destroying the registry has to wait for it
+		while (r.get<kengine::async::task>(e).state->status == kengine::async::task_status::pending)
+			;
+	}
+	EXPECT_TRUE(done);
+}
@@ -17,7 +17,7 @@
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 
 namespace kengine::async::imgui {
 	static constexpr auto log_category = "async_imgui";
@@ -35,10 +35,10 @@ namespace kengine::async::imgui {
 			auto & tool = e.emplace<kengine::imgui::tool::tool>();
 			enabled = &tool.enabled;
 
-			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute));
 		}
 
-		void execute(float delta_time) noexcept {
+		void execute(float delta_time, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#ifndef KENGINE_BINARY_SCENE_LOADER_STRING_MAX_LENGTH
+#define KENGINE_BINARY_SCENE_LOADER_STRING_MAX_LENGTH 64
+#endif
+
+// putils
+#include "putils/string.hpp"
+
+namespace kengine::binary_scene_loader {
+	//! putils reflect all
+	//! used_types: [refltype::string]
+	struct request {
+		static constexpr char string_name[] = "binary_scene_loader_request_string";
+		using string = putils::string<KENGINE_BINARY_SCENE_LOADER_STRING_MAX_LENGTH, string_name>;
+
+		string temporary_scene;
+		string model_directory;
+		string scene;
+	};
+}
+
+#include "request.rpp"
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "convert_scene.hpp"
+
+// stl
+#include <fstream>
+#include <vector>
+
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// nlohmann
+#include <nlohmann/json.hpp>
+
+// putils
+#include "putils/range.hpp"
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/binary/helpers/load_scene.hpp"
+#include "kengine/meta/binary/helpers/mapped_file.hpp"
+#include "kengine/meta/binary/helpers/save_scene.hpp"
+#include "kengine/meta/json/helpers/load_entities.hpp"
+#include "kengine/meta/json/helpers/save_entity.hpp"
+
+namespace kengine::binary_scene_loader {
+	static constexpr auto log_category = "binary_scene_loader";
+
+	bool convert_json_scene_to_binary(const char * json_file, const char * binary_file, entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, log, log_category, "Converting JSON scene {} to binary scene {}", json_file, binary_file);
+
+		std::ifstream input(json_file);
+		if (!input) {
+			kengine_logf(r, error, log_category, "Failed to open {}", json_file);
+			return false;
+		}
+
+		const auto scene_json = nlohmann::json::parse(input, nullptr, false);
+		if (scene_json.is_discarded() || !scene_json.is_array()) {
+			kengine_logf(r, error, log_category, "{} is not a valid JSON scene", json_file);
+			return false;
+		}
+
+		// Entities only live long enough to be saved
+		const auto & entities_json = scene_json.get_ref<const nlohmann::json::array_t &>();
+		std::vector<entt::entity> entities(entities_json.size());
+		r.create(entities.begin(), entities.end());
+		meta::json::load_entities(entities_json, entities, r);
+		const auto data = meta::binary::save_scene(entities, r);
+		r.destroy(putils_range(entities));
+
+		std::ofstream output(binary_file, std::ios::binary);
+		if (!output) {
+			kengine_logf(r, error, log_category, "Failed to open {}", binary_file);
+			return false;
+		}
+
+		output.write(reinterpret_cast<const char *>(data.data()), std::streamsize(data.size()));
+		return bool(output);
+	}
+
+	bool convert_binary_scene_to_json(const char * binary_file, const char * json_file, entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, log, log_category, "Converting binary scene {} to JSON scene {}", binary_file, json_file);
+
+		const meta::binary::mapped_file input(binary_file);
+		if (!input.is_open()) {
+			kengine_logf(r, error, log_category, "Failed to open {}", binary_file);
+			return false;
+		}
+
+		// Entities only live long enough to be saved
+		const auto entities = meta::binary::load_scene(input.get_data(), r);
+		auto scene_json = nlohmann::json::array();
+		for (const auto e : entities)
+			scene_json.push_back(meta::json::save_entity({ r, e }));
+		r.destroy(putils_range(entities));
+
+		std::ofstream output(json_file);
+		if (!output) {
+			kengine_logf(r, error, log_category, "Failed to open {}", json_file);
+			return false;
+		}
+
+		output << scene_json.dump(4);
+		return bool(output);
+	}
+}
\ No newline at end of file
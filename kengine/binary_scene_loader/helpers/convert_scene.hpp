@@ -0,0 +1,9 @@
+#pragma once
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+namespace kengine::binary_scene_loader {
+	KENGINE_BINARY_SCENE_LOADER_EXPORT bool convert_json_scene_to_binary(const char * json_file, const char * binary_file, entt::registry & r) noexcept;
+	KENGINE_BINARY_SCENE_LOADER_EXPORT bool convert_binary_scene_to_json(const char * binary_file, const char * json_file, entt::registry & r) noexcept;
+}
\ No newline at end of file
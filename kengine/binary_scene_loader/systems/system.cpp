@@ -0,0 +1,238 @@
+#include "system.hpp"
+
+// stl
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// putils
+#include "putils/forward_to.hpp"
+#include "putils/range.hpp"
+
+// kengine
+#include "kengine/async/helpers/process_results.hpp"
+#include "kengine/async/helpers/start_task.hpp"
+#include "kengine/binary_scene_loader/data/request.hpp"
+#include "kengine/binary_scene_loader/helpers/convert_scene.hpp"
+#include "kengine/command_line/helpers/parse.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/helpers/stop_running.hpp"
+#include "kengine/meta/binary/helpers/load_scene.hpp"
+#include "kengine/meta/binary/helpers/mapped_file.hpp"
+
+#ifndef KENGINE_BINARY_SCENE_LOADER_EXTENSION
+#define KENGINE_BINARY_SCENE_LOADER_EXTENSION ".kbs"
+#endif
+
+namespace kengine::binary_scene_loader {
+	struct system {
+		static constexpr auto log_category = "binary_scene_loader";
+		entt::registry & r;
+
+		struct processed {};
+		kengine::reactive_entity_processor<processed, request> processor{ r, putils_forward_to_this(process_new_request) };
+
+		// Command-line arguments
+		struct options {
+			std::optional<std::string> convert_scene;
+			std::optional<std::string> convert_scene_output;
+		};
+		options args;
+
+		system(entt::handle e) noexcept
+			: r(*e.registry()) {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, log, log_category, "Initializing");
+
+			args = kengine::command_line::parse<options>(r);
+
+			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			kengine::async::prepare_tasks<load_models_task>(r);
+			processor.process();
+		}
+
+		struct temporary_scene {
+			std::vector<entt::entity> loaded_entities;
+		};
+		struct load_models_task {
+			std::vector<std::unique_ptr<meta::binary::mapped_file>> models;
+		};
+		void execute(float delta_time) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Executing");
+
+			if (args.convert_scene) {
+				// Types have all been registered by the time the main loop starts
+				convert_scene();
+				args.convert_scene = std::nullopt;
+			}
+
+			processor.process();
+
+			kengine::async::process_results<load_models_task>(r, [this](entt::entity e, load_models_task && task) {
+				// Files were only mapped by the async task, the registry is filled from the main thread
+				kengine_logf(r, log, log_category, "Creating models from {} files", task.models.size());
+				for (const auto & model : task.models)
+					meta::binary::load_scene(model->get_data(), r);
+
+				// Entity that will wait until all async loading tasks are completed before loading the scene
+				const auto poller = r.create();
+				kengine_logf(r, verbose, log_category, "Creating polling entity {}", poller);
+				r.emplace<main_loop::execute>(poller, [this, e, poller](float delta_time) {
+					if (!r.view<async::task>().empty()) {
+						kengine_log(r, verbose, log_category, "Waiting to load scene (async_tasks are still running)");
+						return;
+					}
+
+					kengine_log(r, log, log_category, "Destroying temporary scene");
+					const auto & scene = r.get<temporary_scene>(e);
+					r.destroy(putils_range(scene.loaded_entities));
+
+					const auto & comp = r.get<request>(e);
+					load_scene(comp.scene.c_str());
+
+					kengine_logf(r, verbose, log_category, "Destroying polling entity {}", poller);
+					r.destroy(poller);
+				});
+			});
+		}
+
+		void convert_scene() noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto & input = *args.convert_scene;
+			const bool from_json = std::filesystem::path(input).extension() == ".json";
+
+			std::filesystem::path output = args.convert_scene_output ? *args.convert_scene_output : input;
+			if (!args.convert_scene_output)
+				output.replace_extension(from_json ? KENGINE_BINARY_SCENE_LOADER_EXTENSION : ".json");
+
+			const auto succeeded = from_json ?
+				convert_json_scene_to_binary(input.c_str(), output.string().c_str(), r) :
+				convert_binary_scene_to_json(input.c_str(), output.string().c_str(), r);
+
+			if (succeeded)
+				kengine_logf(r, log, log_category, "Converted {} to {}", input, output.string());
+
+			// Conversion is a one-off tool invocation
+			main_loop::stop_running(r);
+		}
+
+		void process_new_request(entt::entity e, const request & comp) noexcept {
+			kengine_logf(r, verbose, log_category, "Processing new request {}", e);
+
+			if (comp.model_directory.empty()) {
+				if (!comp.scene.empty())
+					load_scene(comp.scene.c_str());
+				else
+					kengine_logf(r, warning, log_category, "Empty request found in {}", e);
+				return;
+			}
+
+			r.emplace<temporary_scene>(e, load_temporary_scene(comp.temporary_scene.c_str()));
+			start_async_model_loading(e, comp);
+		}
+
+		void start_async_model_loading(entt::entity e, const request & comp) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			kengine::async::start_task(
+				r, e,
+				async::task::string("binary_scene_loader: load models from {}", comp.model_directory),
+				[this, dir = comp.model_directory] {
+					return load_models(dir.c_str());
+				},
+				async::priority::high
+			);
+		}
+
+		temporary_scene load_temporary_scene(const char * file) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			temporary_scene scene;
+			if (file[0] == 0) {
+				kengine_log(r, warning, log_category, "No temporary scene specified, consider adding a loading screen");
+				return scene;
+			}
+
+			kengine_logf(r, log, log_category, "Loading temporary scene from {}", file);
+
+			const meta::binary::mapped_file f(file);
+			if (!f.is_open()) {
+				kengine_logf(r, error, log_category, "Failed to open {}", file);
+				return scene;
+			}
+
+			scene.loaded_entities = meta::binary::load_scene(f.get_data(), r);
+
+			kengine_log(r, log, log_category, "Temporary scene loaded");
+
+			return scene;
+		}
+
+		load_models_task load_models(const char * dir) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			if (!std::filesystem::is_directory(dir)) {
+				kengine_logf(r, error, log_category, "{} is not a directory", dir);
+				return {};
+			}
+
+			load_models_task task;
+			for (const auto & entry : std::filesystem::recursive_directory_iterator(dir)) {
+				if (entry.path().extension() != KENGINE_BINARY_SCENE_LOADER_EXTENSION)
+					continue;
+
+				auto model = std::make_unique<meta::binary::mapped_file>(entry.path().string().c_str());
+				if (!model->is_open()) {
+					kengine_logf(r, error, log_category, "Failed to open {}", entry.path().string());
+					continue;
+				}
+
+				kengine_logf(r, verbose, log_category, "Mapped model file {}", entry.path().string());
+				task.models.push_back(std::move(model));
+			}
+
+			return task;
+		}
+
+		void load_scene(const char * file) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, log, log_category, "Loading scene from {}", file);
+
+			const meta::binary::mapped_file f(file);
+			if (!f.is_open()) {
+				kengine_logf(r, error, log_category, "Failed to open {}", file);
+				return;
+			}
+
+			meta::binary::load_scene(f.get_data(), r);
+
+			kengine_log(r, log, log_category, "Scene loaded");
+		}
+	};
+
+	DEFINE_KENGINE_SYSTEM_CREATOR(
+		system,
+		system::processed,
+		system::temporary_scene
+	)
+}
+
+#define refltype kengine::binary_scene_loader::system::options
+putils_reflection_info {
+	putils_reflection_custom_class_name(binary scene loader);
+	putils_reflection_attributes(
+		putils_reflection_attribute(convert_scene),
+		putils_reflection_attribute(convert_scene_output)
+	)
+};
+#undef refltype
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+// kengine
+#include "kengine/system_creator/helpers/system_creator_helper.hpp"
+
+namespace kengine::binary_scene_loader {
+	DECLARE_KENGINE_SYSTEM_CREATOR(KENGINE_BINARY_SCENE_LOADER_EXPORT, system)
+}
\ No newline at end of file
@@ -18,12 +18,12 @@
 #include "kengine/config/data/configurable.hpp"
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
 #include "kengine/core/data/name.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 #include "kengine/meta/functions/has.hpp"
 #include "kengine/meta/functions/has_metadata.hpp"
 #include "kengine/meta/imgui/functions/edit.hpp"
@@ -57,14 +57,14 @@ namespace kengine::config::imgui {
 
 		// Add new section to ImGui tree when config is created
 		struct processed {};
-		kengine::new_entity_processor<processed, core::name, configurable> processor{ r, putils_forward_to_this(on_construct_config) };
+		kengine::reactive_entity_processor<processed, core::name, configurable> processor{ r, putils_forward_to_this(on_construct_config) };
 
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, log, log_category, "Initializing");
 
-			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute));
 
 			e.emplace<core::name>("Config values");
 			auto & tool = e.emplace<kengine::imgui::tool::tool>();
@@ -75,7 +75,7 @@ namespace kengine::config::imgui {
 
 		char name_search[1024] = "";
 		bool search_out_of_date = true;
-		void execute(float delta_time) noexcept {
+		void execute(float delta_time, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
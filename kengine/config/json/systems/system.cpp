@@ -20,7 +20,7 @@
 #include "kengine/command_line/data/arguments.hpp"
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
 #include "kengine/core/data/name.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
@@ -48,7 +48,7 @@ namespace kengine::config::json {
 
 		// Initialize new config values with the JSON contents
 		struct processed {};
-		kengine::new_entity_processor<processed, core::name, configurable> processor{ r, putils_forward_to_this(on_construct_config) };
+		kengine::reactive_entity_processor<processed, core::name, configurable> processor{ r, putils_forward_to_this(on_construct_config) };
 
 		// Save to the JSON file when config values change
 		const entt::scoped_connection connection = r.on_update<configurable>().connect<&system::save>(this);
@@ -0,0 +1,50 @@
+#pragma once
+
+// stl
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// entt
+#include <entt/entity/fwd.hpp>
+#include <entt/signal/sigh.hpp>
+
+// kengine
+#include "kengine/core/helpers/new_entity_processor.hpp"
+
+namespace kengine {
+	template<typename ProcessedTag, typename... Comps>
+	struct reactive_entity_processor {
+		using callback_signature = typename new_entity_processor<ProcessedTag, Comps...>::callback_signature;
+		using callback_type = std::function<callback_signature>;
+
+		struct batch_callback {
+			std::function<void(std::span<const entt::entity>)> function;
+		};
+
+		reactive_entity_processor(entt::registry & r, const callback_type & callback) noexcept;
+		reactive_entity_processor(entt::registry & r, const batch_callback & callback) noexcept;
+
+		// Signals are connected to `this`
+		reactive_entity_processor(const reactive_entity_processor &) = delete;
+		reactive_entity_processor & operator=(const reactive_entity_processor &) = delete;
+
+		void process() noexcept;
+
+		void connect() noexcept;
+		void on_candidate(entt::registry &, entt::entity e) noexcept;
+		bool is_new(entt::entity e) const noexcept;
+
+		entt::registry & r;
+		callback_type callback;
+		batch_callback batch;
+
+		std::mutex pending_mutex; // Signals may be emitted from any thread, e.g. by systems running in parallel
+		std::vector<entt::entity> pending;
+		std::vector<entt::entity> processing; // Kept around to avoid re-allocating
+		std::vector<entt::scoped_connection> connections;
+	};
+}
+
+#include "reactive_entity_processor.inl"
\ No newline at end of file
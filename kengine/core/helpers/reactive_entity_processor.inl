@@ -0,0 +1,107 @@
+#include "reactive_entity_processor.hpp"
+
+// stl
+#include <tuple>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/helpers/register_storage.hpp"
+
+namespace kengine {
+	template<typename ProcessedTag, typename... Comps>
+	reactive_entity_processor<ProcessedTag, Comps...>::reactive_entity_processor(entt::registry & r, const callback_type & callback) noexcept
+		: r(r),
+		  callback(callback) {
+		connect();
+	}
+
+	template<typename ProcessedTag, typename... Comps>
+	reactive_entity_processor<ProcessedTag, Comps...>::reactive_entity_processor(entt::registry & r, const batch_callback & callback) noexcept
+		: r(r),
+		  batch(callback) {
+		connect();
+	}
+
+	template<typename ProcessedTag, typename... Comps>
+	void reactive_entity_processor<ProcessedTag, Comps...>::connect() noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (!meta::is_storage_registered<ProcessedTag>(r)) {
+			kengine_log(r, verbose, "reactive_entity_processor", "Processed tag wasn't pre-registered. Consider pre-registering it to avoid potential race conditions.");
+			meta::register_storage<ProcessedTag>(r);
+		}
+
+		// Entities become candidates when they get the last of Comps, or lose ProcessedTag
+		connections.reserve(sizeof...(Comps) + 1);
+		(connections.emplace_back(r.on_construct<Comps>().template connect<&reactive_entity_processor::on_candidate>(this)), ...);
+		connections.emplace_back(r.on_destroy<ProcessedTag>().template connect<&reactive_entity_processor::on_candidate>(this));
+
+		// Entities created before the processor only need to be scanned once
+		for (const auto e : r.view<Comps...>(entt::exclude<ProcessedTag>))
+			pending.push_back(e);
+	}
+
+	template<typename ProcessedTag, typename... Comps>
+	void reactive_entity_processor<ProcessedTag, Comps...>::on_candidate(entt::registry &, entt::entity e) noexcept {
+		// ProcessedTag is still attached when its on_destroy is emitted, so it's checked in `process` instead
+		if (r.all_of<Comps...>(e)) {
+			const std::lock_guard lock(pending_mutex);
+			pending.push_back(e);
+		}
+	}
+
+	template<typename ProcessedTag, typename... Comps>
+	bool reactive_entity_processor<ProcessedTag, Comps...>::is_new(entt::entity e) const noexcept {
+		// Entities may have been destroyed, lost a component or been processed twice since they were queued
+		return r.valid(e) && r.all_of<Comps...>(e) && !r.all_of<ProcessedTag>(e);
+	}
+
+	template<typename ProcessedTag, typename... Comps>
+	void reactive_entity_processor<ProcessedTag, Comps...>::process() noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		{
+			const std::lock_guard lock(pending_mutex);
+			if (pending.empty())
+				return;
+
+			// Callbacks may create new entities, which will be processed on the next call
+			processing.clear();
+			std::swap(processing, pending);
+		}
+
+		kengine_logf(r, very_verbose, "reactive_entity_processor", "Processing {} new entities", processing.size());
+
+		if (batch.function) {
+			// Tag entities as they're kept, so that entities queued twice are only passed once
+			size_t count = 0;
+			for (const auto e : processing)
+				if (is_new(e)) {
+					r.emplace<ProcessedTag>(e);
+					processing[count++] = e;
+				}
+			processing.resize(count);
+
+			if (!processing.empty())
+				batch.function(processing);
+			return;
+		}
+
+		for (const auto e : processing) {
+			if (!is_new(e))
+				continue;
+
+			kengine_logf(r, very_verbose, "reactive_entity_processor", "Processing {}", e);
+
+			r.emplace<ProcessedTag>(e);
+			if constexpr (detail::any_is_empty<Comps...>())
+				callback(e);
+			else
+				callback(e, r.get<Comps>(e)...);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+// stl
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace kengine {
+	// Transparent hash, so that string-keyed containers can be searched with a std::string_view or const char * without allocating
+	struct string_hash {
+		using is_transparent = void;
+		size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+	};
+
+	template<typename T>
+	using string_map = std::unordered_map<std::string, T, string_hash, std::equal_to<>>;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+// stl
+#include <chrono>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
+
+TEST(reactive_entity_processor, created_before) {
+	entt::registry r;
+	const auto e = r.create();
+	r.emplace<int>(e, 42);
+	r.emplace<double>(e, 84.);
+
+	struct processed {};
+	std::vector<entt::entity> processed_entities;
+	kengine::reactive_entity_processor<processed, int, double> processor{ r, [&](entt::entity e, int i, double d) {
+		EXPECT_EQ(i, 42);
+		EXPECT_EQ(d, 84.);
+		processed_entities.push_back(e);
+	} };
+
+	processor.process();
+	EXPECT_EQ(processed_entities, std::vector<entt::entity>{ e });
+
+	processor.process();
+	EXPECT_EQ(processed_entities.size(), 1);
+}
+
+TEST(reactive_entity_processor, created_after) {
+	entt::registry r;
+
+	struct processed {};
+	std::vector<entt::entity> processed_entities;
+	kengine::reactive_entity_processor<processed, int, double> processor{ r, [&](entt::entity e, int, double) {
+		processed_entities.push_back(e);
+	} };
+
+	const auto e = r.create();
+	r.emplace<int>(e, 42);
+	processor.process();
+	EXPECT_TRUE(processed_entities.empty());
+
+	r.emplace<double>(e, 84.);
+	processor.process();
+	EXPECT_EQ(processed_entities, std::vector<entt::entity>{ e });
+	EXPECT_TRUE(r.all_of<processed>(e));
+}
+
+TEST(reactive_entity_processor, skips_destroyed_entities) {
+	entt::registry r;
+
+	struct processed {};
+	size_t calls = 0;
+	kengine::reactive_entity_processor<processed, int> processor{ r, [&](entt::entity, int) { ++calls; } };
+
+	const auto e = r.create();
+	r.emplace<int>(e);
+	r.destroy(e);
+
+	processor.process();
+	EXPECT_EQ(calls, 0);
+}
+
+TEST(reactive_entity_processor, reprocesses_when_tag_removed) {
+	entt::registry r;
+
+	struct processed {};
+	size_t calls = 0;
+	kengine::reactive_entity_processor<processed, int> processor{ r, [&](entt::entity, int) { ++calls; } };
+
+	const auto e = r.create();
+	r.emplace<int>(e);
+	processor.process();
+	EXPECT_EQ(calls, 1);
+
+	r.remove<processed>(e);
+	processor.process();
+	EXPECT_EQ(calls, 2);
+}
+
+TEST(reactive_entity_processor, batch) {
+	entt::registry r;
+
+	struct processed {};
+	std::vector<entt::entity> processed_entities;
+	using processor_type = kengine::reactive_entity_processor<processed, int>;
+	processor_type processor{ r, processor_type::batch_callback{ [&](std::span<const entt::entity> entities) {
+		processed_entities.insert(processed_entities.end(), entities.begin(), entities.end());
+	} } };
+
+	std::vector<entt::entity> entities(10);
+	r.create(entities.begin(), entities.end());
+	r.insert<int>(entities.begin(), entities.end());
+
+	// Queued twice, but only passed once
+	r.remove<int>(entities[0]);
+	r.emplace<int>(entities[0]);
+
+	processor.process();
+	EXPECT_EQ(processed_entities.size(), entities.size());
+}
+
+// Benchmark comparing the cost of processing a few new entities in a large registry. Disabled by default, run it with --gtest_also_run_disabled_tests
+template<template<typename, typename...> typename Processor>
+static double get_microseconds_per_process(size_t existing_entity_count, size_t new_entity_count) noexcept {
+	entt::registry r;
+
+	struct processed {};
+	Processor<processed, int> processor{ r, [](entt::entity, int) {} };
+
+	std::vector<entt::entity> entities(existing_entity_count);
+	r.create(entities.begin(), entities.end());
+	r.insert<int>(entities.begin(), entities.end());
+	processor.process();
+
+	constexpr size_t iterations = 20;
+	std::chrono::steady_clock::duration elapsed{ 0 };
+	std::vector<entt::entity> new_entities(new_entity_count);
+	for (size_t i = 0; i < iterations; ++i) {
+		r.create(new_entities.begin(), new_entities.end());
+		r.insert<int>(new_entities.begin(), new_entities.end());
+
+		const auto start = std::chrono::steady_clock::now();
+		processor.process();
+		elapsed += std::chrono::steady_clock::now() - start;
+	}
+
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / 1000. / double(iterations);
+}
+
+TEST(reactive_entity_processor, DISABLED_benchmark_process) {
+	constexpr size_t existing_entity_count = 100'000;
+	constexpr size_t new_entity_count = 100;
+	testing::Test::RecordProperty("new_entity_processor", std::to_string(get_microseconds_per_process<kengine::new_entity_processor>(existing_entity_count, new_entity_count)));
+	testing::Test::RecordProperty("reactive_entity_processor", std::to_string(get_microseconds_per_process<kengine::reactive_entity_processor>(existing_entity_count, new_entity_count)));
+}
\ No newline at end of file
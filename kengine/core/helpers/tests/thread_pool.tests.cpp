@@ -0,0 +1,100 @@
+// stl
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/helpers/thread_pool.hpp"
+
+TEST(thread_pool, runs_all_tasks) {
+	std::atomic<size_t> calls = 0;
+	{
+		kengine::thread_pool pool{ 4 };
+		for (size_t i = 0; i < 1000; ++i)
+			pool.push([&] { ++calls; });
+	}
+	EXPECT_EQ(calls, 1000);
+}
+
+TEST(thread_pool, nested_push) {
+	std::atomic<size_t> calls = 0;
+	{
+		kengine::thread_pool pool{ 2 };
+		for (size_t i = 0; i < 100; ++i)
+			pool.push([&] {
+				++calls;
+				pool.push([&] { ++calls; });
+			});
+
+		while (calls < 200)
+			pool.run_pending_task();
+	}
+	EXPECT_EQ(calls, 200);
+}
+
+TEST(thread_pool, thread_count) {
+	const kengine::thread_pool pool{ 3 };
+	EXPECT_EQ(pool.get_thread_count(), 3);
+
+	const kengine::thread_pool empty_pool{ 0 };
+	EXPECT_EQ(empty_pool.get_thread_count(), 1);
+}
+
+TEST(thread_pool, priority_order) {
+	std::mutex mutex;
+	std::vector<kengine::thread_pool::priority> order;
+	std::atomic<bool> blocked = true;
+	std::atomic<size_t> calls = 0;
+	{
+		kengine::thread_pool pool{ 1 };
+
+		// Keep the only worker busy while we queue tasks
+		pool.push([&] {
+			while (blocked)
+				;
+		});
+
+		for (const auto task_priority : { kengine::thread_pool::priority::low, kengine::thread_pool::priority::normal, kengine::thread_pool::priority::high })
+			pool.push(
+				[&, task_priority] {
+					const std::lock_guard lock(mutex);
+					order.push_back(task_priority);
+					++calls;
+				},
+				task_priority
+			);
+
+		blocked = false;
+		while (calls < 3)
+			;
+	}
+
+	const std::vector expected{ kengine::thread_pool::priority::high, kengine::thread_pool::priority::normal, kengine::thread_pool::priority::low };
+	EXPECT_EQ(order, expected);
+}
+
+TEST(thread_pool, run_pending_task_min_priority) {
+	std::atomic<bool> blocked = true;
+	std::atomic<size_t> calls = 0;
+	{
+		kengine::thread_pool pool{ 1 };
+		pool.push([&] {
+			while (blocked)
+				;
+		});
+		// Wait for the worker to pick up the blocking task
+		while (pool.pending_tasks > 0)
+			;
+
+		pool.push([&] { ++calls; }, kengine::thread_pool::priority::low);
+		EXPECT_FALSE(pool.run_pending_task(kengine::thread_pool::priority::high));
+		EXPECT_EQ(calls, 0);
+		EXPECT_TRUE(pool.run_pending_task(kengine::thread_pool::priority::low));
+		EXPECT_EQ(calls, 1);
+
+		blocked = false;
+	}
+}
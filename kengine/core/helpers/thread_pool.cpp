@@ -0,0 +1,142 @@
+#include "thread_pool.hpp"
+
+// stl
+#include <algorithm>
+
+// putils
+#include "putils/string.hpp"
+#include "putils/thread_name.hpp"
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine {
+	// Lets tasks pushed from a worker go to that worker's own queue
+	static thread_local const thread_pool * current_pool = nullptr;
+	static thread_local size_t current_worker_index = 0;
+
+	thread_pool::thread_pool(size_t thread_count) noexcept {
+		thread_count = std::max<size_t>(thread_count, 1);
+
+		queues.reserve(thread_count);
+		for (size_t i = 0; i < thread_count; ++i)
+			queues.push_back(std::make_unique<worker_queue>());
+
+		threads.reserve(thread_count);
+		for (size_t i = 0; i < thread_count; ++i)
+			threads.emplace_back([this, i] { worker_loop(i); });
+	}
+
+	thread_pool::~thread_pool() noexcept {
+		{
+			const std::lock_guard lock(sleep_mutex);
+			stopping = true;
+		}
+		sleep_condition.notify_all();
+
+		for (auto & thread : threads)
+			thread.join();
+	}
+
+	void thread_pool::push(task && t, priority task_priority) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto queue_index = current_pool == this ? current_worker_index : next_queue++ % queues.size();
+
+		{
+			// Incremented before the task is visible, so that `pop_task` and `steal_task` never make it underflow
+			const std::lock_guard lock(sleep_mutex);
+			++pending_tasks;
+		}
+
+		auto & queue = *queues[queue_index];
+		{
+			const std::lock_guard lock(queue.mutex);
+			queue.tasks[size_t(task_priority)].push_back(std::move(t));
+		}
+		sleep_condition.notify_one();
+	}
+
+	bool thread_pool::run_pending_task(priority min_priority) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		task t;
+		for (auto task_priority = size_t(priority::high) + 1; task_priority-- > size_t(min_priority);)
+			if (steal_task(queues.size(), priority(task_priority), t)) {
+				t();
+				return true;
+			}
+		return false;
+	}
+
+	size_t thread_pool::get_thread_count() const noexcept {
+		return threads.size();
+	}
+
+	bool thread_pool::pop_task(size_t queue_index, priority task_priority, task & out) noexcept {
+		auto & queue = *queues[queue_index];
+		const std::lock_guard lock(queue.mutex);
+		auto & tasks = queue.tasks[size_t(task_priority)];
+		if (tasks.empty())
+			return false;
+
+		// Owners pop from the back, as recently pushed tasks are more likely to be hot in cache
+		out = std::move(tasks.back());
+		tasks.pop_back();
+		--pending_tasks;
+		return true;
+	}
+
+	bool thread_pool::steal_task(size_t thief_index, priority task_priority, task & out) noexcept {
+		const auto queue_count = queues.size();
+		for (size_t offset = 1; offset <= queue_count; ++offset) {
+			const auto victim_index = (thief_index + offset) % queue_count;
+			if (victim_index == thief_index)
+				continue;
+
+			auto & queue = *queues[victim_index];
+			const std::lock_guard lock(queue.mutex);
+			auto & tasks = queue.tasks[size_t(task_priority)];
+			if (tasks.empty())
+				continue;
+
+			// Thieves steal from the front, away from the owner
+			out = std::move(tasks.front());
+			tasks.pop_front();
+			--pending_tasks;
+			return true;
+		}
+		return false;
+	}
+
+	void thread_pool::worker_loop(size_t index) noexcept {
+		const putils::scoped_thread_name thread_name(putils::string<64>("Worker {}", index));
+
+		current_pool = this;
+		current_worker_index = index;
+
+		while (true) {
+			// Highest priority first, whether the task is in our own queue or another worker's
+			task t;
+			bool found = false;
+			for (auto task_priority = size_t(priority::high) + 1; !found && task_priority-- > 0;)
+				found = pop_task(index, priority(task_priority), t) || steal_task(index, priority(task_priority), t);
+
+			if (found) {
+				t();
+				continue;
+			}
+
+			std::unique_lock lock(sleep_mutex);
+			sleep_condition.wait(lock, [this] { return stopping || pending_tasks > 0; });
+			if (stopping && pending_tasks == 0)
+				return;
+		}
+	}
+
+	thread_pool & get_thread_pool() noexcept {
+		// The main thread helps run main loop systems, so it doesn't need a worker of its own
+		static thread_pool pool{ std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1 };
+		return pool;
+	}
+}
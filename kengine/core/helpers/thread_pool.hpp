@@ -0,0 +1,54 @@
+#pragma once
+
+// stl
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kengine {
+	struct KENGINE_CORE_EXPORT thread_pool {
+		using task = std::function<void()>;
+
+		enum class priority {
+			low,
+			normal,
+			high,
+		};
+
+		thread_pool(size_t thread_count = std::thread::hardware_concurrency()) noexcept;
+		~thread_pool() noexcept;
+
+		thread_pool(const thread_pool &) = delete;
+		thread_pool & operator=(const thread_pool &) = delete;
+
+		void push(task && t, priority task_priority = priority::normal) noexcept;
+		bool run_pending_task(priority min_priority = priority::low) noexcept;
+		size_t get_thread_count() const noexcept;
+
+		struct worker_queue {
+			std::mutex mutex;
+			std::deque<task> tasks[3]; // One per priority
+		};
+
+		bool pop_task(size_t queue_index, priority task_priority, task & out) noexcept;
+		bool steal_task(size_t thief_index, priority task_priority, task & out) noexcept;
+		void worker_loop(size_t index) noexcept;
+
+		std::vector<std::unique_ptr<worker_queue>> queues;
+		std::vector<std::thread> threads;
+
+		std::atomic<size_t> next_queue = 0;
+		std::atomic<size_t> pending_tasks = 0;
+
+		std::mutex sleep_mutex;
+		std::condition_variable sleep_condition;
+		bool stopping = false;
+	};
+
+	KENGINE_CORE_EXPORT thread_pool & get_thread_pool() noexcept;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace kengine::core::log::async_file {
+	enum class overflow_policy {
+		drop, // Messages logged while the queue is full are discarded
+		block, // Threads logging while the queue is full wait for the writer thread to catch up
+	};
+
+	//! putils reflect all
+	//! class_name: core_log_async_file_config
+	//! metadata: [("config", true)]
+	struct config {
+		overflow_policy on_overflow = overflow_policy::drop;
+		float flush_interval = 1.f;
+		unsigned int dropped_messages = 0;
+	};
+}
+
+#include "config.rpp"
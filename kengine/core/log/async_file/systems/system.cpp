@@ -0,0 +1,291 @@
+#include "system.hpp"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// magic_enum
+#include <magic_enum.hpp>
+
+// putils
+#include "putils/forward_to.hpp"
+#include "putils/thread_name.hpp"
+
+// kengine
+#include "kengine/command_line/helpers/parse.hpp"
+#include "kengine/config/data/configurable.hpp"
+#include "kengine/core/assert/helpers/kengine_assert.hpp"
+#include "kengine/core/data/name.hpp"
+#include "kengine/core/log/data/severity_control.hpp"
+#include "kengine/core/log/functions/on_log.hpp"
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/log/helpers/parse_command_line_severity.hpp"
+#include "kengine/core/log/helpers/severity_cache.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/main_loop/functions/execute.hpp"
+
+#include "config.hpp"
+
+#ifndef KENGINE_LOG_ASYNC_FILE_LOCATION
+#define KENGINE_LOG_ASYNC_FILE_LOCATION "kengine.log"
+#endif
+
+#ifndef KENGINE_LOG_ASYNC_FILE_QUEUE_SIZE
+#define KENGINE_LOG_ASYNC_FILE_QUEUE_SIZE 1024
+#endif
+
+#ifndef KENGINE_LOG_ASYNC_FILE_MAX_MESSAGE_LENGTH
+#define KENGINE_LOG_ASYNC_FILE_MAX_MESSAGE_LENGTH 1024
+#endif
+
+#ifndef KENGINE_LOG_ASYNC_FILE_MAX_CATEGORY_LENGTH
+#define KENGINE_LOG_ASYNC_FILE_MAX_CATEGORY_LENGTH 64
+#endif
+
+#ifndef KENGINE_LOG_ASYNC_FILE_MAX_THREAD_NAME_LENGTH
+#define KENGINE_LOG_ASYNC_FILE_MAX_THREAD_NAME_LENGTH 64
+#endif
+
+namespace kengine::core::log::async_file {
+	static constexpr auto log_category = "core_log_async_file";
+
+	// Truncating copy into a fixed-size buffer, so that logging never allocates
+	template<size_t Size>
+	static void copy_string(std::array<char, Size> & destination, const char * source, size_t length) noexcept {
+		length = std::min(length, Size - 1);
+		std::copy_n(source, length, destination.data());
+		destination[length] = '\0';
+	}
+
+	template<size_t Size>
+	static void copy_string(std::array<char, Size> & destination, const char * source) noexcept {
+		copy_string(destination, source, std::char_traits<char>::length(source));
+	}
+
+	// Bounded multi-producer single-consumer queue, based on Dmitry Vyukov's bounded MPMC queue
+	struct message_queue {
+		static constexpr size_t capacity = KENGINE_LOG_ASYNC_FILE_QUEUE_SIZE;
+		static_assert((capacity & (capacity - 1)) == 0, "KENGINE_LOG_ASYNC_FILE_QUEUE_SIZE must be a power of 2");
+
+		struct message {
+			severity message_severity;
+			std::array<char, KENGINE_LOG_ASYNC_FILE_MAX_CATEGORY_LENGTH> category;
+			std::array<char, KENGINE_LOG_ASYNC_FILE_MAX_MESSAGE_LENGTH> text;
+			std::array<char, KENGINE_LOG_ASYNC_FILE_MAX_THREAD_NAME_LENGTH> thread_name;
+		};
+
+		struct slot {
+			std::atomic<size_t> sequence;
+			message msg;
+		};
+
+		std::unique_ptr<slot[]> slots = std::make_unique<slot[]>(capacity);
+		alignas(64) std::atomic<size_t> push_position = 0;
+		alignas(64) size_t pop_position = 0;
+
+		message_queue() noexcept {
+			for (size_t i = 0; i < capacity; ++i)
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		bool try_push(const event & log_event) noexcept {
+			auto position = push_position.load(std::memory_order_relaxed);
+			slot * target = nullptr;
+			while (true) {
+				target = &slots[position & (capacity - 1)];
+				const auto sequence = target->sequence.load(std::memory_order_acquire);
+				const auto diff = intptr_t(sequence) - intptr_t(position);
+				if (diff == 0) {
+					if (push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+					return false; // Full
+				else
+					position = push_position.load(std::memory_order_relaxed);
+			}
+
+			auto & msg = target->msg;
+			msg.message_severity = log_event.message_severity;
+			copy_string(msg.category, log_event.category);
+			copy_string(msg.text, log_event.message);
+			const auto & thread_name = putils::get_thread_name();
+			copy_string(msg.thread_name, thread_name.c_str(), thread_name.size());
+
+			target->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Only called by the writer thread
+		template<std::invocable<const message &> Func>
+		bool try_pop(Func && func) noexcept {
+			auto & target = slots[pop_position & (capacity - 1)];
+			if (target.sequence.load(std::memory_order_acquire) != pop_position + 1)
+				return false; // Empty, or next message still being written
+
+			func(target.msg);
+			target.sequence.store(pop_position + capacity, std::memory_order_release);
+			++pop_position;
+			return true;
+		}
+	};
+
+	struct system {
+		entt::registry & r;
+		config * cfg = nullptr;
+
+		std::ofstream file;
+		message_queue queue;
+
+		// Copies of the config, as it can't be read from logging threads
+		std::atomic<overflow_policy> on_overflow = overflow_policy::drop;
+		std::atomic<float> flush_interval = 1.f;
+		std::atomic<unsigned int> dropped_messages = 0;
+
+		std::mutex writer_mutex;
+		std::condition_variable writer_condition;
+		bool stopping = false;
+		std::thread writer;
+
+		system(entt::handle e) noexcept
+			: r(*e.registry()) {
+			KENGINE_PROFILING_SCOPE;
+
+			kengine_log(r, log, log_category, "Initializing");
+
+			const auto args = kengine::command_line::parse<options>(r);
+			const char * file_name = args.async_log_file ? args.async_log_file->c_str() : KENGINE_LOG_ASYNC_FILE_LOCATION;
+
+			file.open(file_name);
+			if (!file) {
+				kengine_assert_failed(r, "async_log_file system couldn't open output file '{}'", file_name);
+				return;
+			}
+
+			writer = std::thread([this] { write_loop(); });
+
+			enable_severity_cache(r);
+			e.emplace<on_log>(putils_forward_to_this(log));
+
+			e.emplace<core::name>("Log/Async file");
+			e.emplace<kengine::config::configurable>();
+			cfg = &e.emplace<config>();
+			e.emplace<severity_control>(parse_command_line_severity(r));
+			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+		}
+
+		~system() noexcept {
+			if (!writer.joinable())
+				return;
+
+			{
+				const std::lock_guard lock(writer_mutex);
+				stopping = true;
+			}
+			writer_condition.notify_one();
+			writer.join();
+		}
+
+		void log(const event & log_event) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			while (!queue.try_push(log_event)) {
+				if (on_overflow.load(std::memory_order_relaxed) == overflow_policy::drop) {
+					dropped_messages.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				writer_condition.notify_one();
+				std::this_thread::yield();
+			}
+
+			if (log_event.message_severity >= severity::error)
+				writer_condition.notify_one();
+		}
+
+		void execute(float delta_time) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Executing");
+
+			on_overflow = cfg->on_overflow;
+			flush_interval = cfg->flush_interval;
+			cfg->dropped_messages = dropped_messages.load(std::memory_order_relaxed);
+		}
+
+		void write_loop() noexcept {
+			const putils::scoped_thread_name thread_name("Async log writer");
+
+			auto last_flush = std::chrono::steady_clock::now();
+			while (true) {
+				bool should_flush = false;
+
+				// Drain everything available in a single batch
+				while (queue.try_pop([&](const message_queue::message & msg) noexcept {
+					write(msg);
+					// Make sure errors reach the disk, in case they're followed by a crash
+					if (msg.message_severity >= severity::error)
+						should_flush = true;
+				}))
+					;
+
+				const auto now = std::chrono::steady_clock::now();
+				const auto time_since_flush = std::chrono::duration<float>(now - last_flush).count();
+				if (should_flush || time_since_flush >= flush_interval.load(std::memory_order_relaxed)) {
+					file.flush();
+					last_flush = now;
+				}
+
+				std::unique_lock lock(writer_mutex);
+				if (stopping)
+					break;
+
+				// Producers don't notify for every message, so poll regularly
+				using namespace std::chrono_literals;
+				writer_condition.wait_for(lock, 10ms);
+			}
+
+			// Write any message pushed before we were stopped
+			while (queue.try_pop([this](const message_queue::message & msg) noexcept { write(msg); }))
+				;
+			file.flush();
+		}
+
+		void write(const message_queue::message & msg) noexcept {
+			if (msg.thread_name[0] != '\0')
+				file << '{' << msg.thread_name.data() << "}\t";
+
+			file << magic_enum::enum_name<severity>(msg.message_severity) << "\t[" << msg.category.data() << "]\t"
+				 << msg.text.data() << '\n';
+		}
+
+		// Command-line arguments
+		struct options {
+			std::optional<std::string> async_log_file;
+		};
+	};
+
+	DEFINE_KENGINE_SYSTEM_CREATOR(system)
+}
+
+#define refltype kengine::core::log::async_file::system::options
+putils_reflection_info {
+	putils_reflection_custom_class_name(async log file);
+	putils_reflection_attributes(
+		putils_reflection_attribute(async_log_file)
+	)
+};
+#undef refltype
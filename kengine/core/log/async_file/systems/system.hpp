@@ -0,0 +1,8 @@
+#pragma once
+
+// kengine
+#include "kengine/system_creator/helpers/system_creator_helper.hpp"
+
+namespace kengine::core::log::async_file {
+	DECLARE_KENGINE_SYSTEM_CREATOR(KENGINE_CORE_LOG_ASYNC_FILE_EXPORT, system)
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 // stl
+#include <string>
 #include <unordered_map>
 
 // kengine
@@ -24,6 +24,7 @@
 #include "kengine/core/log/functions/on_log.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/log/helpers/parse_command_line_severity.hpp"
+#include "kengine/core/log/helpers/severity_cache.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 
 #ifndef KENGINE_LOG_FILE_LOCATION
@@ -40,6 +41,7 @@ namespace kengine::core::log::file {
 		system(entt::handle e) noexcept {
 			KENGINE_PROFILING_SCOPE;
 
+			enable_severity_cache(*e.registry());
 			e.emplace<on_log>(putils_forward_to_this(log));
 
 			kengine_log(*e.registry(), log, log_category, "Initializing");
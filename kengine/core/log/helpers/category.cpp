@@ -0,0 +1,39 @@
+#include "category.hpp"
+
+// stl
+#include <mutex>
+#include <shared_mutex>
+
+// kengine
+#include "kengine/core/helpers/string_hash.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::core::log {
+	namespace {
+		struct category_registry {
+			std::shared_mutex mutex;
+			string_map<category_id> ids;
+		};
+
+		// Leaked, so that messages can still be logged from static destructors
+		category_registry & get_category_registry() noexcept {
+			static auto * const ret = new category_registry;
+			return *ret;
+		}
+	}
+
+	category_id intern_category(std::string_view name) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		auto & registry = get_category_registry();
+		{
+			const std::shared_lock lock(registry.mutex);
+			if (const auto it = registry.ids.find(name); it != registry.ids.end())
+				return it->second;
+		}
+
+		const std::lock_guard lock(registry.mutex);
+		const auto [it, inserted] = registry.ids.try_emplace(std::string(name), category_id(registry.ids.size()));
+		return it->second;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+// stl
+#include <string_view>
+
+namespace kengine::core::log {
+	// Small integer identifying a log category, so that sinks can filter messages without comparing strings
+	using category_id = unsigned int;
+
+	KENGINE_CORE_LOG_EXPORT category_id intern_category(std::string_view name) noexcept;
+
+	// Per-call-site cache used by kengine_log, so that categories are only interned when the category pointer changes
+	struct category_cache {
+		const char * name = nullptr;
+		category_id id = 0;
+
+		category_id get(const char * category) noexcept {
+			if (category != name) {
+				id = intern_category(category);
+				name = category;
+			}
+			return id;
+		}
+	};
+}
\ No newline at end of file
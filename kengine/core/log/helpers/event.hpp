@@ -1,6 +1,7 @@
 #pragma once
 
 // kengine
+#include "kengine/core/log/helpers/category.hpp"
 #include "kengine/core/log/helpers/severity.hpp"
 
 namespace kengine::core::log {
@@ -8,6 +9,7 @@ namespace kengine::core::log {
 	struct event {
 		severity message_severity;
 		const char * category;
+		category_id category_index = 0;
 		const char * message;
 	};
 }
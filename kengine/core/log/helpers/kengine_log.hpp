@@ -6,7 +6,9 @@
 
 // kengine
 #include "kengine/core/helpers/entt_formatter.hpp"
+#include "kengine/core/log/helpers/category.hpp"
 #include "kengine/core/log/helpers/log.hpp"
+#include "kengine/core/log/helpers/severity_cache.hpp"
 
 #ifndef KENGINE_LOG_MAX_SEVERITY
 #define KENGINE_LOG_MAX_SEVERITY all
@@ -19,7 +21,11 @@
 #define kengine_log(registry, verbosity, category, message) \
 	do { \
 		if constexpr (kengine::core::log::severity::verbosity >= kengine::core::log::severity::KENGINE_LOG_MAX_SEVERITY) \
-			kengine::core::log::log(registry, kengine::core::log::severity::verbosity, category, message); \
+			if (kengine::core::log::passes_severity_cache(registry, kengine::core::log::severity::verbosity)) { \
+				const char * const kengine_log_category = category; \
+				static thread_local kengine::core::log::category_cache kengine_log_category_cache; \
+				kengine::core::log::log(registry, kengine::core::log::severity::verbosity, kengine_log_category_cache.get(kengine_log_category), kengine_log_category, message); \
+			} \
 	} while (false)
 #define kengine_logf(registry, severity, category, format, ...) kengine_log(registry, severity, category, putils::string<1024>(format, __VA_ARGS__).c_str())
 #endif
@@ -5,20 +5,31 @@
 
 // kengine
 #include "kengine/core/log/data/severity_control.hpp"
+#include "kengine/core/log/helpers/severity_table.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 
 namespace kengine::core::log {
 	void log(const entt::registry & r, severity message_severity, const char * category, const char * message) noexcept {
+		log(r, message_severity, intern_category(category), category, message);
+	}
+
+	void log(const entt::registry & r, severity message_severity, category_id category_index, const char * category, const char * message) noexcept {
 		KENGINE_PROFILING_SCOPE;
 
 		const event log_event{
 			.message_severity = message_severity,
 			.category = category,
+			.category_index = category_index,
 			.message = message
 		};
 
 		for (const auto & [e, log] : r.view<on_log>().each()) {
-			if (const auto control = r.try_get<severity_control>(e))
+			// severity_tables are only maintained once the severity_cache is enabled, fall back to the severity_control otherwise
+			if (const auto table = r.try_get<severity_table>(e)) {
+				if (!table->passes(log_event))
+					continue;
+			}
+			else if (const auto control = r.try_get<severity_control>(e))
 				if (!control->passes(log_event))
 					continue;
 			log(log_event);
@@ -5,7 +5,9 @@
 
 // kengine
 #include "kengine/core/log/functions/on_log.hpp"
+#include "kengine/core/log/helpers/category.hpp"
 
 namespace kengine::core::log {
 	KENGINE_CORE_LOG_EXPORT void log(const entt::registry & r, severity message_severity, const char * category, const char * message) noexcept;
+	KENGINE_CORE_LOG_EXPORT void log(const entt::registry & r, severity message_severity, category_id category_index, const char * category, const char * message) noexcept;
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "severity_cache.hpp"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+// kengine
+#include "kengine/core/log/data/severity_control.hpp"
+#include "kengine/core/log/functions/on_log.hpp"
+#include "kengine/core/log/helpers/severity_table.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::core::log {
+	// Caches are looked up from here rather than from the registry's context, as logging may happen from any thread while the context is being modified
+	struct severity_cache_slot {
+		std::atomic<const entt::registry *> registry = nullptr;
+		std::atomic<const severity_cache *> cache = nullptr;
+	};
+
+	// entt only stores movable context variables in place, so the cache's address is stable
+	static_assert(!std::is_move_constructible_v<severity_cache>);
+
+	static constexpr size_t max_severity_cache_slots = 16;
+	static std::array<severity_cache_slot, max_severity_cache_slots> severity_cache_slots;
+
+	static void register_severity_cache(const entt::registry & r, const severity_cache & cache) noexcept {
+		for (auto & slot : severity_cache_slots) {
+			const entt::registry * expected = nullptr;
+			if (slot.registry.compare_exchange_strong(expected, &r)) {
+				slot.cache = &cache;
+				return;
+			}
+		}
+		// No slot left: messages for r simply won't be filtered early
+	}
+
+	severity_cache::~severity_cache() noexcept {
+		for (auto & slot : severity_cache_slots)
+			if (slot.cache == this) {
+				slot.cache = nullptr;
+				slot.registry = nullptr;
+			}
+	}
+
+	bool passes_severity_cache(const entt::registry & r, severity message_severity) noexcept {
+		for (const auto & slot : severity_cache_slots)
+			if (slot.registry == &r) {
+				const auto cache = slot.cache.load();
+				return !cache || message_severity >= cache->min_severity.load(std::memory_order_relaxed);
+			}
+		return true;
+	}
+
+	static severity get_min_severity(const severity_control & control) noexcept {
+		auto ret = control.global_severity;
+		for (const auto & [category, category_severity] : control.category_severities)
+			ret = std::min(ret, category_severity);
+		return ret;
+	}
+
+	// `ignored_sink` and `ignored_control` are about to be destroyed, but are still in the registry when the signal is emitted
+	static void update_severity_cache(entt::registry & r, entt::entity ignored_sink, entt::entity ignored_control) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		auto min_severity = severity::none;
+		for (const auto & [e, log] : r.view<on_log>().each()) {
+			if (e == ignored_sink)
+				continue;
+
+			const auto control = e == ignored_control ? nullptr : r.try_get<severity_control>(e);
+			if (!control) {
+				// Sinks without a severity_control receive every message
+				min_severity = severity::all;
+				break;
+			}
+
+			min_severity = std::min(min_severity, get_min_severity(*control));
+		}
+
+		r.ctx().get<severity_cache>().min_severity = min_severity;
+	}
+
+	static void on_sink_changed(entt::registry & r, entt::entity) noexcept {
+		update_severity_cache(r, entt::null, entt::null);
+	}
+
+	static void on_control_changed(entt::registry & r, entt::entity e) noexcept {
+		r.emplace_or_replace<severity_table>(e, make_severity_table(r.get<severity_control>(e)));
+		update_severity_cache(r, entt::null, entt::null);
+	}
+
+	static void on_sink_destroyed(entt::registry & r, entt::entity e) noexcept {
+		update_severity_cache(r, e, entt::null);
+	}
+
+	static void on_control_destroyed(entt::registry & r, entt::entity e) noexcept {
+		r.remove<severity_table>(e);
+		update_severity_cache(r, entt::null, e);
+	}
+
+	void enable_severity_cache(entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (r.ctx().contains<severity_cache>())
+			return;
+
+		register_severity_cache(r, r.ctx().emplace<severity_cache>());
+
+		r.on_construct<on_log>().connect<&on_sink_changed>();
+		r.on_destroy<on_log>().connect<&on_sink_destroyed>();
+
+		r.on_construct<severity_control>().connect<&on_control_changed>();
+		r.on_update<severity_control>().connect<&on_control_changed>();
+		r.on_destroy<severity_control>().connect<&on_control_destroyed>();
+
+		for (const auto & [e, control] : r.view<severity_control>().each())
+			r.emplace_or_replace<severity_table>(e, make_severity_table(control));
+		update_severity_cache(r, entt::null, entt::null);
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+// stl
+#include <atomic>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/log/helpers/severity.hpp"
+
+namespace kengine::core::log {
+	struct KENGINE_CORE_LOG_EXPORT severity_cache {
+		std::atomic<severity> min_severity = severity::all;
+
+		severity_cache() noexcept = default;
+		~severity_cache() noexcept;
+	};
+
+	KENGINE_CORE_LOG_EXPORT void enable_severity_cache(entt::registry & r) noexcept;
+	KENGINE_CORE_LOG_EXPORT bool passes_severity_cache(const entt::registry & r, severity message_severity) noexcept;
+}
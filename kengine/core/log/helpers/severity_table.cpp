@@ -0,0 +1,25 @@
+#include "severity_table.hpp"
+
+// stl
+#include <algorithm>
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::core::log {
+	severity_table make_severity_table(const severity_control & control) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		severity_table ret{ .global_severity = control.global_severity };
+
+		// Categories interned after this can't have an override, so they'll be past the end of the table and use global_severity
+		for (const auto & [category, category_severity] : control.category_severities) {
+			const auto id = intern_category(category);
+			if (id >= ret.category_severities.size())
+				ret.category_severities.resize(id + 1, control.global_severity);
+			ret.category_severities[id] = category_severity;
+		}
+
+		return ret;
+	}
+}
\ No newline at end of file
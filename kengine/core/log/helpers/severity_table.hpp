@@ -0,0 +1,26 @@
+#pragma once
+
+// stl
+#include <vector>
+
+// kengine
+#include "kengine/core/log/data/severity_control.hpp"
+#include "kengine/core/log/helpers/category.hpp"
+#include "kengine/core/log/helpers/event.hpp"
+#include "kengine/core/log/helpers/severity.hpp"
+
+namespace kengine::core::log {
+	// Flat copy of a severity_control, indexed by category_id
+	struct severity_table {
+		severity global_severity = severity::log;
+		std::vector<severity> category_severities;
+
+		bool passes(const event & event) const noexcept {
+			if (event.category_index < category_severities.size())
+				return event.message_severity >= category_severities[event.category_index];
+			return event.message_severity >= global_severity;
+		}
+	};
+
+	KENGINE_CORE_LOG_EXPORT severity_table make_severity_table(const severity_control & control) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+// stl
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/log/helpers/category.hpp"
+
+TEST(log, intern_category) {
+	const auto first = kengine::core::log::intern_category("intern_category_first");
+	const auto second = kengine::core::log::intern_category("intern_category_second");
+	EXPECT_NE(first, second);
+
+	// Same content from a different buffer
+	const std::string first_copy = "intern_category_first";
+	EXPECT_EQ(kengine::core::log::intern_category(first_copy), first);
+	EXPECT_EQ(kengine::core::log::intern_category("intern_category_second"), second);
+}
\ No newline at end of file
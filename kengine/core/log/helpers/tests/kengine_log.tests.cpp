@@ -1,3 +1,8 @@
+// stl
+#include <chrono>
+#include <string>
+#include <vector>
+
 // entt
 #include <entt/entity/registry.hpp>
 
@@ -5,7 +10,10 @@
 #include <gtest/gtest.h>
 
 // kengine
+#include "kengine/core/log/data/severity_control.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/log/helpers/severity_cache.hpp"
+#include "kengine/core/log/helpers/severity_table.hpp"
 
 TEST(log, kengine_log) {
 	entt::registry r;
@@ -41,3 +49,144 @@ TEST(log, kengine_log) {
 	EXPECT_EQ(output[1].category, "OtherCategory");
 	EXPECT_EQ(output[1].message, "OtherMessage");
 }
+
+TEST(log, kengine_log_runtime_category) {
+	entt::registry r;
+
+	std::vector<kengine::core::log::category_id> output;
+	const auto e = r.create();
+	r.emplace<kengine::core::log::on_log>(e, [&](const kengine::core::log::event & event) { output.push_back(event.category_index); });
+
+	// A single call site, reached with different categories
+	const auto forward = [&](const char * category) {
+		kengine_log(r, log, category, "Message");
+	};
+
+	forward("Category");
+	forward("OtherCategory");
+	forward("Category");
+
+	ASSERT_EQ(output.size(), 3);
+	EXPECT_EQ(output[0], kengine::core::log::intern_category("Category"));
+	EXPECT_EQ(output[1], kengine::core::log::intern_category("OtherCategory"));
+	EXPECT_EQ(output[2], kengine::core::log::intern_category("Category"));
+}
+
+TEST(log, severity_cache_skips_formatting) {
+	entt::registry r;
+	kengine::core::log::enable_severity_cache(r);
+
+	size_t messages = 0;
+	const auto e = r.create();
+	r.emplace<kengine::core::log::on_log>(e, [&](const kengine::core::log::event &) { ++messages; });
+	r.emplace<kengine::core::log::severity_control>(e, kengine::core::log::severity_control{ .global_severity = kengine::core::log::severity::warning });
+
+	size_t formats = 0;
+	const auto format_argument = [&] {
+		++formats;
+		return 42;
+	};
+
+	kengine_logf(r, verbose, "Category", "{}", format_argument());
+	EXPECT_EQ(formats, 0);
+	EXPECT_EQ(messages, 0);
+
+	kengine_logf(r, warning, "Category", "{}", format_argument());
+	EXPECT_EQ(formats, 1);
+	EXPECT_EQ(messages, 1);
+}
+
+TEST(log, severity_cache_updates) {
+	entt::registry r;
+	kengine::core::log::enable_severity_cache(r);
+	EXPECT_TRUE(kengine::core::log::passes_severity_cache(r, kengine::core::log::severity::very_verbose));
+
+	const auto e = r.create();
+	r.emplace<kengine::core::log::on_log>(e, [](const kengine::core::log::event &) {});
+	EXPECT_TRUE(kengine::core::log::passes_severity_cache(r, kengine::core::log::severity::very_verbose));
+
+	r.emplace<kengine::core::log::severity_control>(e, kengine::core::log::severity_control{ .global_severity = kengine::core::log::severity::warning });
+	EXPECT_FALSE(kengine::core::log::passes_severity_cache(r, kengine::core::log::severity::log));
+	EXPECT_TRUE(kengine::core::log::passes_severity_cache(r, kengine::core::log::severity::error));
+
+	r.patch<kengine::core::log::severity_control>(e, [](auto & control) {
+		control.category_severities["Category"] = kengine::core::log::severity::verbose;
+	});
+	EXPECT_TRUE(kengine::core::log::passes_severity_cache(r, kengine::core::log::severity::verbose));
+	EXPECT_FALSE(kengine::core::log::passes_severity_cache(r, kengine::core::log::severity::very_verbose));
+
+	r.erase<kengine::core::log::on_log>(e);
+	EXPECT_FALSE(kengine::core::log::passes_severity_cache(r, kengine::core::log::severity::error));
+}
+
+TEST(log, severity_table_category_overrides) {
+	entt::registry r;
+	kengine::core::log::enable_severity_cache(r);
+
+	std::vector<std::string> output;
+	const auto e = r.create();
+	r.emplace<kengine::core::log::on_log>(e, [&](const kengine::core::log::event & event) { output.push_back(event.message); });
+	r.emplace<kengine::core::log::severity_control>(e, kengine::core::log::severity_control{ .global_severity = kengine::core::log::severity::warning });
+
+	const auto log_all = [&] {
+		output.clear();
+		kengine_log(r, verbose, "Category", "Overridden");
+		kengine_log(r, verbose, "OtherCategory", "Global");
+	};
+
+	log_all();
+	EXPECT_TRUE(output.empty());
+
+	r.patch<kengine::core::log::severity_control>(e, [](auto & control) {
+		control.category_severities["Category"] = kengine::core::log::severity::verbose;
+	});
+	log_all();
+	ASSERT_EQ(output.size(), 1);
+	EXPECT_EQ(output[0], "Overridden");
+
+	// Replacing the control (as when it's reloaded from config) also refreshes the table
+	r.replace<kengine::core::log::severity_control>(e, kengine::core::log::severity_control{ .global_severity = kengine::core::log::severity::verbose });
+	log_all();
+	EXPECT_EQ(output.size(), 2);
+}
+
+// Microbenchmark for the per-entity cost of filtered-out logs in a loop like physics_kinematic's. Disabled by default, run it with --gtest_also_run_disabled_tests
+template<typename Func>
+static double get_nanoseconds_per_entity(size_t entity_count, Func && func) noexcept {
+	constexpr size_t iterations = 20;
+
+	// Warm up caches first
+	func();
+
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; ++i)
+		func();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / double(iterations * entity_count);
+}
+
+TEST(log, DISABLED_benchmark_filtered_log) {
+	constexpr size_t entity_count = 10'000;
+
+	const auto get_kinematic_loop_cost = [](bool severity_cache) {
+		entt::registry r;
+		if (severity_cache)
+			kengine::core::log::enable_severity_cache(r);
+
+		// A sink which only accepts warnings, as in a release build
+		const auto sink = r.create();
+		r.emplace<kengine::core::log::on_log>(sink, [](const kengine::core::log::event &) {});
+		r.emplace<kengine::core::log::severity_control>(sink, kengine::core::log::severity_control{ .global_severity = kengine::core::log::severity::warning });
+
+		std::vector<float> positions(entity_count);
+		return get_nanoseconds_per_entity(entity_count, [&] {
+			for (size_t i = 0; i < positions.size(); ++i) {
+				kengine_logf(r, very_verbose, "physics_kinematic", "Moving {}", i);
+				positions[i] += .01f;
+			}
+		});
+	};
+
+	testing::Test::RecordProperty("filtered_log_without_cache", std::to_string(get_kinematic_loop_cost(false)));
+	testing::Test::RecordProperty("filtered_log_with_cache", std::to_string(get_kinematic_loop_cost(true)));
+}
@@ -26,10 +26,11 @@
 #include "kengine/core/log/functions/on_log.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/log/helpers/parse_command_line_severity.hpp"
+#include "kengine/core/log/helpers/severity_cache.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 
 #include "config.hpp"
 
@@ -37,7 +38,7 @@ namespace kengine::core::log::imgui {
 	static constexpr auto log_category = "core_log_imgui";
 
 	struct system {
-		const entt::registry & r;
+		entt::registry & r;
 		const config * cfg = nullptr;
 		bool * enabled;
 
@@ -59,13 +60,16 @@ namespace kengine::core::log::imgui {
 			char thread_search[4096] = "";
 		} filters;
 		severity_control * control = nullptr;
+		entt::entity control_entity = entt::null;
 
 		system(entt::handle e) noexcept
-			: r(*e.registry()) {
+			: r(*e.registry()),
+			  control_entity(e) {
 			KENGINE_PROFILING_SCOPE;
 
 			kengine_log(r, log, log_category, "Initializing");
 
+			enable_severity_cache(r);
 			e.emplace<on_log>(putils_forward_to_this(log));
 
 			// Config
@@ -84,7 +88,7 @@ namespace kengine::core::log::imgui {
 			auto & tool = e.registry()->emplace<kengine::imgui::tool::tool>(imgui_tool_entity);
 			enabled = &tool.enabled;
 			e.registry()->emplace<core::name>(imgui_tool_entity, "Log");
-			e.registry()->emplace<main_loop::execute>(imgui_tool_entity, putils_forward_to_this(execute));
+			e.registry()->emplace<main_loop::execute_frame>(imgui_tool_entity, putils_forward_to_this(execute));
 		}
 
 		void log(const event & log_event) noexcept {
@@ -106,7 +110,7 @@ namespace kengine::core::log::imgui {
 			}
 		}
 
-		void execute(float) noexcept {
+		void execute(float, float) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
@@ -140,12 +144,14 @@ namespace kengine::core::log::imgui {
 							control->global_severity = severity(i);
 							break;
 						}
+					r.patch<severity_control>(control_entity);
 				}
 
 			if (putils::reflection::imgui_edit("Categories", filters.category_severities)) {
 				control->category_severities.clear();
 				for (const auto & [category, severity] : filters.category_severities)
 					control->category_severities.emplace(category, severity);
+				r.patch<severity_control>(control_entity);
 			}
 
 			if (ImGui::InputText("Category", filters.category_search, putils::lengthof(filters.category_search))) {
@@ -25,6 +25,7 @@
 #include "kengine/core/log/functions/on_log.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/log/helpers/parse_command_line_severity.hpp"
+#include "kengine/core/log/helpers/severity_cache.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 
 namespace kengine::core::log::standard_output {
@@ -36,6 +37,7 @@ namespace kengine::core::log::standard_output {
 		system(entt::handle e) noexcept {
 			KENGINE_PROFILING_SCOPE;
 
+			enable_severity_cache(*e.registry());
 			e.emplace<on_log>(putils_forward_to_this(log));
 
 			kengine_log(*e.registry(), log, log_category, "Initializing");
@@ -0,0 +1,27 @@
+#pragma once
+
+// glm
+#include <glm/glm.hpp>
+
+// reflection
+#include "putils/reflection.hpp"
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+
+namespace kengine::glm {
+	//! putils reflect all
+	//! used_types: [kengine::core::transform]
+	struct world_matrix {
+		::glm::mat4 model_to_world{ 1.f };
+		::glm::mat4 world_to_model{ 1.f };
+		bool has_inverse = false;
+
+		// Transforms the matrix was computed from
+		core::transform transform;
+		core::transform model_transform;
+		bool has_model_transform = false;
+	};
+}
+
+#include "world_matrix.rpp"
\ No newline at end of file
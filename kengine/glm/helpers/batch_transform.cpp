@@ -0,0 +1,314 @@
+#include "batch_transform.hpp"
+
+// stl
+#include <algorithm>
+#include <cmath>
+
+// SSE2 is part of the x86-64 baseline, so it needs no runtime check
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KENGINE_GLM_BATCH_SSE
+#endif
+
+// intrinsics
+#ifdef KENGINE_GLM_BATCH_SSE
+#include <emmintrin.h>
+#endif
+#if defined(KENGINE_GLM_AVX2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/glm/helpers/impl/batch_transform_kernels.inl"
+
+namespace kengine::glm::batch {
+	namespace impl {
+		namespace {
+			struct scalar_lane {
+				using vec = float;
+				using ivec = int;
+				using mask = bool;
+				static constexpr size_t width = 1;
+
+				static vec set(float f) noexcept { return f; }
+				static vec load(const float * p) noexcept { return *p; }
+				static void store(float * p, vec v) noexcept { *p = v; }
+				static vec add(vec a, vec b) noexcept { return a + b; }
+				static vec sub(vec a, vec b) noexcept { return a - b; }
+				static vec mul(vec a, vec b) noexcept { return a * b; }
+				static vec fmadd(vec a, vec b, vec c) noexcept { return a * b + c; }
+				static vec round(vec v) noexcept { return std::nearbyint(v); }
+				static ivec to_int(vec v) noexcept { return ivec(v); }
+				static ivec add_int(ivec v, int i) noexcept { return v + i; }
+				static mask test_bit(ivec v, int bit) noexcept { return (v & bit) != 0; }
+				static vec select(mask m, vec if_true, vec if_false) noexcept { return m ? if_true : if_false; }
+				static vec negate_if(mask m, vec v) noexcept { return m ? -v : v; }
+
+				static void transform_point(const float * matrix, const float * point, float * out) noexcept {
+					for (size_t row = 0; row < 3; ++row)
+						out[row] = matrix[row] * point[0] + matrix[4 + row] * point[1] + matrix[8 + row] * point[2] + matrix[12 + row];
+				}
+			};
+
+#ifdef KENGINE_GLM_BATCH_SSE
+			struct sse_lane {
+				using vec = __m128;
+				using ivec = __m128i;
+				using mask = __m128;
+				static constexpr size_t width = 4;
+
+				static vec set(float f) noexcept { return _mm_set1_ps(f); }
+				static vec load(const float * p) noexcept { return _mm_loadu_ps(p); }
+				static void store(float * p, vec v) noexcept { _mm_storeu_ps(p, v); }
+				static vec add(vec a, vec b) noexcept { return _mm_add_ps(a, b); }
+				static vec sub(vec a, vec b) noexcept { return _mm_sub_ps(a, b); }
+				static vec mul(vec a, vec b) noexcept { return _mm_mul_ps(a, b); }
+				static vec fmadd(vec a, vec b, vec c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+				// SSE2 has no rounding instruction, but converting to int rounds to nearest
+				static vec round(vec v) noexcept { return _mm_cvtepi32_ps(_mm_cvtps_epi32(v)); }
+				static ivec to_int(vec v) noexcept { return _mm_cvtps_epi32(v); }
+				static ivec add_int(ivec v, int i) noexcept { return _mm_add_epi32(v, _mm_set1_epi32(i)); }
+				static mask test_bit(ivec v, int bit) noexcept { return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(v, _mm_set1_epi32(bit)), _mm_set1_epi32(bit))); }
+				static vec select(mask m, vec if_true, vec if_false) noexcept { return _mm_or_ps(_mm_and_ps(m, if_true), _mm_andnot_ps(m, if_false)); }
+				static vec negate_if(mask m, vec v) noexcept { return _mm_xor_ps(v, _mm_and_ps(m, _mm_set1_ps(-0.f))); }
+
+				// A 4x4 matrix column fits in a register
+				static void transform_point(const float * matrix, const float * point, float * out) noexcept {
+					auto result = _mm_loadu_ps(matrix + 12);
+					result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(matrix), _mm_set1_ps(point[0])), result);
+					result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(matrix + 4), _mm_set1_ps(point[1])), result);
+					result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(matrix + 8), _mm_set1_ps(point[2])), result);
+					_mm_storel_pi(reinterpret_cast<__m64 *>(out), result);
+					_mm_store_ss(out + 2, _mm_movehl_ps(result, result));
+				}
+			};
+#endif
+		}
+
+		const kernels scalar_kernels = kernel_impl<scalar_lane>::get_kernels();
+#ifdef KENGINE_GLM_BATCH_SSE
+		const kernels sse_kernels = kernel_impl<sse_lane>::get_kernels();
+#endif
+	}
+
+	static bool cpu_supports_avx2() noexcept {
+#if !defined(KENGINE_GLM_AVX2)
+		return false;
+#elif defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		const bool has_fma = info[2] & (1 << 12);
+		const bool has_osxsave = info[2] & (1 << 27);
+		// The OS must also save YMM registers on context switches
+		if (!has_fma || !has_osxsave || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return info[1] & (1 << 5);
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+	}
+
+	instruction_set get_instruction_set() noexcept {
+		static const auto best = [] {
+			if (cpu_supports_avx2())
+				return instruction_set::avx2;
+#ifdef KENGINE_GLM_BATCH_SSE
+			return instruction_set::sse;
+#else
+			return instruction_set::scalar;
+#endif
+		}();
+		return best;
+	}
+
+	// Instruction sets the CPU doesn't support fall back to the best one it does
+	static const impl::kernels & get_kernels(instruction_set set) noexcept {
+		switch (std::min(set, get_instruction_set())) {
+#ifdef KENGINE_GLM_AVX2
+			case instruction_set::avx2:
+				return impl::avx2_kernels;
+#endif
+#ifdef KENGINE_GLM_BATCH_SSE
+			case instruction_set::sse:
+				return impl::sse_kernels;
+#endif
+			default:
+				return impl::scalar_kernels;
+		}
+	}
+
+	// Entities are transposed to structures of arrays in blocks small enough to stay in the L1 cache
+	static constexpr size_t block_size = 64;
+	static_assert(block_size % impl::max_width == 0);
+
+	// Kernels run over whole registers, so blocks are padded by repeating their last entity, whose extra results are discarded
+	static size_t get_padded_count(size_t count) noexcept {
+		return (count + impl::max_width - 1) / impl::max_width * impl::max_width;
+	}
+
+	struct vec3_block {
+		float x[block_size];
+		float y[block_size];
+		float z[block_size];
+
+		void set(size_t i, float new_x, float new_y, float new_z) noexcept {
+			x[i] = new_x;
+			y[i] = new_y;
+			z[i] = new_z;
+		}
+
+		impl::soa_vec3 view() noexcept { return { x, y, z }; }
+		impl::const_soa_vec3 const_view() const noexcept { return { x, y, z }; }
+	};
+
+	struct affine_block {
+		float m[12][block_size];
+
+		impl::soa_affine view() noexcept {
+			impl::soa_affine ret;
+			for (size_t i = 0; i < 12; ++i)
+				ret.m[i] = m[i];
+			return ret;
+		}
+
+		impl::const_soa_affine const_view() const noexcept {
+			impl::const_soa_affine ret;
+			for (size_t i = 0; i < 12; ++i)
+				ret.m[i] = m[i];
+			return ret;
+		}
+
+		impl::soa_vec3 column(size_t index) noexcept { return { m[index * 3], m[index * 3 + 1], m[index * 3 + 2] }; }
+		impl::const_soa_vec3 const_column(size_t index) const noexcept { return { m[index * 3], m[index * 3 + 1], m[index * 3 + 2] }; }
+
+		::glm::mat4 get(size_t i) const noexcept {
+			return {
+				{ m[0][i], m[1][i], m[2][i], 0.f },
+				{ m[3][i], m[4][i], m[5][i], 0.f },
+				{ m[6][i], m[7][i], m[8][i], 0.f },
+				{ m[9][i], m[10][i], m[11][i], 1.f }
+			};
+		}
+	};
+
+	struct euler_block {
+		vec3_block position;
+		vec3_block size;
+		vec3_block angles; // yaw, pitch, roll
+
+		void set(size_t i, const core::transform & transform) noexcept {
+			const auto & box = transform.bounding_box;
+			position.set(i, box.position.x, box.position.y, box.position.z);
+			size.set(i, box.size.x, box.size.y, box.size.z);
+			angles.set(i, transform.yaw, transform.pitch, transform.roll);
+		}
+
+		impl::euler_transform view() const noexcept {
+			return {
+				.position = position.const_view(),
+				.size = size.const_view(),
+				.yaw = angles.x,
+				.pitch = angles.y,
+				.roll = angles.z,
+			};
+		}
+	};
+
+	void get_model_matrices(std::span<const core::transform> transforms, std::span<const core::transform * const> model_transforms, std::span<::glm::mat4> out, instruction_set set) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto & kernels = get_kernels(set);
+
+		// A default transform's model matrix is the identity
+		static const core::transform no_model_transform;
+
+		for (size_t begin = 0; begin < transforms.size(); begin += block_size) {
+			const auto count = std::min(block_size, transforms.size() - begin);
+			const auto padded_count = get_padded_count(count);
+
+			euler_block objects;
+			for (size_t i = 0; i < padded_count; ++i)
+				objects.set(i, transforms[begin + std::min(i, count - 1)]);
+
+			affine_block object_matrices;
+			kernels.get_object_matrices(objects.view(), object_matrices.view(), padded_count);
+
+			const affine_block * result = &object_matrices;
+
+			euler_block models;
+			bool has_model_transform = false;
+			if (!model_transforms.empty())
+				for (size_t i = 0; i < padded_count; ++i) {
+					const auto model_transform = model_transforms[begin + std::min(i, count - 1)];
+					has_model_transform |= model_transform != nullptr;
+					models.set(i, model_transform ? *model_transform : no_model_transform);
+				}
+
+			affine_block composed;
+			if (has_model_transform) {
+				affine_block model_matrices;
+				kernels.get_model_matrices(models.view(), model_matrices.view(), padded_count);
+
+				// object * model, one column at a time, only the last of which is a point
+				for (size_t column = 0; column < 4; ++column)
+					kernels.transform(object_matrices.const_view(), model_matrices.const_column(column), column == 3 ? 1.f : 0.f, composed.column(column), padded_count);
+				result = &composed;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+				out[begin + i] = result->get(i);
+		}
+	}
+
+	void transform_points(std::span<const ::glm::mat4> matrices, std::span<const ::glm::vec3> points, std::span<::glm::vec3> out, instruction_set set) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		static_assert(sizeof(::glm::mat4) == 16 * sizeof(float));
+		static_assert(sizeof(::glm::vec3) == 3 * sizeof(float));
+
+		if (points.empty())
+			return;
+		get_kernels(set).transform_points(&matrices[0][0].x, &points[0].x, &out[0].x, points.size());
+	}
+
+	void integrate(std::span<core::transform> transforms, std::span<const ::glm::vec3> movements, std::span<const ::glm::vec3> rotations, float delta_time, instruction_set set) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto & kernels = get_kernels(set);
+
+		for (size_t begin = 0; begin < transforms.size(); begin += block_size) {
+			const auto count = std::min(block_size, transforms.size() - begin);
+			const auto padded_count = get_padded_count(count);
+
+			vec3_block positions;
+			vec3_block angles;
+			vec3_block movement_block;
+			vec3_block rotation_block;
+			for (size_t i = 0; i < padded_count; ++i) {
+				const auto index = begin + std::min(i, count - 1);
+				const auto & transform = transforms[index];
+				positions.set(i, transform.bounding_box.position.x, transform.bounding_box.position.y, transform.bounding_box.position.z);
+				angles.set(i, transform.yaw, transform.pitch, transform.roll);
+				movement_block.set(i, movements[index].x, movements[index].y, movements[index].z);
+				rotation_block.set(i, rotations[index].x, rotations[index].y, rotations[index].z);
+			}
+
+			kernels.integrate(positions.view(), angles.view(), movement_block.const_view(), rotation_block.const_view(), delta_time, padded_count);
+
+			for (size_t i = 0; i < count; ++i) {
+				auto & transform = transforms[begin + i];
+				transform.bounding_box.position = { positions.x[i], positions.y[i], positions.z[i] };
+				transform.yaw = angles.x[i];
+				transform.pitch = angles.y[i];
+				transform.roll = angles.z[i];
+			}
+		}
+	}
+}
\ No newline at end of file
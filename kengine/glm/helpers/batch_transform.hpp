@@ -0,0 +1,24 @@
+#pragma once
+
+// stl
+#include <span>
+
+// glm
+#include <glm/glm.hpp>
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+
+namespace kengine::glm::batch {
+	enum class instruction_set {
+		scalar,
+		sse,
+		avx2,
+	};
+
+	KENGINE_GLM_EXPORT instruction_set get_instruction_set() noexcept;
+
+	KENGINE_GLM_EXPORT void get_model_matrices(std::span<const core::transform> transforms, std::span<const core::transform * const> model_transforms, std::span<::glm::mat4> out, instruction_set set = get_instruction_set()) noexcept;
+	KENGINE_GLM_EXPORT void transform_points(std::span<const ::glm::mat4> matrices, std::span<const ::glm::vec3> points, std::span<::glm::vec3> out, instruction_set set = get_instruction_set()) noexcept;
+	KENGINE_GLM_EXPORT void integrate(std::span<core::transform> transforms, std::span<const ::glm::vec3> movements, std::span<const ::glm::vec3> rotations, float delta_time, instruction_set set = get_instruction_set()) noexcept;
+}
\ No newline at end of file
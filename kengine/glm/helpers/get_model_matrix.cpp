@@ -1,7 +1,7 @@
 #include "get_model_matrix.hpp"
 
-// glm
-#include <glm/gtc/matrix_transform.hpp>
+// stl
+#include <cmath>
 
 // kengine
 #include "kengine/core/data/transform.hpp"
@@ -9,29 +9,52 @@
 #include "kengine/glm/helpers/to_vec.hpp"
 
 namespace kengine::glm {
+	// Closed form of `rotate(yaw, y) * rotate(pitch, x) * rotate(roll, z)`, which avoids building and multiplying three 4x4 matrices
+	static ::glm::mat3 get_rotation_matrix(const core::transform & transform) noexcept {
+		const auto cy = std::cos(transform.yaw);
+		const auto sy = std::sin(transform.yaw);
+		const auto cp = std::cos(transform.pitch);
+		const auto sp = std::sin(transform.pitch);
+		const auto cr = std::cos(transform.roll);
+		const auto sr = std::sin(transform.roll);
+
+		// Column-major
+		return {
+			{ cy * cr + sy * sp * sr, cp * sr, cy * sp * sr - sy * cr },
+			{ sy * sp * cr - cy * sr, cp * cr, sy * sr + cy * sp * cr },
+			{ sy * cp, -sp, cy * cp }
+		};
+	}
+
 	::glm::mat4 get_model_matrix(const core::transform & transform, const core::transform * model_transform) noexcept {
 		KENGINE_PROFILING_SCOPE;
 
-		::glm::mat4 model(1.f);
-
-		{ // object
-			model = ::glm::translate(model, kengine::glm::to_vec(transform.bounding_box.position));
-
-			model = ::glm::rotate(model, transform.yaw, { 0.f, 1.f, 0.f });
-			model = ::glm::rotate(model, transform.pitch, { 1.f, 0.f, 0.f });
-			model = ::glm::rotate(model, transform.roll, { 0.f, 0.f, 1.f });
-
-			model = ::glm::scale(model, kengine::glm::to_vec(transform.bounding_box.size));
-		}
-
-		if (model_transform != nullptr) { // Model
-			model = ::glm::scale(model, kengine::glm::to_vec(model_transform->bounding_box.size));
-
-			model = ::glm::rotate(model, model_transform->yaw, { 0.f, 1.f, 0.f });
-			model = ::glm::rotate(model, model_transform->pitch, { 1.f, 0.f, 0.f });
-			model = ::glm::rotate(model, model_transform->roll, { 0.f, 0.f, 1.f });
-
-			model = ::glm::translate(model, kengine::glm::to_vec(model_transform->bounding_box.position)); // Re-center
+		// object: translate * rotate * scale
+		const auto rotation = get_rotation_matrix(transform);
+		const auto & size = transform.bounding_box.size;
+		::glm::mat4 model{
+			::glm::vec4(rotation[0] * size.x, 0.f),
+			::glm::vec4(rotation[1] * size.y, 0.f),
+			::glm::vec4(rotation[2] * size.z, 0.f),
+			::glm::vec4(to_vec(transform.bounding_box.position), 1.f)
+		};
+
+		if (model_transform != nullptr) {
+			// Model: scale * rotate * translate, the translation re-centering the model
+			const auto model_scale = to_vec(model_transform->bounding_box.size);
+			const auto model_rotation = get_rotation_matrix(*model_transform);
+			const ::glm::mat3 scaled_rotation{
+				model_rotation[0] * model_scale,
+				model_rotation[1] * model_scale,
+				model_rotation[2] * model_scale
+			};
+			const ::glm::mat4 model_matrix{
+				::glm::vec4(scaled_rotation[0], 0.f),
+				::glm::vec4(scaled_rotation[1], 0.f),
+				::glm::vec4(scaled_rotation[2], 0.f),
+				::glm::vec4(scaled_rotation * to_vec(model_transform->bounding_box.position), 1.f)
+			};
+			model *= model_matrix;
 		}
 
 		return model;
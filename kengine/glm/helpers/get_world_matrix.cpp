@@ -0,0 +1,79 @@
+#include "get_world_matrix.hpp"
+
+// stl
+#include <cstring>
+
+// entt
+#include <entt/entity/handle.hpp>
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/glm/data/world_matrix.hpp"
+#include "kengine/glm/helpers/get_model_matrix.hpp"
+
+namespace kengine::glm {
+	static bool same_transform(const core::transform & lhs, const core::transform & rhs) noexcept {
+		return std::memcmp(&lhs, &rhs, sizeof(core::transform)) == 0;
+	}
+
+	// Transforms are commonly modified in place rather than through `patch`, so changes are detected by comparison instead of `on_update`.
+	// Comparing the model's transform as well means that moving a model invalidates all its instances
+	static bool is_up_to_date(const world_matrix & cache, const core::transform & transform, const core::transform * model_transform) noexcept {
+		return same_transform(cache.transform, transform) &&
+			   cache.has_model_transform == (model_transform != nullptr) &&
+			   (!model_transform || same_transform(cache.model_transform, *model_transform));
+	}
+
+	static void store(world_matrix & cache, const core::transform & transform, const core::transform * model_transform, const ::glm::mat4 & model_to_world) noexcept {
+		cache.model_to_world = model_to_world;
+		cache.has_inverse = false;
+
+		cache.transform = transform;
+		cache.has_model_transform = model_transform != nullptr;
+		if (model_transform)
+			cache.model_transform = *model_transform;
+	}
+
+	static world_matrix & update_world_matrix(entt::handle e, const core::transform & transform, const core::transform * model_transform) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		auto cache = e.try_get<world_matrix>();
+		if (cache && is_up_to_date(*cache, transform, model_transform))
+			return *cache;
+
+		if (!cache)
+			cache = &e.emplace<world_matrix>();
+		store(*cache, transform, model_transform, get_model_matrix(transform, model_transform));
+		return *cache;
+	}
+
+	const ::glm::mat4 & get_world_matrix(entt::handle e, const core::transform & transform, const core::transform * model_transform) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		return update_world_matrix(e, transform, model_transform).model_to_world;
+	}
+
+	const ::glm::mat4 & get_inverse_world_matrix(entt::handle e, const core::transform & transform, const core::transform * model_transform) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		auto & cache = update_world_matrix(e, transform, model_transform);
+		if (!cache.has_inverse) {
+			cache.world_to_model = ::glm::inverse(cache.model_to_world);
+			cache.has_inverse = true;
+		}
+		return cache.world_to_model;
+	}
+
+	void set_world_matrix(entt::handle e, const core::transform & transform, const core::transform * model_transform, const ::glm::mat4 & model_to_world) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		store(e.get_or_emplace<world_matrix>(), transform, model_transform, model_to_world);
+	}
+
+	const world_matrix * try_get_world_matrix(entt::const_handle e, const core::transform & transform, const core::transform * model_transform) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto cache = e.try_get<world_matrix>();
+		if (!cache || !is_up_to_date(*cache, transform, model_transform))
+			return nullptr;
+		return cache;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// glm
+#include <glm/glm.hpp>
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+#include "kengine/glm/data/world_matrix.hpp"
+
+namespace kengine::glm {
+	KENGINE_GLM_EXPORT const ::glm::mat4 & get_world_matrix(entt::handle e, const core::transform & transform, const core::transform * model_transform = nullptr) noexcept;
+	KENGINE_GLM_EXPORT const ::glm::mat4 & get_inverse_world_matrix(entt::handle e, const core::transform & transform, const core::transform * model_transform = nullptr) noexcept;
+	KENGINE_GLM_EXPORT void set_world_matrix(entt::handle e, const core::transform & transform, const core::transform * model_transform, const ::glm::mat4 & model_to_world) noexcept;
+	KENGINE_GLM_EXPORT const world_matrix * try_get_world_matrix(entt::const_handle e, const core::transform & transform, const core::transform * model_transform = nullptr) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+// Built with AVX2 and FMA enabled (see the library's CMakeLists.txt), and only called once the CPU is known to support them
+
+// intrinsics
+#include <immintrin.h>
+
+#include "batch_transform_kernels.inl"
+
+namespace kengine::glm::batch::impl {
+	namespace {
+		struct avx2_lane {
+			using vec = __m256;
+			using ivec = __m256i;
+			using mask = __m256;
+			static constexpr size_t width = 8;
+
+			static vec set(float f) noexcept { return _mm256_set1_ps(f); }
+			static vec load(const float * p) noexcept { return _mm256_loadu_ps(p); }
+			static void store(float * p, vec v) noexcept { _mm256_storeu_ps(p, v); }
+			static vec add(vec a, vec b) noexcept { return _mm256_add_ps(a, b); }
+			static vec sub(vec a, vec b) noexcept { return _mm256_sub_ps(a, b); }
+			static vec mul(vec a, vec b) noexcept { return _mm256_mul_ps(a, b); }
+			static vec fmadd(vec a, vec b, vec c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+			static vec round(vec v) noexcept { return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+			static ivec to_int(vec v) noexcept { return _mm256_cvtps_epi32(v); }
+			static ivec add_int(ivec v, int i) noexcept { return _mm256_add_epi32(v, _mm256_set1_epi32(i)); }
+			static mask test_bit(ivec v, int bit) noexcept { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(v, _mm256_set1_epi32(bit)), _mm256_set1_epi32(bit))); }
+			static vec select(mask m, vec if_true, vec if_false) noexcept { return _mm256_blendv_ps(if_false, if_true, m); }
+			static vec negate_if(mask m, vec v) noexcept { return _mm256_xor_ps(v, _mm256_and_ps(m, _mm256_set1_ps(-0.f))); }
+
+			// A 4x4 matrix column fits in a 128-bit register, which AVX2 can combine with FMA
+			static void transform_point(const float * matrix, const float * point, float * out) noexcept {
+				auto result = _mm_loadu_ps(matrix + 12);
+				result = _mm_fmadd_ps(_mm_loadu_ps(matrix), _mm_set1_ps(point[0]), result);
+				result = _mm_fmadd_ps(_mm_loadu_ps(matrix + 4), _mm_set1_ps(point[1]), result);
+				result = _mm_fmadd_ps(_mm_loadu_ps(matrix + 8), _mm_set1_ps(point[2]), result);
+				_mm_storel_pi(reinterpret_cast<__m64 *>(out), result);
+				_mm_store_ss(out + 2, _mm_movehl_ps(result, result));
+			}
+		};
+	}
+
+	const kernels avx2_kernels = kernel_impl<avx2_lane>::get_kernels();
+}
\ No newline at end of file
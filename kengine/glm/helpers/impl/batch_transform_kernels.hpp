@@ -0,0 +1,58 @@
+#pragma once
+
+// stl
+#include <cstddef>
+
+// This header is included by translation units built with different instruction sets, so it mustn't pull in any inline code that could be shared between them
+
+namespace kengine::glm::batch::impl {
+	// Kernels work on structure-of-arrays data, so that each lane of a SIMD register holds one entity
+	struct soa_vec3 {
+		float * x;
+		float * y;
+		float * z;
+	};
+
+	struct const_soa_vec3 {
+		const float * x;
+		const float * y;
+		const float * z;
+	};
+
+	// Column-major affine matrix, without its constant last row: `m[column * 3 + row]`
+	struct soa_affine {
+		float * m[12];
+	};
+
+	struct const_soa_affine {
+		const float * m[12];
+	};
+
+	struct euler_transform {
+		const_soa_vec3 position;
+		const_soa_vec3 size;
+		const float * yaw;
+		const float * pitch;
+		const float * roll;
+	};
+
+	// `count` must be a multiple of `max_width`
+	static constexpr size_t max_width = 8;
+
+	struct kernels {
+		// translate * rotate * scale, as in get_model_matrix
+		void (*get_object_matrices)(const euler_transform & in, const soa_affine & out, size_t count) noexcept;
+		// scale * rotate * translate, as applied by a model's transform in get_model_matrix
+		void (*get_model_matrices)(const euler_transform & in, const soa_affine & out, size_t count) noexcept;
+		// matrix * vec4(v, w)
+		void (*transform)(const const_soa_affine & matrices, const const_soa_vec3 & v, float w, const soa_vec3 & out, size_t count) noexcept;
+		// Same as `transform` with w = 1, for column-major 4x4 matrices and points stored one after the other. Transposing them would cost more than the product itself, so any `count` works
+		void (*transform_points)(const float * matrices, const float * points, float * out, size_t count) noexcept;
+		// position += movement * delta_time, and angles += rotation * delta_time constrained to [-pi, pi]
+		void (*integrate)(const soa_vec3 & position, const soa_vec3 & angles, const const_soa_vec3 & movement, const const_soa_vec3 & rotation, float delta_time, size_t count) noexcept;
+	};
+
+	extern const kernels scalar_kernels;
+	extern const kernels sse_kernels;
+	extern const kernels avx2_kernels;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "batch_transform_kernels.hpp"
+
+// Kernels are written once against a `Lane` type wrapping a SIMD register, and instantiated for each instruction set.
+// They live in an anonymous namespace so that instantiations built with different instruction sets never get merged by the linker.
+// `Lane` provides `vec`, `ivec`, `mask`, `width`, and static `set`, `load`, `store`, `add`, `sub`, `mul`, `fmadd` (a * b + c),
+// `round` (to nearest), `to_int`, `add_int`, `test_bit`, `select`, `negate_if` and `transform_point` functions.
+
+namespace kengine::glm::batch::impl {
+	namespace {
+		template<typename Lane>
+		struct kernel_impl {
+			using vec = typename Lane::vec;
+
+			static_assert(max_width % Lane::width == 0);
+
+			// Cephes' single precision sinf/cosf: reduce x to r in [-pi/4, pi/4] with x = r + quadrant * pi/2, then evaluate minimax polynomials
+			static void sincos(vec x, vec & s, vec & c) noexcept {
+				const auto quadrant = Lane::round(Lane::mul(x, Lane::set(0.63661977236758134f))); // 2 / pi
+
+				// pi/2 split in three, so that quadrant * part is exact for the first parts
+				auto r = Lane::fmadd(quadrant, Lane::set(-1.5703125f), x);
+				r = Lane::fmadd(quadrant, Lane::set(-4.837512969970703125e-4f), r);
+				r = Lane::fmadd(quadrant, Lane::set(-7.54978995489188216e-8f), r);
+				const auto r2 = Lane::mul(r, r);
+
+				auto sin_r = Lane::fmadd(Lane::fmadd(Lane::set(-1.9515295891e-4f), r2, Lane::set(8.3321608736e-3f)), r2, Lane::set(-1.6666654611e-1f));
+				sin_r = Lane::fmadd(Lane::mul(sin_r, r2), r, r);
+
+				auto cos_r = Lane::fmadd(Lane::fmadd(Lane::set(2.443315711809948e-5f), r2, Lane::set(-1.388731625493765e-3f)), r2, Lane::set(4.166664568298827e-2f));
+				cos_r = Lane::fmadd(Lane::mul(cos_r, r2), r2, Lane::fmadd(r2, Lane::set(-.5f), Lane::set(1.f)));
+
+				// Quadrants 1 and 3 swap sin and cos, quadrants 2 and 3 negate sin, quadrants 1 and 2 negate cos
+				const auto quadrant_index = Lane::to_int(quadrant);
+				const auto swap = Lane::test_bit(quadrant_index, 1);
+				s = Lane::negate_if(Lane::test_bit(quadrant_index, 2), Lane::select(swap, cos_r, sin_r));
+				c = Lane::negate_if(Lane::test_bit(Lane::add_int(quadrant_index, 1), 2), Lane::select(swap, sin_r, cos_r));
+			}
+
+			// Same as get_model_matrix's closed form of `rotate(yaw, y) * rotate(pitch, x) * rotate(roll, z)`, in column-major order
+			static void get_rotation(const euler_transform & in, size_t i, vec (&rotation)[9]) noexcept {
+				vec sy, cy, sp, cp, sr, cr;
+				sincos(Lane::load(in.yaw + i), sy, cy);
+				sincos(Lane::load(in.pitch + i), sp, cp);
+				sincos(Lane::load(in.roll + i), sr, cr);
+
+				const auto sy_sp = Lane::mul(sy, sp);
+				const auto cy_sp = Lane::mul(cy, sp);
+
+				rotation[0] = Lane::fmadd(sy_sp, sr, Lane::mul(cy, cr));
+				rotation[1] = Lane::mul(cp, sr);
+				rotation[2] = Lane::sub(Lane::mul(cy_sp, sr), Lane::mul(sy, cr));
+				rotation[3] = Lane::sub(Lane::mul(sy_sp, cr), Lane::mul(cy, sr));
+				rotation[4] = Lane::mul(cp, cr);
+				rotation[5] = Lane::fmadd(cy_sp, cr, Lane::mul(sy, sr));
+				rotation[6] = Lane::mul(sy, cp);
+				rotation[7] = Lane::sub(Lane::set(0.f), sp);
+				rotation[8] = Lane::mul(cy, cp);
+			}
+
+			static void get_object_matrices(const euler_transform & in, const soa_affine & out, size_t count) noexcept {
+				for (size_t i = 0; i < count; i += Lane::width) {
+					vec rotation[9];
+					get_rotation(in, i, rotation);
+
+					// Each column is scaled by the matching size component
+					const vec size[3] = { Lane::load(in.size.x + i), Lane::load(in.size.y + i), Lane::load(in.size.z + i) };
+					for (size_t column = 0; column < 3; ++column)
+						for (size_t row = 0; row < 3; ++row)
+							Lane::store(out.m[column * 3 + row] + i, Lane::mul(rotation[column * 3 + row], size[column]));
+
+					Lane::store(out.m[9] + i, Lane::load(in.position.x + i));
+					Lane::store(out.m[10] + i, Lane::load(in.position.y + i));
+					Lane::store(out.m[11] + i, Lane::load(in.position.z + i));
+				}
+			}
+
+			static void get_model_matrices(const euler_transform & in, const soa_affine & out, size_t count) noexcept {
+				for (size_t i = 0; i < count; i += Lane::width) {
+					vec rotation[9];
+					get_rotation(in, i, rotation);
+
+					// Each row is scaled by the matching size component
+					const vec size[3] = { Lane::load(in.size.x + i), Lane::load(in.size.y + i), Lane::load(in.size.z + i) };
+					for (size_t column = 0; column < 3; ++column)
+						for (size_t row = 0; row < 3; ++row)
+							rotation[column * 3 + row] = Lane::mul(rotation[column * 3 + row], size[row]);
+
+					// The translation is rotated and scaled
+					const vec position[3] = { Lane::load(in.position.x + i), Lane::load(in.position.y + i), Lane::load(in.position.z + i) };
+					for (size_t row = 0; row < 3; ++row) {
+						auto translation = Lane::mul(rotation[row], position[0]);
+						translation = Lane::fmadd(rotation[3 + row], position[1], translation);
+						translation = Lane::fmadd(rotation[6 + row], position[2], translation);
+						Lane::store(out.m[9 + row] + i, translation);
+					}
+
+					for (size_t j = 0; j < 9; ++j)
+						Lane::store(out.m[j] + i, rotation[j]);
+				}
+			}
+
+			static void transform(const const_soa_affine & matrices, const const_soa_vec3 & v, float w, const soa_vec3 & out, size_t count) noexcept {
+				float * const out_rows[3] = { out.x, out.y, out.z };
+				const auto lane_w = Lane::set(w);
+
+				for (size_t i = 0; i < count; i += Lane::width) {
+					const vec components[3] = { Lane::load(v.x + i), Lane::load(v.y + i), Lane::load(v.z + i) };
+					for (size_t row = 0; row < 3; ++row) {
+						auto result = Lane::mul(Lane::load(matrices.m[9 + row] + i), lane_w);
+						for (size_t column = 0; column < 3; ++column)
+							result = Lane::fmadd(Lane::load(matrices.m[column * 3 + row] + i), components[column], result);
+						Lane::store(out_rows[row] + i, result);
+					}
+				}
+			}
+
+			static void transform_points(const float * matrices, const float * points, float * out, size_t count) noexcept {
+				for (size_t i = 0; i < count; ++i)
+					Lane::transform_point(matrices + i * 16, points + i * 3, out + i * 3);
+			}
+
+			static void integrate(const soa_vec3 & position, const soa_vec3 & angles, const const_soa_vec3 & movement, const const_soa_vec3 & rotation, float delta_time, size_t count) noexcept {
+				float * const positions[3] = { position.x, position.y, position.z };
+				const float * const movements[3] = { movement.x, movement.y, movement.z };
+				float * const angle_arrays[3] = { angles.x, angles.y, angles.z };
+				const float * const rotations[3] = { rotation.x, rotation.y, rotation.z };
+
+				const auto dt = Lane::set(delta_time);
+				const auto two_pi = Lane::set(6.28318530717958647f);
+				const auto inverse_two_pi = Lane::set(0.15915494309189534f);
+
+				for (size_t i = 0; i < count; i += Lane::width)
+					for (size_t axis = 0; axis < 3; ++axis) {
+						Lane::store(positions[axis] + i, Lane::fmadd(Lane::load(movements[axis] + i), dt, Lane::load(positions[axis] + i)));
+
+						// Subtracting the nearest multiple of 2 pi brings the angle back to [-pi, pi]
+						const auto angle = Lane::fmadd(Lane::load(rotations[axis] + i), dt, Lane::load(angle_arrays[axis] + i));
+						const auto turns = Lane::round(Lane::mul(angle, inverse_two_pi));
+						Lane::store(angle_arrays[axis] + i, Lane::sub(angle, Lane::mul(turns, two_pi)));
+					}
+			}
+
+			static constexpr kernels get_kernels() noexcept {
+				return {
+					.get_object_matrices = get_object_matrices,
+					.get_model_matrices = get_model_matrices,
+					.transform = transform,
+					.transform_points = transform_points,
+					.integrate = integrate,
+				};
+			}
+		};
+	}
+}
\ No newline at end of file
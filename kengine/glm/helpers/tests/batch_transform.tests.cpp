@@ -0,0 +1,244 @@
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// putils
+#include "putils/angle.hpp"
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+#include "kengine/glm/helpers/batch_transform.hpp"
+#include "kengine/glm/helpers/get_model_matrix.hpp"
+
+using kengine::glm::batch::instruction_set;
+
+static constexpr instruction_set instruction_sets[] = { instruction_set::scalar, instruction_set::sse, instruction_set::avx2 };
+
+static const char * get_name(instruction_set set) noexcept {
+	switch (set) {
+		case instruction_set::sse:
+			return "sse";
+		case instruction_set::avx2:
+			return "avx2";
+		default:
+			return "scalar";
+	}
+}
+
+// Angles span several turns, to exercise the range reduction
+static std::vector<kengine::core::transform> get_random_transforms(size_t count) noexcept {
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> position(-100.f, 100.f);
+	std::uniform_real_distribution<float> size(.1f, 10.f);
+	std::uniform_real_distribution<float> angle(-4.f * std::numbers::pi_v<float>, 4.f * std::numbers::pi_v<float>);
+
+	std::vector<kengine::core::transform> transforms(count);
+	for (auto & transform : transforms) {
+		transform.bounding_box.position = { position(generator), position(generator), position(generator) };
+		transform.bounding_box.size = { size(generator), size(generator), size(generator) };
+		transform.yaw = angle(generator);
+		transform.pitch = angle(generator);
+		transform.roll = angle(generator);
+	}
+	return transforms;
+}
+
+static void expect_near(const glm::mat4 & lhs, const glm::mat4 & rhs) noexcept {
+	for (int column = 0; column < 4; ++column)
+		for (int row = 0; row < 4; ++row) {
+			const auto tolerance = 1e-4f * std::max(1.f, std::abs(rhs[column][row]));
+			EXPECT_NEAR(lhs[column][row], rhs[column][row], tolerance) << "column " << column << ", row " << row;
+		}
+}
+
+TEST(batch_transform, get_model_matrices) {
+	// Not a multiple of any register width or of the block size
+	const auto transforms = get_random_transforms(203);
+
+	for (const auto set : instruction_sets) {
+		std::vector<glm::mat4> matrices(transforms.size());
+		kengine::glm::batch::get_model_matrices(transforms, {}, matrices, set);
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+			expect_near(matrices[i], kengine::glm::get_model_matrix(transforms[i]));
+	}
+}
+
+TEST(batch_transform, get_model_matrices_model_transforms) {
+	const auto transforms = get_random_transforms(203);
+	const auto models = get_random_transforms(3);
+
+	// Some entities have no model
+	std::vector<const kengine::core::transform *> model_transforms(transforms.size());
+	for (size_t i = 0; i < model_transforms.size(); ++i)
+		model_transforms[i] = i % 4 == 3 ? nullptr : &models[i % 4];
+
+	for (const auto set : instruction_sets) {
+		std::vector<glm::mat4> matrices(transforms.size());
+		kengine::glm::batch::get_model_matrices(transforms, model_transforms, matrices, set);
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+			expect_near(matrices[i], kengine::glm::get_model_matrix(transforms[i], model_transforms[i]));
+	}
+}
+
+TEST(batch_transform, transform_points) {
+	const auto transforms = get_random_transforms(37);
+
+	std::vector<glm::mat4> matrices;
+	std::vector<glm::vec3> points;
+	for (const auto & transform : transforms) {
+		matrices.push_back(kengine::glm::get_model_matrix(transform));
+		points.push_back({ transform.yaw, transform.pitch, transform.roll });
+	}
+
+	for (const auto set : instruction_sets) {
+		std::vector<glm::vec3> results(points.size());
+		kengine::glm::batch::transform_points(matrices, points, results, set);
+
+		for (size_t i = 0; i < points.size(); ++i) {
+			const auto expected = matrices[i] * glm::vec4(points[i], 1.f);
+			for (int axis = 0; axis < 3; ++axis)
+				EXPECT_NEAR(results[i][axis], expected[axis], 1e-3f);
+		}
+	}
+}
+
+TEST(batch_transform, integrate) {
+	const auto initial_transforms = get_random_transforms(37);
+
+	std::vector<glm::vec3> movements;
+	std::vector<glm::vec3> rotations;
+	for (size_t i = 0; i < initial_transforms.size(); ++i) {
+		movements.push_back({ float(i), -float(i), 1.f });
+		rotations.push_back({ 1.f, -2.f, float(i) });
+	}
+
+	constexpr auto delta_time = .5f;
+	constexpr auto pi = std::numbers::pi_v<float>;
+
+	for (const auto set : instruction_sets) {
+		auto transforms = initial_transforms;
+		kengine::glm::batch::integrate(transforms, movements, rotations, delta_time, set);
+
+		for (size_t i = 0; i < transforms.size(); ++i) {
+			const auto & initial = initial_transforms[i];
+			const auto & position = transforms[i].bounding_box.position;
+			EXPECT_NEAR(position.x, initial.bounding_box.position.x + movements[i].x * delta_time, 1e-4f);
+			EXPECT_NEAR(position.y, initial.bounding_box.position.y + movements[i].y * delta_time, 1e-4f);
+			EXPECT_NEAR(position.z, initial.bounding_box.position.z + movements[i].z * delta_time, 1e-4f);
+
+			const auto expect_angle = [&](float angle, float initial_angle, float rotation) noexcept {
+				EXPECT_GE(angle, -pi - 1e-5f);
+				EXPECT_LE(angle, pi + 1e-5f);
+				// Same direction as the unconstrained angle
+				const auto expected = initial_angle + rotation * delta_time;
+				EXPECT_NEAR(std::cos(angle), std::cos(expected), 1e-4f);
+				EXPECT_NEAR(std::sin(angle), std::sin(expected), 1e-4f);
+			};
+			expect_angle(transforms[i].yaw, initial.yaw, rotations[i].x);
+			expect_angle(transforms[i].pitch, initial.pitch, rotations[i].y);
+			expect_angle(transforms[i].roll, initial.roll, rotations[i].z);
+		}
+	}
+}
+
+// Microbenchmarks comparing each instruction set with the per-entity scalar path. They only report throughput, as timings depend on the machine.
+// Disabled by default, run them with --gtest_also_run_disabled_tests
+template<typename Func>
+static double get_nanoseconds_per_entity(size_t entity_count, Func && func) noexcept {
+	constexpr size_t iterations = 20;
+
+	// Warm up caches first
+	func();
+
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; ++i)
+		func();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / double(iterations * entity_count);
+}
+
+static void report(const char * benchmark, const char * path, double nanoseconds_per_entity, double reference) noexcept {
+	const auto name = std::string(benchmark) + "_" + path;
+	testing::Test::RecordProperty(name, std::to_string(nanoseconds_per_entity));
+	testing::Test::RecordProperty(name + "_speedup", std::to_string(reference / nanoseconds_per_entity));
+}
+
+static constexpr size_t benchmark_entity_count = 100'000;
+
+TEST(batch_transform, DISABLED_benchmark_get_model_matrices) {
+	const auto transforms = get_random_transforms(benchmark_entity_count);
+	const auto models = get_random_transforms(1);
+	const std::vector<const kengine::core::transform *> model_transforms(transforms.size(), &models[0]);
+	std::vector<glm::mat4> matrices(transforms.size());
+
+	const auto reference = get_nanoseconds_per_entity(transforms.size(), [&] {
+		for (size_t i = 0; i < transforms.size(); ++i)
+			matrices[i] = kengine::glm::get_model_matrix(transforms[i], model_transforms[i]);
+	});
+	report("get_model_matrices", "get_model_matrix", reference, reference);
+
+	for (const auto set : instruction_sets)
+		report("get_model_matrices", get_name(set), get_nanoseconds_per_entity(transforms.size(), [&] {
+			kengine::glm::batch::get_model_matrices(transforms, model_transforms, matrices, set);
+		}), reference);
+}
+
+TEST(batch_transform, DISABLED_benchmark_transform_points) {
+	const auto transforms = get_random_transforms(benchmark_entity_count);
+
+	std::vector<glm::mat4> matrices;
+	std::vector<glm::vec3> points;
+	for (const auto & transform : transforms) {
+		matrices.push_back(kengine::glm::get_model_matrix(transform));
+		points.push_back({ transform.yaw, transform.pitch, transform.roll });
+	}
+	std::vector<glm::vec3> results(points.size());
+
+	const auto reference = get_nanoseconds_per_entity(points.size(), [&] {
+		for (size_t i = 0; i < points.size(); ++i) {
+			const auto result = matrices[i] * glm::vec4(points[i], 1.f);
+			results[i] = { result.x, result.y, result.z };
+		}
+	});
+	report("transform_points", "glm", reference, reference);
+
+	for (const auto set : instruction_sets)
+		report("transform_points", get_name(set), get_nanoseconds_per_entity(points.size(), [&] {
+			kengine::glm::batch::transform_points(matrices, points, results, set);
+		}), reference);
+}
+
+TEST(batch_transform, DISABLED_benchmark_integrate) {
+	auto transforms = get_random_transforms(benchmark_entity_count);
+	const std::vector<glm::vec3> movements(transforms.size(), { 1.f, 2.f, 3.f });
+	const std::vector<glm::vec3> rotations(transforms.size(), { .1f, .2f, .3f });
+
+	// What the kinematic system did for each entity before using the batch layer
+	const auto reference = get_nanoseconds_per_entity(transforms.size(), [&] {
+		for (size_t i = 0; i < transforms.size(); ++i) {
+			auto & transform = transforms[i];
+			transform.bounding_box.position.x += movements[i].x * .01f;
+			transform.bounding_box.position.y += movements[i].y * .01f;
+			transform.bounding_box.position.z += movements[i].z * .01f;
+			transform.yaw = putils::constrain_angle(transform.yaw + rotations[i].x * .01f);
+			transform.pitch = putils::constrain_angle(transform.pitch + rotations[i].y * .01f);
+			transform.roll = putils::constrain_angle(transform.roll + rotations[i].z * .01f);
+		}
+	});
+	report("integrate", "per entity", reference, reference);
+
+	for (const auto set : instruction_sets)
+		report("integrate", get_name(set), get_nanoseconds_per_entity(transforms.size(), [&] {
+			kengine::glm::batch::integrate(transforms, movements, rotations, .01f, set);
+		}), reference);
+}
@@ -1,10 +1,14 @@
 // gtest
 #include <gtest/gtest.h>
 
+// glm
+#include <glm/gtc/matrix_transform.hpp>
+
 // kengine
 #include "kengine/core/data/transform.hpp"
 #include "kengine/glm/helpers/extract_from_matrix.hpp"
 #include "kengine/glm/helpers/get_model_matrix.hpp"
+#include "kengine/glm/helpers/to_vec.hpp"
 
 TEST(glm, get_model_matrix) {
 	const putils::point3f expected_pos{ 42.f, -42.f, 0.f };
@@ -29,3 +33,50 @@ TEST(glm, get_model_matrix) {
 	const auto rotation = kengine::glm::extract_rotation(mat);
 	EXPECT_EQ(rotation, expected_rotation);
 }
+
+// Reference implementation, applying each step of the transformation separately
+static glm::mat4 get_reference_model_matrix(const kengine::core::transform & transform, const kengine::core::transform & model_transform) noexcept {
+	glm::mat4 model(1.f);
+
+	model = glm::translate(model, kengine::glm::to_vec(transform.bounding_box.position));
+	model = glm::rotate(model, transform.yaw, { 0.f, 1.f, 0.f });
+	model = glm::rotate(model, transform.pitch, { 1.f, 0.f, 0.f });
+	model = glm::rotate(model, transform.roll, { 0.f, 0.f, 1.f });
+	model = glm::scale(model, kengine::glm::to_vec(transform.bounding_box.size));
+
+	model = glm::scale(model, kengine::glm::to_vec(model_transform.bounding_box.size));
+	model = glm::rotate(model, model_transform.yaw, { 0.f, 1.f, 0.f });
+	model = glm::rotate(model, model_transform.pitch, { 1.f, 0.f, 0.f });
+	model = glm::rotate(model, model_transform.roll, { 0.f, 0.f, 1.f });
+	model = glm::translate(model, kengine::glm::to_vec(model_transform.bounding_box.position));
+
+	return model;
+}
+
+TEST(glm, get_model_matrix_rotation_and_model) {
+	const kengine::core::transform transform{
+		.bounding_box = {
+			.position = { 1.f, 2.f, 3.f },
+			.size = { 2.f, 3.f, 4.f },
+		},
+		.yaw = 0.5f,
+		.pitch = -1.2f,
+		.roll = 2.f,
+	};
+
+	const kengine::core::transform model_transform{
+		.bounding_box = {
+			.position = { -.5f, .25f, 1.f },
+			.size = { .5f, 2.f, 1.5f },
+		},
+		.yaw = -2.5f,
+		.pitch = .3f,
+		.roll = 1.f,
+	};
+
+	const auto mat = kengine::glm::get_model_matrix(transform, &model_transform);
+	const auto expected = get_reference_model_matrix(transform, model_transform);
+	for (int col = 0; col < 4; ++col)
+		for (int row = 0; row < 4; ++row)
+			EXPECT_NEAR(mat[col][row], expected[col][row], .0001f);
+}
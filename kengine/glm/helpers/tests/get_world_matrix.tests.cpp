@@ -0,0 +1,88 @@
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+#include "kengine/glm/data/world_matrix.hpp"
+#include "kengine/glm/helpers/get_model_matrix.hpp"
+#include "kengine/glm/helpers/get_world_matrix.hpp"
+
+TEST(glm, get_world_matrix) {
+	entt::registry r;
+	const entt::handle e{ r, r.create() };
+
+	kengine::core::transform transform{
+		.bounding_box = {
+			.position = { 42.f, -42.f, 0.f },
+			.size = { 2.f, 2.f, 2.f },
+		}
+	};
+	kengine::core::transform model_transform;
+
+	EXPECT_EQ(kengine::glm::get_world_matrix(e, transform, &model_transform), kengine::glm::get_model_matrix(transform, &model_transform));
+	EXPECT_TRUE(e.all_of<kengine::glm::world_matrix>());
+
+	// Modified in place
+	transform.yaw = 1.f;
+	EXPECT_EQ(kengine::glm::get_world_matrix(e, transform, &model_transform), kengine::glm::get_model_matrix(transform, &model_transform));
+
+	// Model moved
+	model_transform.bounding_box.position.x = 1.f;
+	EXPECT_EQ(kengine::glm::get_world_matrix(e, transform, &model_transform), kengine::glm::get_model_matrix(transform, &model_transform));
+
+	// Model removed
+	EXPECT_EQ(kengine::glm::get_world_matrix(e, transform), kengine::glm::get_model_matrix(transform));
+}
+
+TEST(glm, get_inverse_world_matrix) {
+	entt::registry r;
+	const entt::handle e{ r, r.create() };
+
+	kengine::core::transform transform{
+		.bounding_box = {
+			.position = { 42.f, -42.f, 0.f },
+			.size = { 2.f, 2.f, 2.f },
+		}
+	};
+
+	const auto & inverse = kengine::glm::get_inverse_world_matrix(e, transform);
+	EXPECT_EQ(inverse, glm::inverse(kengine::glm::get_model_matrix(transform)));
+
+	transform.bounding_box.position.y = 0.f;
+	EXPECT_EQ(kengine::glm::get_inverse_world_matrix(e, transform), glm::inverse(kengine::glm::get_model_matrix(transform)));
+}
+TEST(glm, try_get_world_matrix) {
+	entt::registry r;
+	const entt::handle e{ r, r.create() };
+
+	kengine::core::transform transform;
+	EXPECT_EQ(kengine::glm::try_get_world_matrix(e, transform), nullptr);
+
+	kengine::glm::get_world_matrix(e, transform);
+	const auto cached = kengine::glm::try_get_world_matrix(e, transform);
+	ASSERT_NE(cached, nullptr);
+	EXPECT_EQ(cached->model_to_world, kengine::glm::get_model_matrix(transform));
+
+	// Out of date
+	transform.bounding_box.position.x = 42.f;
+	EXPECT_EQ(kengine::glm::try_get_world_matrix(e, transform), nullptr);
+}
+
+TEST(glm, set_world_matrix) {
+	entt::registry r;
+	const entt::handle e{ r, r.create() };
+
+	kengine::core::transform transform;
+	transform.bounding_box.position.x = 42.f;
+	const auto matrix = kengine::glm::get_model_matrix(transform);
+
+	kengine::glm::set_world_matrix(e, transform, nullptr, matrix);
+	const auto cached = kengine::glm::try_get_world_matrix(e, transform);
+	ASSERT_NE(cached, nullptr);
+	EXPECT_EQ(cached->model_to_world, matrix);
+	EXPECT_EQ(kengine::glm::get_inverse_world_matrix(e, transform), glm::inverse(matrix));
+}
\ No newline at end of file
@@ -21,13 +21,13 @@
 // kengine
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
 #include "kengine/core/data/name.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/core/sort/helpers/get_name_sorted_entities.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 
 #ifndef KENGINE_IMGUI_TOOLS_SAVE_FILE
 #define KENGINE_IMGUI_TOOLS_SAVE_FILE "imgui_tools.ini"
@@ -52,7 +52,7 @@ namespace kengine::imgui::tool {
 		menu_entry root_entry;
 
 		struct processed {};
-		kengine::new_entity_processor<processed, tool> processor{ r, putils_forward_to_this(on_construct_tool) };
+		kengine::reactive_entity_processor<processed, tool> processor{ r, putils_forward_to_this(on_construct_tool) };
 		const entt::scoped_connection remove_tool = r.on_destroy<tool>().connect<&system::on_destroy_imgui_tool>(this);
 
 		system(entt::handle e) noexcept
@@ -60,7 +60,7 @@ namespace kengine::imgui::tool {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, log, log_category, "Initializing");
 
-			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute));
 
 			std::ifstream f(KENGINE_IMGUI_TOOLS_SAVE_FILE);
 			f >> configuration;
@@ -68,7 +68,7 @@ namespace kengine::imgui::tool {
 			processor.process();
 		}
 
-		void execute(float delta_time) noexcept {
+		void execute(float delta_time, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
@@ -1,9 +1,13 @@
 #include "system.hpp"
 
 // stl
+#include <algorithm>
 #include <concepts>
+#include <execution>
 #include <filesystem>
 #include <fstream>
+#include <span>
+#include <vector>
 
 // entt
 #include <entt/entity/handle.hpp>
@@ -15,15 +19,16 @@
 // putils
 #include "putils/forward_to.hpp"
 #include "putils/range.hpp"
+#include "putils/thread_name.hpp"
 
 // kengine
 #include "kengine/async/helpers/process_results.hpp"
 #include "kengine/async/helpers/start_task.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/json_scene_loader/data/request.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
-#include "kengine/meta/json/helpers/load_entity.hpp"
+#include "kengine/meta/json/helpers/load_entities.hpp"
 
 namespace kengine::json_scene_loader {
 	struct system {
@@ -31,7 +36,7 @@ namespace kengine::json_scene_loader {
 		entt::registry & r;
 
 		struct processed {};
-		kengine::new_entity_processor<processed, request> processor{ r, putils_forward_to_this(process_new_request) };
+		kengine::reactive_entity_processor<processed, request> processor{ r, putils_forward_to_this(process_new_request) };
 
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
@@ -39,20 +44,27 @@ namespace kengine::json_scene_loader {
 			kengine_log(r, log, log_category, "Initializing");
 
 			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			kengine::async::prepare_tasks<load_models_task>(r);
 			processor.process();
 		}
 
 		struct temporary_scene {
 			std::vector<entt::entity> loaded_entities;
 		};
-		struct load_models_task {};
+		struct load_models_task {
+			std::vector<nlohmann::json> models;
+		};
 		void execute(float delta_time) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
 			processor.process();
 
-			kengine::async::process_results<load_models_task>(r, [this](entt::entity e, load_models_task &&) {
+			kengine::async::process_results<load_models_task>(r, [this](entt::entity e, load_models_task && task) {
+				// Models were only parsed by the async task, the registry is filled from the main thread
+				kengine_logf(r, log, log_category, "Creating {} models", task.models.size());
+				create_entities(task.models);
+
 				// Entity that will wait until all async loading tasks are completed before loading the scene
 				const auto poller = r.create();
 				kengine_logf(r, verbose, log_category, "Creating polling entity {}", poller);
@@ -96,9 +108,10 @@ namespace kengine::json_scene_loader {
 			kengine::async::start_task(
 				r, e,
 				async::task::string("json_scene_loader: load models from {}", comp.model_directory),
-				std::async(std::launch::async, [this, &comp] {
-					return load_models(comp.model_directory.c_str());
-				})
+				[this, dir = comp.model_directory] {
+					return load_models(dir.c_str());
+				},
+				async::priority::high
 			);
 		}
 
@@ -119,14 +132,8 @@ namespace kengine::json_scene_loader {
 				return scene;
 			}
 
-			const auto temporary_scene_json = nlohmann::json::parse(f);
-
-			for (const auto & json : temporary_scene_json) {
-				const auto e = r.create();
-				kengine_logf(r, verbose, log_category, "Creating temporary {}", e);
-				scene.loaded_entities.push_back(e);
-				meta::json::load_entity(json, { r, e });
-			}
+			const auto temporary_scene_json = parse(f, file);
+			scene.loaded_entities = create_entities(get_entities(temporary_scene_json));
 
 			kengine_log(r, log, log_category, "Temporary scene loaded");
 
@@ -141,18 +148,25 @@ namespace kengine::json_scene_loader {
 				return {};
 			}
 
-			for (const auto & entry : std::filesystem::recursive_directory_iterator(dir)) {
-				if (entry.path().extension() != ".json")
-					continue;
+			std::vector<std::filesystem::path> files;
+			for (const auto & entry : std::filesystem::recursive_directory_iterator(dir))
+				if (entry.path().extension() == ".json")
+					files.push_back(entry.path());
 
-				const auto e = r.create();
-				std::ifstream f(entry.path());
-				const auto json = nlohmann::json::parse(f);
-				kengine_logf(r, verbose, log_category, "Creating model {}", e);
-				meta::json::load_entity(json, { r, e });
-			}
+			kengine_logf(r, verbose, log_category, "Parsing {} model files", files.size());
 
-			return {};
+			load_models_task task;
+			task.models.resize(files.size());
+			std::for_each(std::execution::par, putils_range(files), [&](const std::filesystem::path & path) noexcept {
+				const putils::scoped_thread_name thread_name("JSON model parser");
+				const auto index = &path - files.data();
+				std::ifstream f(path);
+				task.models[index] = parse(f, path.string().c_str());
+			});
+
+			// Files which failed to parse are left as null
+			std::erase_if(task.models, [](const nlohmann::json & json) noexcept { return json.is_null(); });
+			return task;
 		}
 
 		void load_scene(const char * file) noexcept {
@@ -165,15 +179,41 @@ namespace kengine::json_scene_loader {
 				return;
 			}
 
-			const auto scene_json = nlohmann::json::parse(f);
+			const auto scene_json = parse(f, file);
+			create_entities(get_entities(scene_json));
 
-			for (const auto & json : scene_json) {
-				const auto e = r.create();
-				kengine_logf(r, verbose, log_category, "Creating {}", e);
-				meta::json::load_entity(json, { r, e });
+			kengine_log(r, log, log_category, "Scene loaded");
+		}
+
+		nlohmann::json parse(std::ifstream & f, const char * file) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			auto json = nlohmann::json::parse(f, nullptr, false);
+			if (json.is_discarded()) {
+				kengine_logf(r, error, log_category, "Failed to parse {}", file);
+				return nullptr;
 			}
+			return json;
+		}
 
-			kengine_log(r, log, log_category, "Scene loaded");
+		std::span<const nlohmann::json> get_entities(const nlohmann::json & scene_json) noexcept {
+			if (!scene_json.is_array()) {
+				if (!scene_json.is_null())
+					kengine_log(r, error, log_category, "Expected an array of entities");
+				return {};
+			}
+			return scene_json.get_ref<const nlohmann::json::array_t &>();
+		}
+
+		std::vector<entt::entity> create_entities(std::span<const nlohmann::json> entities_json) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			std::vector<entt::entity> entities(entities_json.size());
+			r.create(entities.begin(), entities.end());
+			kengine_logf(r, verbose, log_category, "Created {} entities", entities.size());
+
+			meta::json::load_entities(entities_json, entities, r);
+			return entities;
 		}
 	};
 
@@ -0,0 +1,19 @@
+#pragma once
+
+// stl
+#include <vector>
+
+// entt
+#include <entt/core/fwd.hpp>
+
+namespace kengine::main_loop {
+	//! putils reflect all
+	struct access {
+		std::vector<entt::id_type> reads;
+		std::vector<entt::id_type> writes;
+		bool main_thread = false;
+		bool exclusive = false;
+	};
+}
+
+#include "access.rpp"
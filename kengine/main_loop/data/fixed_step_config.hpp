@@ -0,0 +1,14 @@
+#pragma once
+
+namespace kengine::main_loop {
+	//! putils reflect all
+	//! metadata: [("config", true)]
+	struct fixed_step_config {
+		float steps_per_second = 60.f;
+		unsigned int max_steps_per_frame = 5;
+		float max_frames_per_second = 0.f;
+		float yield_duration = 0.f;
+	};
+}
+
+#include "fixed_step_config.rpp"
@@ -0,0 +1,13 @@
+#pragma once
+
+// kengine
+#include "kengine/base_function.hpp"
+
+namespace kengine::main_loop {
+	using execute_frame_signature = void(float delta_time, float alpha);
+	//! putils reflect all
+	//! parents: [refltype::base]
+	struct execute_frame : base_function<execute_frame_signature> {};
+}
+
+#include "execute_frame.rpp"
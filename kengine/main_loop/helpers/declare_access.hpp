@@ -0,0 +1,20 @@
+#pragma once
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// kengine
+#include "kengine/main_loop/data/access.hpp"
+
+namespace kengine::main_loop {
+	template<typename... Comps>
+	struct reads {};
+
+	template<typename... Comps>
+	struct writes {};
+
+	template<typename... Reads, typename... Writes>
+	access & declare_access(entt::handle e, reads<Reads...> = {}, writes<Writes...> = {}, bool main_thread = false) noexcept;
+}
+
+#include "declare_access.inl"
@@ -0,0 +1,30 @@
+#include "declare_access.hpp"
+
+// entt
+#include <entt/core/type_info.hpp>
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/helpers/register_storage.hpp"
+
+namespace kengine::main_loop {
+	template<typename... Reads, typename... Writes>
+	access & declare_access(entt::handle e, reads<Reads...>, writes<Writes...>, bool main_thread) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		auto & r = *e.registry();
+		kengine_logf(r, verbose, "main_loop", "Declaring component access for {}", e);
+
+		// Storage creation isn't thread-safe, so make sure systems running in parallel never need to create it
+		meta::register_storage<Reads..., Writes...>(r);
+
+		return e.emplace_or_replace<access>(access{
+			.reads = { entt::type_hash<Reads>::value()... },
+			.writes = { entt::type_hash<Writes>::value()... },
+			.main_thread = main_thread,
+		});
+	}
+}
@@ -1,20 +1,36 @@
 #include "run.hpp"
 
 // stl
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // entt
 #include <entt/entity/registry.hpp>
+#include <entt/signal/sigh.hpp>
 
 // meta
 #include "putils/meta/concepts/invocable.hpp"
 
 // kengine
+#include "kengine/core/assert/helpers/kengine_assert.hpp"
+#include "kengine/core/helpers/thread_pool.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_frame.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/main_loop/data/access.hpp"
+#include "kengine/main_loop/data/fixed_step_config.hpp"
 #include "kengine/main_loop/data/time_modulator.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 #include "kengine/main_loop/helpers/is_running.hpp"
 
 namespace kengine::main_loop {
@@ -38,8 +54,24 @@ namespace kengine::main_loop {
 		}
 	}
 
-	template<time_factor_callback F>
-	static void run(entt::registry & r, F && get_time_factor) noexcept {
+	// Called once per rendered frame, after the frame's simulation step(s)
+	static void run_execute_frame(const entt::registry & r, float delta_time, float alpha) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		kengine_logf(r, very_verbose, log_category, "Calling execute_frame (dt: {}, alpha: {})", delta_time, alpha);
+		for (const auto & [e, func] : r.view<execute_frame>().each()) {
+			if (!is_running(r))
+				break;
+			kengine_logf(r, very_verbose, log_category, "Calling execute_frame on {}", e);
+			func(delta_time, alpha);
+		}
+	}
+
+	template<typename T>
+	concept frame_callback = putils::invocable<T, void(float)>;
+
+	template<frame_callback F>
+	static void run_frames(entt::registry & r, F && run_one_frame) noexcept {
 		kengine_log(r, log, log_category, "Starting");
 
 		auto previous_time = std::chrono::system_clock::now();
@@ -48,7 +80,10 @@ namespace kengine::main_loop {
 			const float delta_time = std::chrono::duration<float>(now - previous_time).count();
 			previous_time = now;
 
-			run_frame(r, delta_time, get_time_factor);
+			run_one_frame(delta_time);
+			// Each frame runs a single, complete step, so there's nothing to interpolate
+			if (is_running(r))
+				run_execute_frame(r, delta_time, 1.f);
 
 			KENGINE_PROFILING_FRAME;
 		}
@@ -56,8 +91,19 @@ namespace kengine::main_loop {
 		kengine_log(r, log, log_category, "Stopping due to no more main_loop::keep_alive components remaining");
 	}
 
+	template<time_factor_callback F>
+	static void run(entt::registry & r, F && get_time_factor) noexcept {
+		run_frames(r, [&](float delta_time) noexcept {
+			run_frame(r, delta_time, get_time_factor);
+		});
+	}
+
+	static float no_time_factor(const entt::registry &) noexcept {
+		return 1.f;
+	}
+
 	void run(entt::registry & r) noexcept {
-		run(r, [](auto &&...) noexcept { return 1.f; });
+		run(r, no_time_factor);
 	}
 
 	namespace time_modulated {
@@ -79,4 +125,273 @@ namespace kengine::main_loop {
 			main_loop::run(r, get_time_factor);
 		}
 	}
+
+	namespace scheduled {
+		// Dependency graph between systems, rebuilt whenever an execute or access component is added, modified or removed
+		struct system_graph {
+			struct node {
+				entt::entity e = entt::null;
+				execute func;
+				bool main_thread = true;
+				std::vector<size_t> dependents;
+				size_t dependency_count = 0;
+			};
+
+			std::vector<node> nodes;
+			std::unique_ptr<std::atomic<size_t>[]> remaining_dependencies;
+			std::atomic<bool> dirty = true;
+
+			void mark_dirty(entt::registry &, entt::entity) noexcept {
+				dirty = true;
+			}
+		};
+
+		static bool contains_any(const std::vector<entt::id_type> & lhs, const std::vector<entt::id_type> & rhs) noexcept {
+			return std::ranges::any_of(lhs, [&](entt::id_type id) noexcept {
+				return std::ranges::find(rhs, id) != rhs.end();
+			});
+		}
+
+		static bool conflicts(const access * lhs, const access * rhs) noexcept {
+			// Systems which didn't declare their accesses may touch anything
+			if (!lhs || !rhs || lhs->exclusive || rhs->exclusive)
+				return true;
+
+			return contains_any(lhs->writes, rhs->reads) ||
+				contains_any(lhs->writes, rhs->writes) ||
+				contains_any(rhs->writes, lhs->reads);
+		}
+
+		static void build_graph(const entt::registry & r, system_graph & graph) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, verbose, log_category, "Building system graph");
+
+			std::vector<const access *> accesses;
+			graph.nodes.clear();
+			for (const auto & [e, func] : r.view<execute>().each()) {
+				const auto system_access = r.try_get<access>(e);
+				accesses.push_back(system_access);
+				graph.nodes.push_back({
+					.e = e,
+					.func = func,
+					.main_thread = !system_access || system_access->main_thread,
+				});
+			}
+
+			// Conflicting systems keep the order in which they would run in a sequential frame
+			for (size_t i = 0; i < graph.nodes.size(); ++i)
+				for (size_t j = i + 1; j < graph.nodes.size(); ++j)
+					if (conflicts(accesses[i], accesses[j])) {
+						kengine_logf(r, very_verbose, log_category, "{} must run before {}", graph.nodes[i].e, graph.nodes[j].e);
+						graph.nodes[i].dependents.push_back(j);
+						++graph.nodes[j].dependency_count;
+					}
+
+			graph.remaining_dependencies = std::make_unique<std::atomic<size_t>[]>(graph.nodes.size());
+			graph.dirty = false;
+		}
+
+		template<time_factor_callback F>
+		static void run_frame(const entt::registry & r, float delta_time, F && get_time_factor, system_graph & graph, thread_pool & pool) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			delta_time *= get_time_factor(r);
+
+			if (graph.dirty)
+				build_graph(r, graph);
+
+			kengine_logf(r, very_verbose, log_category, "Scheduling {} systems (dt: {})", graph.nodes.size(), delta_time);
+
+			if (graph.nodes.empty())
+				return;
+
+			for (size_t i = 0; i < graph.nodes.size(); ++i)
+				graph.remaining_dependencies[i] = graph.nodes[i].dependency_count;
+
+			std::atomic<size_t> nodes_left = graph.nodes.size();
+
+			// Only refreshed on the main thread after a main thread system ran, as reading keep_alive from workers would race with systems stopping the loop
+			std::atomic<bool> running = true;
+
+			// Systems which must run on the main thread are queued here instead of in the thread pool
+			std::mutex main_thread_mutex;
+			std::condition_variable main_thread_condition;
+			std::deque<size_t> main_thread_queue;
+
+			std::function<void(size_t)> schedule;
+
+			const auto run_node = [&](size_t index) noexcept {
+				const auto & node = graph.nodes[index];
+				// Once stopped, skip remaining systems but still release their dependents so the frame can complete
+				if (running) {
+					kengine_logf(r, very_verbose, log_category, "Calling execute on {}", node.e);
+					node.func(delta_time);
+					if (node.main_thread && !is_running(r))
+						running = false;
+				}
+
+				for (const auto dependent : node.dependents)
+					if (--graph.remaining_dependencies[dependent] == 0)
+						schedule(dependent);
+
+				// Decremented under the lock, so the main thread can't leave the frame while we're still notifying it
+				const std::lock_guard lock(main_thread_mutex);
+				if (--nodes_left == 0)
+					main_thread_condition.notify_one();
+			};
+
+			schedule = [&](size_t index) noexcept {
+				if (graph.nodes[index].main_thread) {
+					{
+						const std::lock_guard lock(main_thread_mutex);
+						main_thread_queue.push_back(index);
+					}
+					main_thread_condition.notify_one();
+				}
+				else
+					pool.push([&run_node, index] { run_node(index); }, thread_pool::priority::high);
+			};
+
+			for (size_t i = 0; i < graph.nodes.size(); ++i)
+				if (graph.nodes[i].dependency_count == 0)
+					schedule(i);
+
+			std::unique_lock lock(main_thread_mutex);
+			while (nodes_left > 0) {
+				if (!main_thread_queue.empty()) {
+					const auto index = main_thread_queue.front();
+					main_thread_queue.pop_front();
+					lock.unlock();
+					run_node(index);
+					lock.lock();
+					continue;
+				}
+
+				// Help the workers instead of idling, but leave lower priority async tasks to them as they may take longer than a frame
+				lock.unlock();
+				const bool ran_task = pool.run_pending_task(thread_pool::priority::high);
+				lock.lock();
+				if (ran_task)
+					continue;
+
+				main_thread_condition.wait(lock, [&] { return nodes_left == 0 || !main_thread_queue.empty(); });
+			}
+		}
+
+		template<time_factor_callback F>
+		static void run(entt::registry & r, F && get_time_factor) noexcept {
+			system_graph graph;
+
+			std::vector<entt::scoped_connection> connections;
+			connections.emplace_back(r.on_construct<execute>().connect<&system_graph::mark_dirty>(graph));
+			connections.emplace_back(r.on_update<execute>().connect<&system_graph::mark_dirty>(graph));
+			connections.emplace_back(r.on_destroy<execute>().connect<&system_graph::mark_dirty>(graph));
+			connections.emplace_back(r.on_construct<access>().connect<&system_graph::mark_dirty>(graph));
+			connections.emplace_back(r.on_update<access>().connect<&system_graph::mark_dirty>(graph));
+			connections.emplace_back(r.on_destroy<access>().connect<&system_graph::mark_dirty>(graph));
+
+			// Shared with async tasks, so both don't compete for the same cores
+			auto & pool = get_thread_pool();
+			kengine_logf(r, log, log_category, "Running scheduled systems on {} worker threads", pool.get_thread_count());
+
+			run_frames(r, [&](float delta_time) noexcept {
+				run_frame(r, delta_time, get_time_factor, graph, pool);
+			});
+		}
+
+		void run(entt::registry & r) noexcept {
+			run(r, no_time_factor);
+		}
+
+		namespace time_modulated {
+			void run(entt::registry & r) noexcept {
+				scheduled::run(r, main_loop::time_modulated::get_time_factor);
+			}
+		}
+	}
+
+	namespace fixed_step {
+		static fixed_step_config get_config(const entt::registry & r) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			fixed_step_config config;
+			for (const auto & [e, entity_config] : r.view<fixed_step_config>().each()) {
+				kengine_logf(r, very_verbose, log_category, "Found fixed step config in {}", e);
+				config = entity_config;
+				break;
+			}
+
+			if (config.steps_per_second <= 0.f) {
+				kengine_assert_failed(r, "fixed_step_config::steps_per_second must be positive (got {})", config.steps_per_second);
+				config.steps_per_second = fixed_step_config{}.steps_per_second;
+			}
+
+			return config;
+		}
+
+		static void wait_until(std::chrono::steady_clock::time_point deadline, float yield_duration) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto yield_time = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(yield_duration));
+			std::this_thread::sleep_until(deadline - yield_time);
+			while (std::chrono::steady_clock::now() < deadline)
+				std::this_thread::yield();
+		}
+
+		template<time_factor_callback F>
+		static void run(entt::registry & r, F && get_time_factor) noexcept {
+			kengine_log(r, log, log_category, "Starting with fixed step");
+
+			using clock = std::chrono::steady_clock;
+
+			auto previous_time = clock::now();
+			float accumulated_time = 0.f;
+
+			while (is_running(r)) {
+				const auto config = get_config(r);
+				const float step = 1.f / config.steps_per_second;
+
+				const auto frame_start = clock::now();
+				const float delta_time = std::chrono::duration<float>(frame_start - previous_time).count();
+				previous_time = frame_start;
+
+				accumulated_time += delta_time * get_time_factor(r);
+
+				unsigned int steps = 0;
+				while (accumulated_time >= step && steps < config.max_steps_per_frame && is_running(r)) {
+					main_loop::run_frame(r, step, no_time_factor);
+					accumulated_time -= step;
+					++steps;
+				}
+
+				// Avoid a "spiral of death" where catching up on a slow frame makes the next one even slower
+				if (accumulated_time >= step) {
+					const float dropped_time = accumulated_time - std::fmod(accumulated_time, step);
+					kengine_logf(r, verbose, log_category, "Dropping {}s of simulation time after {} steps", dropped_time, steps);
+					accumulated_time -= dropped_time;
+				}
+
+				run_execute_frame(r, delta_time, accumulated_time / step);
+
+				KENGINE_PROFILING_FRAME;
+
+				const float frame_duration = config.max_frames_per_second > 0.f ? 1.f / config.max_frames_per_second : step;
+				const auto next_frame = frame_start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(frame_duration));
+				if (is_running(r))
+					wait_until(next_frame, config.yield_duration);
+			}
+
+			kengine_log(r, log, log_category, "Stopping due to no more main_loop::keep_alive components remaining");
+		}
+
+		void run(entt::registry & r) noexcept {
+			run(r, no_time_factor);
+		}
+
+		namespace time_modulated {
+			void run(entt::registry & r) noexcept {
+				fixed_step::run(r, main_loop::time_modulated::get_time_factor);
+			}
+		}
+	}
 }
\ No newline at end of file
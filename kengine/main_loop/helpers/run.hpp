@@ -9,4 +9,20 @@ namespace kengine::main_loop {
 	namespace time_modulated {
 		KENGINE_MAIN_LOOP_EXPORT void run(entt::registry & r) noexcept;
 	}
+
+	namespace fixed_step {
+		KENGINE_MAIN_LOOP_EXPORT void run(entt::registry & r) noexcept;
+
+		namespace time_modulated {
+			KENGINE_MAIN_LOOP_EXPORT void run(entt::registry & r) noexcept;
+		}
+	}
+
+	namespace scheduled {
+		KENGINE_MAIN_LOOP_EXPORT void run(entt::registry & r) noexcept;
+
+		namespace time_modulated {
+			KENGINE_MAIN_LOOP_EXPORT void run(entt::registry & r) noexcept;
+		}
+	}
 }
\ No newline at end of file
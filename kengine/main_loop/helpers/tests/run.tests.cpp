@@ -1,12 +1,21 @@
+// stl
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 // entt
+#include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
 
 // gtest
 #include <gtest/gtest.h>
 
 // kengine
+#include "kengine/main_loop/data/fixed_step_config.hpp"
 #include "kengine/main_loop/data/keep_alive.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
+#include "kengine/main_loop/helpers/declare_access.hpp"
 #include "kengine/main_loop/helpers/stop_running.hpp"
 #include "kengine/main_loop/helpers/run.hpp"
 
@@ -28,6 +37,34 @@ TEST(main_loop, run) {
 	EXPECT_EQ(calls, 1);
 }
 
+TEST(main_loop, run_execute_frame) {
+	entt::registry r;
+
+	size_t steps = 0;
+	size_t frames = 0;
+
+	const auto e = r.create();
+	r.emplace<kengine::main_loop::keep_alive>(e);
+	r.emplace<kengine::main_loop::execute>(
+		e, [&](float delta_time) {
+			++steps;
+		}
+	);
+	r.emplace<kengine::main_loop::execute_frame>(
+		e, [&](float delta_time, float alpha) {
+			++frames;
+			EXPECT_EQ(frames, steps);
+			EXPECT_EQ(alpha, 1.f);
+			if (frames == 2)
+				kengine::main_loop::stop_running(r);
+		}
+	);
+
+	kengine::main_loop::run(r);
+	EXPECT_EQ(steps, 2);
+	EXPECT_EQ(frames, 2);
+}
+
 TEST(main_loop, time_modulated) {
 	entt::registry r;
 
@@ -45,4 +82,190 @@ TEST(main_loop, time_modulated) {
 
 	kengine::main_loop::time_modulated::run(r);
 	EXPECT_EQ(calls, 1);
-}
\ No newline at end of file
+}
+
+TEST(main_loop, fixed_step) {
+	entt::registry r;
+
+	size_t steps = 0;
+	size_t frames = 0;
+
+	const auto e = r.create();
+	r.emplace<kengine::main_loop::keep_alive>(e);
+	r.emplace<kengine::main_loop::fixed_step_config>(e, kengine::main_loop::fixed_step_config{ .steps_per_second = 100.f });
+	r.emplace<kengine::main_loop::execute>(
+		e, [&](float delta_time) {
+			++steps;
+			EXPECT_FLOAT_EQ(delta_time, .01f);
+			if (steps == 3)
+				kengine::main_loop::stop_running(r);
+		}
+	);
+	r.emplace<kengine::main_loop::execute_frame>(
+		e, [&](float delta_time, float alpha) {
+			++frames;
+			EXPECT_GE(alpha, 0.f);
+			EXPECT_LT(alpha, 1.f);
+		}
+	);
+
+	kengine::main_loop::fixed_step::run(r);
+	EXPECT_EQ(steps, 3);
+	EXPECT_GE(frames, 1);
+}
+
+TEST(main_loop, scheduled) {
+	entt::registry r;
+
+	std::atomic<size_t> calls = 0;
+
+	for (size_t i = 0; i < 4; ++i) {
+		const entt::handle e{ r, r.create() };
+		e.emplace<kengine::main_loop::execute>([&](float delta_time) {
+			++calls;
+		});
+		kengine::main_loop::declare_access(e, kengine::main_loop::reads<int>{});
+	}
+
+	// No access declared, so this runs after all other systems
+	const auto e = r.create();
+	r.emplace<kengine::main_loop::keep_alive>(e);
+	r.emplace<kengine::main_loop::execute>(
+		e, [&](float delta_time) {
+			EXPECT_EQ(calls, 4);
+			kengine::main_loop::stop_running(r);
+		}
+	);
+
+	kengine::main_loop::scheduled::run(r);
+	EXPECT_EQ(calls, 4);
+}
+
+TEST(main_loop, scheduled_conflicts_keep_order) {
+	entt::registry r;
+
+	std::vector<int> order;
+
+	const entt::handle writer{ r, r.create() };
+	writer.emplace<kengine::main_loop::execute>([&](float delta_time) {
+		order.push_back(0);
+	});
+	kengine::main_loop::declare_access(writer, kengine::main_loop::reads<>{}, kengine::main_loop::writes<int>{});
+
+	const entt::handle reader{ r, r.create() };
+	reader.emplace<kengine::main_loop::execute>([&](float delta_time) {
+		order.push_back(1);
+	});
+	kengine::main_loop::declare_access(reader, kengine::main_loop::reads<int>{});
+
+	const auto e = r.create();
+	r.emplace<kengine::main_loop::keep_alive>(e);
+	r.emplace<kengine::main_loop::execute>(
+		e, [&](float delta_time) {
+			order.push_back(2);
+			kengine::main_loop::stop_running(r);
+		}
+	);
+
+	kengine::main_loop::scheduled::run(r);
+	EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2 }));
+}
+
+TEST(main_loop, scheduled_main_thread) {
+	entt::registry r;
+
+	const auto main_thread_id = std::this_thread::get_id();
+	std::thread::id system_thread_id;
+
+	const entt::handle system{ r, r.create() };
+	system.emplace<kengine::main_loop::execute>([&](float delta_time) {
+		system_thread_id = std::this_thread::get_id();
+	});
+	kengine::main_loop::declare_access(system, kengine::main_loop::reads<int>{}, kengine::main_loop::writes<>{}, true);
+
+	const auto e = r.create();
+	r.emplace<kengine::main_loop::keep_alive>(e);
+	r.emplace<kengine::main_loop::execute>(
+		e, [&](float delta_time) {
+			kengine::main_loop::stop_running(r);
+		}
+	);
+
+	kengine::main_loop::scheduled::run(r);
+	EXPECT_EQ(system_thread_id, main_thread_id);
+}
+
+TEST(main_loop, scheduled_non_conflicting_overlap) {
+	entt::registry r;
+
+	std::atomic<size_t> arrived = 0;
+	std::atomic<size_t> overlapped = 0;
+
+	// Each system waits for the other one to start, which only happens if they run at the same time
+	const auto wait_for_other = [&](float delta_time) {
+		++arrived;
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (arrived < 2 && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::yield();
+		if (arrived >= 2)
+			++overlapped;
+	};
+
+	const entt::handle first{ r, r.create() };
+	first.emplace<kengine::main_loop::execute>(wait_for_other);
+	kengine::main_loop::declare_access(first, kengine::main_loop::reads<float>{}, kengine::main_loop::writes<int>{});
+
+	const entt::handle second{ r, r.create() };
+	second.emplace<kengine::main_loop::execute>(wait_for_other);
+	kengine::main_loop::declare_access(second, kengine::main_loop::reads<float>{}, kengine::main_loop::writes<double>{});
+
+	const auto e = r.create();
+	r.emplace<kengine::main_loop::keep_alive>(e);
+	r.emplace<kengine::main_loop::execute>(
+		e, [&](float delta_time) {
+			kengine::main_loop::stop_running(r);
+		}
+	);
+
+	kengine::main_loop::scheduled::run(r);
+	EXPECT_EQ(overlapped, 2);
+}
+
+TEST(main_loop, scheduled_exclusive) {
+	entt::registry r;
+
+	std::atomic<size_t> running_systems = 0;
+	std::atomic<bool> exclusive_overlapped = false;
+
+	const entt::handle exclusive{ r, r.create() };
+	exclusive.emplace<kengine::main_loop::execute>([&](float delta_time) {
+		if (++running_systems > 1)
+			exclusive_overlapped = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		if (running_systems > 1)
+			exclusive_overlapped = true;
+		--running_systems;
+	});
+	kengine::main_loop::declare_access(exclusive).exclusive = true;
+
+	for (size_t i = 0; i < 2; ++i) {
+		const entt::handle system{ r, r.create() };
+		system.emplace<kengine::main_loop::execute>([&](float delta_time) {
+			++running_systems;
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			--running_systems;
+		});
+		kengine::main_loop::declare_access(system, kengine::main_loop::reads<int>{});
+	}
+
+	const auto e = r.create();
+	r.emplace<kengine::main_loop::keep_alive>(e);
+	r.emplace<kengine::main_loop::execute>(
+		e, [&](float delta_time) {
+			kengine::main_loop::stop_running(r);
+		}
+	);
+
+	kengine::main_loop::scheduled::run(r);
+	EXPECT_FALSE(exclusive_overlapped);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+// stl
+#include <span>
+
+// kengine
+#include "kengine/base_function.hpp"
+#include "kengine/meta/binary/helpers/scene_reader.hpp"
+
+namespace kengine::meta::binary {
+	using load_column_signature = void(const scene_reader &, const column_header &, std::span<const entt::entity>, entt::registry &);
+	//! putils reflect all
+	//! parents: [refltype::base]
+	struct load_column : base_function<load_column_signature> {};
+}
+
+#include "load_column.rpp"
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+// stl
+#include <span>
+
+// kengine
+#include "kengine/base_function.hpp"
+#include "kengine/meta/binary/helpers/scene_writer.hpp"
+
+namespace kengine::meta::binary {
+	using save_column_signature = void(std::span<const entt::entity>, const entt::registry &, scene_writer &);
+	//! putils reflect all
+	//! parents: [refltype::base]
+	struct save_column : base_function<save_column_signature> {};
+}
+
+#include "save_column.rpp"
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace kengine::meta::binary {
+	template<typename T>
+	bool has_entity_attributes() noexcept;
+
+	template<typename T, typename Func>
+	void for_each_entity_attribute(T & comp, Func && func) noexcept;
+}
+
+#include "entity_attributes.inl"
\ No newline at end of file
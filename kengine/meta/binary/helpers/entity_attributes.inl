@@ -0,0 +1,37 @@
+#include "entity_attributes.hpp"
+
+// stl
+#include <type_traits>
+
+// entt
+#include <entt/entity/entity.hpp>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace kengine::meta::binary {
+	template<typename T>
+	bool has_entity_attributes() noexcept {
+		static const bool ret = [] {
+			bool found = false;
+			if constexpr (putils::reflection::has_attributes<T>())
+				putils::reflection::for_each_attribute<T>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (std::is_same_v<member, entt::entity>)
+						found = true;
+				});
+			return found;
+		}();
+		return ret;
+	}
+
+	template<typename T, typename Func>
+	void for_each_entity_attribute(T & comp, Func && func) noexcept {
+		if constexpr (putils::reflection::has_attributes<T>())
+			putils::reflection::for_each_attribute<T>([&](const auto & attr) noexcept {
+				using member = putils::member_type<putils_typeof(attr.ptr)>;
+				if constexpr (std::is_same_v<member, entt::entity>)
+					func(comp.*(attr.ptr));
+			});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+// stl
+#include <cstdint>
+
+namespace kengine::meta::binary {
+	template<typename T>
+	std::uint64_t get_schema_hash() noexcept;
+}
+
+#include "get_schema_hash.inl"
\ No newline at end of file
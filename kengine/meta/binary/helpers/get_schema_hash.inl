@@ -0,0 +1,46 @@
+#include "get_schema_hash.hpp"
+
+// stl
+#include <string_view>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace kengine::meta::binary {
+	namespace impl {
+		// FNV-1a
+		inline std::uint64_t hash_bytes(std::uint64_t hash, const void * data, std::size_t size) noexcept {
+			const auto bytes = static_cast<const unsigned char *>(data);
+			for (std::size_t i = 0; i < size; ++i) {
+				hash ^= bytes[i];
+				hash *= 0x100000001b3;
+			}
+			return hash;
+		}
+
+		inline std::uint64_t hash_string(std::uint64_t hash, std::string_view str) noexcept {
+			return hash_bytes(hash, str.data(), str.size());
+		}
+
+		inline std::uint64_t hash_value(std::uint64_t hash, std::uint64_t value) noexcept {
+			return hash_bytes(hash, &value, sizeof(value));
+		}
+	}
+
+	template<typename T>
+	std::uint64_t get_schema_hash() noexcept {
+		std::uint64_t hash = 0xcbf29ce484222325;
+		hash = impl::hash_string(hash, putils::reflection::get_class_name<T>());
+		hash = impl::hash_value(hash, sizeof(T));
+
+		if constexpr (putils::reflection::has_attributes<T>())
+			putils::reflection::for_each_attribute<T>([&](const auto & attr) noexcept {
+				using member = putils::member_type<putils_typeof(attr.ptr)>;
+				hash = impl::hash_string(hash, attr.name);
+				hash = impl::hash_value(hash, (std::uint64_t)putils::member_offset(attr.ptr));
+				hash = impl::hash_value(hash, sizeof(member));
+			});
+
+		return hash;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+// stl
+#include <type_traits>
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// kengine
+#include "kengine/meta/binary/functions/load_column.hpp"
+#include "kengine/meta/helpers/impl/meta_component_implementation.hpp"
+
+namespace kengine::meta {
+	template<typename T>
+	struct meta_component_implementation<binary::load_column, T> {
+		static constexpr bool value = std::is_move_assignable_v<T>;
+		static void function(const binary::scene_reader & reader, const binary::column_header & column, std::span<const entt::entity> entities, entt::registry & r) noexcept;
+	};
+}
+
+#include "load_column.inl"
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "load_column.hpp"
+
+// stl
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <vector>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// nlohmann
+#include <nlohmann/json.hpp>
+
+// putils
+#include "putils/range.hpp"
+#include "putils/reflection_helpers/json_helper.hpp"
+#include "putils/thread_name.hpp"
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/binary/helpers/entity_attributes.hpp"
+#include "kengine/meta/binary/helpers/get_schema_hash.hpp"
+#include "kengine/meta/binary/helpers/is_read_in_place.hpp"
+
+namespace kengine::meta {
+	template<typename T>
+	void meta_component_implementation<binary::load_column, T>::function(const binary::scene_reader & reader, const binary::column_header & column, std::span<const entt::entity> entities, entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, very_verbose, "meta::binary::load_column", "Loading {} for {} entities", putils::reflection::get_class_name<T>(), column.element_count);
+
+		if (column.schema_hash != binary::get_schema_hash<T>()) {
+			kengine_logf(r, warning, "meta::binary::load_column", "Schema mismatch for {}, the scene was saved with a different version of the component", putils::reflection::get_class_name<T>());
+			return;
+		}
+
+		const auto entity_indices = reader.get_entity_indices(column);
+		std::vector<entt::entity> targets(entity_indices.size());
+		std::transform(putils_range(entity_indices), targets.begin(), [&](std::uint32_t index) noexcept { return entities[index]; });
+
+		const auto data = reader.get_data(column);
+
+		if constexpr (std::is_empty<T>()) {
+			r.insert<T>(putils_range(targets));
+		}
+		else if constexpr (binary::is_read_in_place<T>) {
+			if (column.kind != binary::column_kind::trivially_copyable || column.element_size != sizeof(T)) {
+				kengine_logf(r, warning, "meta::binary::load_column", "Unexpected column layout for {}", putils::reflection::get_class_name<T>());
+				return;
+			}
+
+			// Components are copied straight from the scene data, without any parsing
+			const auto components = reinterpret_cast<const T *>(data.data());
+			r.insert<T>(putils_range(targets), components);
+
+			// Entity attributes hold indices in the scene, see save_column
+			if (binary::has_entity_attributes<T>()) {
+				auto & storage = r.storage<T>();
+				for (const auto e : targets)
+					binary::for_each_entity_attribute(storage.get(e), [&](entt::entity & attribute) noexcept {
+						if (attribute == entt::null)
+							return;
+
+						const auto index = std::size_t(entt::to_integral(attribute));
+						attribute = index < entities.size() ? entities[index] : entt::null;
+					});
+			}
+		}
+		else {
+			const auto offsets_size = (std::size_t(column.element_count) + 1) * sizeof(std::uint64_t);
+			if (column.kind != binary::column_kind::encoded || data.size() < offsets_size) {
+				kengine_logf(r, warning, "meta::binary::load_column", "Unexpected column layout for {}", putils::reflection::get_class_name<T>());
+				return;
+			}
+
+			const auto offsets = reinterpret_cast<const std::uint64_t *>(data.data());
+			const auto blobs = reinterpret_cast<const std::uint8_t *>(data.data() + offsets_size);
+			const auto blobs_size = data.size() - offsets_size;
+
+			// Decoding doesn't touch the registry, so it's done in parallel (but not vectorized, as it allocates)
+			std::vector<T> components(column.element_count);
+			std::for_each(std::execution::par, putils_range(components), [&](T & comp) noexcept {
+				const putils::scoped_thread_name thread_name("Binary scene loader");
+				const auto index = &comp - components.data();
+				const auto begin = offsets[index];
+				const auto end = offsets[index + 1];
+				if (begin > end || end > blobs_size)
+					return;
+
+				const auto json = nlohmann::json::from_msgpack(blobs + begin, blobs + end, true, false);
+				if (!json.is_discarded())
+					putils::reflection::from_json(json, comp);
+			});
+
+			// Components are attached from the calling thread, so that storages and signals are never used concurrently
+			r.insert<T>(putils_range(targets), std::make_move_iterator(components.begin()));
+		}
+	}
+}
\ No newline at end of file
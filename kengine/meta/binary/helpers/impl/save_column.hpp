@@ -0,0 +1,20 @@
+#pragma once
+
+// stl
+#include <type_traits>
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// kengine
+#include "kengine/meta/binary/functions/save_column.hpp"
+#include "kengine/meta/helpers/impl/meta_component_implementation.hpp"
+
+namespace kengine::meta {
+	template<typename T>
+	struct meta_component_implementation<binary::save_column, T> : std::true_type {
+		static void function(std::span<const entt::entity> entities, const entt::registry & r, binary::scene_writer & writer) noexcept;
+	};
+}
+
+#include "save_column.inl"
\ No newline at end of file
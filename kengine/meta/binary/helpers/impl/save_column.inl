@@ -0,0 +1,100 @@
+#include "save_column.hpp"
+
+// stl
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// nlohmann
+#include <nlohmann/json.hpp>
+
+// putils
+#include "putils/reflection_helpers/json_helper.hpp"
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/binary/helpers/entity_attributes.hpp"
+#include "kengine/meta/binary/helpers/get_schema_hash.hpp"
+#include "kengine/meta/binary/helpers/is_read_in_place.hpp"
+
+namespace kengine::meta {
+	template<typename T>
+	void meta_component_implementation<binary::save_column, T>::function(std::span<const entt::entity> entities, const entt::registry & r, binary::scene_writer & writer) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, very_verbose, "meta::binary::save_column", "Saving {} for {} entities", putils::reflection::get_class_name<T>(), entities.size());
+
+		std::vector<std::uint32_t> entity_indices;
+		for (std::uint32_t i = 0; i < entities.size(); ++i)
+			if (r.all_of<T>(entities[i]))
+				entity_indices.push_back(i);
+
+		if (entity_indices.empty()) {
+			kengine_log(r, very_verbose, "meta::binary::save_column", "No entities with component");
+			return;
+		}
+
+		std::vector<std::byte> data;
+		binary::column_kind kind;
+		std::uint32_t element_size = 0;
+
+		if constexpr (std::is_empty<T>())
+			kind = binary::column_kind::empty;
+		else if constexpr (binary::is_read_in_place<T>) {
+			kind = binary::column_kind::trivially_copyable;
+			element_size = sizeof(T);
+			data.resize(entity_indices.size() * sizeof(T));
+
+			if (!binary::has_entity_attributes<T>()) {
+				for (size_t i = 0; i < entity_indices.size(); ++i)
+					std::memcpy(data.data() + i * sizeof(T), &r.get<T>(entities[entity_indices[i]]), sizeof(T));
+			}
+			else {
+				// Entity identifiers mean nothing to the loading registry, so they're stored as indices in the scene
+				std::unordered_map<entt::entity, std::uint32_t> scene_indices;
+				for (std::uint32_t i = 0; i < entities.size(); ++i)
+					scene_indices.emplace(entities[i], i);
+
+				for (size_t i = 0; i < entity_indices.size(); ++i) {
+					auto comp = r.get<T>(entities[entity_indices[i]]);
+					binary::for_each_entity_attribute(comp, [&](entt::entity & e) noexcept {
+						if (e == entt::null)
+							return;
+
+						const auto it = scene_indices.find(e);
+						if (it == scene_indices.end()) {
+							kengine_logf(r, verbose, "meta::binary::save_column", "{} references {}, which isn't part of the scene", putils::reflection::get_class_name<T>(), e);
+							e = entt::null;
+						}
+						else
+							e = entt::entity(it->second);
+					});
+					std::memcpy(data.data() + i * sizeof(T), &comp, sizeof(T));
+				}
+			}
+		}
+		else {
+			kind = binary::column_kind::encoded;
+
+			std::vector<std::uint64_t> offsets;
+			offsets.reserve(entity_indices.size() + 1);
+			std::vector<std::uint8_t> blobs;
+			for (const auto index : entity_indices) {
+				offsets.push_back(blobs.size());
+				nlohmann::json::to_msgpack(putils::reflection::to_json(r.get<T>(entities[index])), blobs);
+			}
+			offsets.push_back(blobs.size());
+
+			const auto offsets_size = offsets.size() * sizeof(std::uint64_t);
+			data.resize(offsets_size + blobs.size());
+			std::memcpy(data.data(), offsets.data(), offsets_size);
+			if (!blobs.empty())
+				std::memcpy(data.data() + offsets_size, blobs.data(), blobs.size());
+		}
+
+		writer.add_column(putils::reflection::get_class_name<T>(), kind, binary::get_schema_hash<T>(), element_size, std::move(entity_indices), std::move(data));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+// stl
+#include <type_traits>
+
+// kengine
+#include "kengine/meta/binary/helpers/scene_format.hpp"
+
+namespace kengine::meta::binary {
+	template<typename T>
+	static constexpr bool is_read_in_place = !std::is_empty_v<T> && std::is_trivially_copyable_v<T> && alignof(T) <= scene_alignment;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "load_scene.hpp"
+
+// stl
+#include <string>
+#include <unordered_map>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/data/name.hpp"
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/binary/functions/load_column.hpp"
+#include "kengine/meta/binary/helpers/scene_reader.hpp"
+
+namespace kengine::meta::binary {
+	static constexpr auto log_category = "meta_binary";
+
+	std::vector<entt::entity> load_scene(std::span<const std::byte> data, entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const scene_reader reader(data);
+		if (!reader.is_valid()) {
+			kengine_log(r, error, log_category, "Invalid binary scene");
+			return {};
+		}
+
+		kengine_logf(r, verbose, log_category, "Loading {} entities from binary", reader.get_entity_count());
+
+		std::vector<entt::entity> entities(reader.get_entity_count());
+		r.create(entities.begin(), entities.end());
+
+		// Names are copied, as loading a column may reallocate the storage they live in
+		std::unordered_map<std::string, entt::entity> type_entities;
+		for (const auto & [type_entity, name, loader] : r.view<const core::name, const load_column>().each())
+			type_entities.emplace(name.name.c_str(), type_entity);
+
+		// Component types are processed one after the other, so that the registry's storages and signals are only ever used from this thread
+		for (const auto & column : reader.get_columns()) {
+			const auto type_name = reader.get_string(column.type_name);
+			const auto it = type_entities.find(std::string(type_name));
+			if (it == type_entities.end()) {
+				kengine_logf(r, warning, log_category, "No load_column found for '{}'", type_name);
+				continue;
+			}
+			const auto & loader = r.get<load_column>(it->second);
+			loader(reader, column, entities, r);
+		}
+
+		return entities;
+	}
+}
\ No newline at end of file
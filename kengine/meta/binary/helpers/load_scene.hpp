@@ -0,0 +1,13 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+namespace kengine::meta::binary {
+	KENGINE_META_BINARY_EXPORT std::vector<entt::entity> load_scene(std::span<const std::byte> data, entt::registry & r) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::meta::binary {
+#ifdef _WIN32
+	mapped_file::mapped_file(const char * path) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) {
+			file_handle = nullptr;
+			return;
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file_handle, &file_size))
+			return;
+
+		size = std::size_t(file_size.QuadPart);
+		if (size == 0) {
+			// Empty files can't be mapped
+			open = true;
+			return;
+		}
+
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping_handle)
+			return;
+
+		data = static_cast<const std::byte *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		open = data != nullptr;
+	}
+
+	mapped_file::~mapped_file() noexcept {
+		if (data)
+			UnmapViewOfFile(data);
+		if (mapping_handle)
+			CloseHandle(mapping_handle);
+		if (file_handle)
+			CloseHandle(file_handle);
+	}
+#else
+	mapped_file::mapped_file(const char * path) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto fd = ::open(path, O_RDONLY);
+		if (fd < 0)
+			return;
+
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) == 0) {
+			size = std::size_t(file_stat.st_size);
+			if (size == 0)
+				// Empty files can't be mapped
+				open = true;
+			else {
+				const auto address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (address != MAP_FAILED) {
+					data = static_cast<const std::byte *>(address);
+					open = true;
+				}
+			}
+		}
+
+		// The mapping remains valid after the descriptor is closed
+		::close(fd);
+	}
+
+	mapped_file::~mapped_file() noexcept {
+		if (data)
+			munmap(const_cast<std::byte *>(data), size);
+	}
+#endif
+
+	bool mapped_file::is_open() const noexcept {
+		return open;
+	}
+
+	std::span<const std::byte> mapped_file::get_data() const noexcept {
+		return { data, open ? size : 0 };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <span>
+
+namespace kengine::meta::binary {
+	// Read-only memory mapping of a file
+	struct KENGINE_META_BINARY_EXPORT mapped_file {
+		mapped_file(const char * path) noexcept;
+		~mapped_file() noexcept;
+
+		mapped_file(const mapped_file &) = delete;
+		mapped_file & operator=(const mapped_file &) = delete;
+
+		bool is_open() const noexcept;
+		std::span<const std::byte> get_data() const noexcept;
+
+		const std::byte * data = nullptr;
+		std::size_t size = 0;
+		bool open = false;
+
+#ifdef _WIN32
+		void * file_handle = nullptr;
+		void * mapping_handle = nullptr;
+#endif
+	};
+}
\ No newline at end of file
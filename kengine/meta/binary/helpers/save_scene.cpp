@@ -0,0 +1,25 @@
+#include "save_scene.hpp"
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/binary/functions/save_column.hpp"
+#include "kengine/meta/binary/helpers/scene_writer.hpp"
+
+namespace kengine::meta::binary {
+	static constexpr auto log_category = "meta_binary";
+
+	std::vector<std::byte> save_scene(std::span<const entt::entity> entities, const entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, verbose, log_category, "Saving {} entities to binary", entities.size());
+
+		scene_writer writer(std::uint32_t(entities.size()));
+		for (const auto & [type_entity, save] : r.view<const save_column>().each())
+			save(entities, r, writer);
+
+		return writer.finish();
+	}
+}
\ No newline at end of file
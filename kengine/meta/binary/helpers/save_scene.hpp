@@ -0,0 +1,13 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+namespace kengine::meta::binary {
+	KENGINE_META_BINARY_EXPORT std::vector<std::byte> save_scene(std::span<const entt::entity> entities, const entt::registry & r) noexcept;
+}
\ No newline at end of file
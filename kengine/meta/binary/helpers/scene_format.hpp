@@ -0,0 +1,55 @@
+#pragma once
+
+// stl
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace kengine::meta::binary {
+	static constexpr std::array<char, 4> scene_magic = { 'K', 'B', 'S', 'C' };
+	static constexpr std::uint32_t scene_version = 2;
+
+	// Every block starts at a multiple of this, so that components can be read in place from a mapped file
+	static constexpr std::size_t scene_alignment = 16;
+
+	struct scene_header {
+		std::array<char, 4> magic = scene_magic;
+		std::uint32_t version = scene_version;
+		std::uint32_t entity_count = 0;
+		std::uint32_t column_count = 0;
+		std::uint32_t string_count = 0;
+		std::uint64_t columns_offset = 0; // column_count column_header
+		std::uint64_t string_table_offset = 0; // string_count string_entry
+	};
+
+	struct string_entry {
+		std::uint64_t offset = 0; // From the start of the file
+		std::uint64_t size = 0;
+	};
+
+	enum class column_kind : std::uint32_t {
+		empty, // Only entity indices
+		trivially_copyable, // Entity indices, then an array of components which can be read in place
+		encoded, // Entity indices, then element_count + 1 offsets (relative to the end of the offset table) delimiting MessagePack blobs
+	};
+
+	struct column_header {
+		std::uint32_t type_name = 0; // Index in the string table
+		column_kind kind = column_kind::empty;
+		std::uint64_t schema_hash = 0; // See get_schema_hash
+		std::uint32_t element_size = 0;
+		std::uint32_t element_count = 0;
+		std::uint64_t entities_offset = 0; // element_count std::uint32_t, indices of the entities in the scene
+		std::uint64_t data_offset = 0;
+		std::uint64_t data_size = 0;
+	};
+
+	// Read in place from mapped memory, so their layout is part of the format
+	static_assert(sizeof(scene_header) == 40);
+	static_assert(sizeof(string_entry) == 16);
+	static_assert(sizeof(column_header) == 48);
+
+	constexpr std::uint64_t align_scene_offset(std::uint64_t offset) noexcept {
+		return (offset + scene_alignment - 1) & ~std::uint64_t(scene_alignment - 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "scene_reader.hpp"
+
+// stl
+#include <algorithm>
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::meta::binary {
+	scene_reader::scene_reader(std::span<const std::byte> data) noexcept
+		: data(data) {
+		KENGINE_PROFILING_SCOPE;
+
+		// Blocks are read in place, which requires them to be aligned
+		if (data.size() < sizeof(scene_header) || reinterpret_cast<std::uintptr_t>(data.data()) % scene_alignment != 0)
+			return;
+
+		header = reinterpret_cast<const scene_header *>(data.data());
+		valid = validate();
+	}
+
+	bool scene_reader::is_valid() const noexcept {
+		return valid;
+	}
+
+	std::uint32_t scene_reader::get_entity_count() const noexcept {
+		return valid ? header->entity_count : 0;
+	}
+
+	std::span<const column_header> scene_reader::get_columns() const noexcept {
+		if (!valid)
+			return {};
+		return { reinterpret_cast<const column_header *>(data.data() + header->columns_offset), header->column_count };
+	}
+
+	std::string_view scene_reader::get_string(std::uint32_t index) const noexcept {
+		if (!valid || index >= header->string_count)
+			return {};
+		const auto & entry = reinterpret_cast<const string_entry *>(data.data() + header->string_table_offset)[index];
+		return { reinterpret_cast<const char *>(data.data() + entry.offset), entry.size };
+	}
+
+	std::span<const std::uint32_t> scene_reader::get_entity_indices(const column_header & column) const noexcept {
+		return { reinterpret_cast<const std::uint32_t *>(data.data() + column.entities_offset), column.element_count };
+	}
+
+	std::span<const std::byte> scene_reader::get_data(const column_header & column) const noexcept {
+		return data.subspan(column.data_offset, column.data_size);
+	}
+
+	bool scene_reader::validate() const noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (header->magic != scene_magic || header->version != scene_version)
+			return false;
+
+		const auto is_block_valid = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t element_size) noexcept {
+			if (offset % scene_alignment != 0 || offset > data.size())
+				return false;
+			return element_size == 0 || count <= (data.size() - offset) / element_size;
+		};
+
+		if (!is_block_valid(header->columns_offset, header->column_count, sizeof(column_header)))
+			return false;
+		if (!is_block_valid(header->string_table_offset, header->string_count, sizeof(string_entry)))
+			return false;
+
+		const auto strings = reinterpret_cast<const string_entry *>(data.data() + header->string_table_offset);
+		for (std::uint32_t i = 0; i < header->string_count; ++i)
+			if (strings[i].offset > data.size() || strings[i].size > data.size() - strings[i].offset)
+				return false;
+
+		const auto columns = reinterpret_cast<const column_header *>(data.data() + header->columns_offset);
+		for (std::uint32_t i = 0; i < header->column_count; ++i) {
+			const auto & column = columns[i];
+			if (column.type_name >= header->string_count)
+				return false;
+			if (!is_block_valid(column.entities_offset, column.element_count, sizeof(std::uint32_t)))
+				return false;
+			if (!is_block_valid(column.data_offset, column.data_size, 1))
+				return false;
+
+			if (column.kind == column_kind::trivially_copyable && column.data_size != std::uint64_t(column.element_size) * column.element_count)
+				return false;
+
+			const auto indices = reinterpret_cast<const std::uint32_t *>(data.data() + column.entities_offset);
+			if (std::any_of(indices, indices + column.element_count, [&](std::uint32_t index) noexcept { return index >= header->entity_count; }))
+				return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
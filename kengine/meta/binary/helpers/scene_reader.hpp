@@ -0,0 +1,31 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// kengine
+#include "kengine/meta/binary/helpers/scene_format.hpp"
+
+namespace kengine::meta::binary {
+	// Reads a scene in place, without copying it. `data` must outlive the reader
+	struct KENGINE_META_BINARY_EXPORT scene_reader {
+		scene_reader(std::span<const std::byte> data) noexcept;
+
+		bool is_valid() const noexcept;
+
+		std::uint32_t get_entity_count() const noexcept;
+		std::span<const column_header> get_columns() const noexcept;
+		std::string_view get_string(std::uint32_t index) const noexcept;
+		std::span<const std::uint32_t> get_entity_indices(const column_header & column) const noexcept;
+		std::span<const std::byte> get_data(const column_header & column) const noexcept;
+
+		bool validate() const noexcept;
+
+		std::span<const std::byte> data;
+		const scene_header * header = nullptr;
+		bool valid = false;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "scene_writer.hpp"
+
+// stl
+#include <cstring>
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::meta::binary {
+	scene_writer::scene_writer(std::uint32_t entity_count) noexcept
+		: entity_count(entity_count) {
+	}
+
+	std::uint32_t scene_writer::add_string(std::string_view str) noexcept {
+		const auto [it, inserted] = string_indices.emplace(str, std::uint32_t(strings.size()));
+		if (inserted)
+			strings.emplace_back(str);
+		return it->second;
+	}
+
+	void scene_writer::add_column(std::string_view type_name, column_kind kind, std::uint64_t schema_hash, std::uint32_t element_size, std::vector<std::uint32_t> && entity_indices, std::vector<std::byte> && data) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		column_header header;
+		header.type_name = add_string(type_name);
+		header.kind = kind;
+		header.schema_hash = schema_hash;
+		header.element_size = element_size;
+		header.element_count = std::uint32_t(entity_indices.size());
+		columns.push_back({ header, std::move(entity_indices), std::move(data) });
+	}
+
+	std::vector<std::byte> scene_writer::finish() const noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		// Compute the offset of each block
+		scene_header header;
+		header.entity_count = entity_count;
+		header.column_count = std::uint32_t(columns.size());
+		header.string_count = std::uint32_t(strings.size());
+
+		std::uint64_t size = sizeof(scene_header);
+		header.columns_offset = align_scene_offset(size);
+		size = header.columns_offset + columns.size() * sizeof(column_header);
+		header.string_table_offset = align_scene_offset(size);
+		size = header.string_table_offset + strings.size() * sizeof(string_entry);
+
+		std::vector<string_entry> string_entries(strings.size());
+		for (size_t i = 0; i < strings.size(); ++i) {
+			string_entries[i] = { size, strings[i].size() };
+			size += strings[i].size();
+		}
+
+		std::vector<column_header> column_headers(columns.size());
+		for (size_t i = 0; i < columns.size(); ++i) {
+			auto & column = column_headers[i];
+			column = columns[i].header;
+			column.entities_offset = align_scene_offset(size);
+			size = column.entities_offset + columns[i].entity_indices.size() * sizeof(std::uint32_t);
+			column.data_offset = align_scene_offset(size);
+			column.data_size = columns[i].data.size();
+			size = column.data_offset + column.data_size;
+		}
+
+		// Fill the buffer
+		std::vector<std::byte> ret(size);
+		const auto write = [&](std::uint64_t offset, const void * data, std::size_t data_size) noexcept {
+			if (data_size > 0)
+				std::memcpy(ret.data() + offset, data, data_size);
+		};
+
+		write(0, &header, sizeof(header));
+		write(header.columns_offset, column_headers.data(), column_headers.size() * sizeof(column_header));
+		write(header.string_table_offset, string_entries.data(), string_entries.size() * sizeof(string_entry));
+		for (size_t i = 0; i < strings.size(); ++i)
+			write(string_entries[i].offset, strings[i].data(), strings[i].size());
+
+		for (size_t i = 0; i < columns.size(); ++i) {
+			const auto & column = columns[i];
+			write(column_headers[i].entities_offset, column.entity_indices.data(), column.entity_indices.size() * sizeof(std::uint32_t));
+			write(column_headers[i].data_offset, column.data.data(), column.data.size());
+		}
+
+		return ret;
+	}
+}
\ No newline at end of file
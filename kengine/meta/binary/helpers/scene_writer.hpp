@@ -0,0 +1,35 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// kengine
+#include "kengine/meta/binary/helpers/scene_format.hpp"
+
+namespace kengine::meta::binary {
+	struct KENGINE_META_BINARY_EXPORT scene_writer {
+		scene_writer(std::uint32_t entity_count) noexcept;
+
+		std::uint32_t add_string(std::string_view str) noexcept;
+		void add_column(std::string_view type_name, column_kind kind, std::uint64_t schema_hash, std::uint32_t element_size, std::vector<std::uint32_t> && entity_indices, std::vector<std::byte> && data) noexcept;
+
+		std::vector<std::byte> finish() const noexcept;
+
+		struct column {
+			column_header header;
+			std::vector<std::uint32_t> entity_indices;
+			std::vector<std::byte> data;
+		};
+
+		std::uint32_t entity_count;
+		std::vector<column> columns;
+		std::vector<std::string> strings;
+		std::unordered_map<std::string, std::uint32_t> string_indices;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+// stl
+#include <string>
+#include <vector>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/data/name.hpp"
+#include "kengine/core/data/transform.hpp"
+#include "kengine/meta/helpers/register_metadata.hpp"
+#include "kengine/meta/helpers/register_meta_component_implementation.hpp"
+#include "kengine/meta/binary/helpers/impl/load_column.hpp"
+#include "kengine/meta/binary/helpers/impl/save_column.hpp"
+#include "kengine/meta/binary/helpers/is_read_in_place.hpp"
+#include "kengine/meta/binary/helpers/load_scene.hpp"
+#include "kengine/meta/binary/helpers/save_scene.hpp"
+#include "kengine/model/data/instance.hpp"
+
+namespace {
+	struct tag {};
+
+	struct description {
+		std::string text;
+	};
+}
+
+#define refltype tag
+putils_reflection_info {
+	putils_reflection_class_name;
+};
+#undef refltype
+
+#define refltype description
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes(
+		putils_reflection_attribute(text)
+	);
+};
+#undef refltype
+
+template<typename... Comps>
+static void register_types(entt::registry & r) noexcept {
+	kengine::meta::register_metadata<Comps...>(r);
+	kengine::meta::register_meta_component_implementation<kengine::meta::binary::save_column, Comps...>(r);
+	kengine::meta::register_meta_component_implementation<kengine::meta::binary::load_column, Comps...>(r);
+}
+
+TEST(meta_binary, load_scene) {
+	static_assert(kengine::meta::binary::is_read_in_place<kengine::core::transform>);
+	static_assert(!kengine::meta::binary::is_read_in_place<description>);
+
+	entt::registry source;
+	register_types<kengine::core::name, kengine::core::transform, tag, description>(source);
+
+	std::vector<entt::entity> entities(100);
+	source.create(entities.begin(), entities.end());
+	for (size_t i = 0; i < entities.size(); ++i) {
+		const auto e = entities[i];
+		source.emplace<kengine::core::name>(e, "entity");
+		if (i % 2 == 0)
+			source.emplace<kengine::core::transform>(e).bounding_box.position.x = float(i);
+		if (i % 3 == 0)
+			source.emplace<tag>(e);
+		if (i % 5 == 0)
+			source.emplace<description>(e, std::to_string(i));
+	}
+
+	const auto data = kengine::meta::binary::save_scene(entities, source);
+
+	entt::registry r;
+	register_types<kengine::core::name, kengine::core::transform, tag, description>(r);
+	const auto loaded = kengine::meta::binary::load_scene(data, r);
+	ASSERT_EQ(loaded.size(), entities.size());
+
+	for (size_t i = 0; i < loaded.size(); ++i) {
+		const auto e = loaded[i];
+		EXPECT_EQ(r.get<kengine::core::name>(e).name, "entity");
+
+		EXPECT_EQ(r.all_of<kengine::core::transform>(e), i % 2 == 0);
+		if (i % 2 == 0)
+			EXPECT_EQ(r.get<kengine::core::transform>(e).bounding_box.position.x, float(i));
+
+		EXPECT_EQ(r.all_of<tag>(e), i % 3 == 0);
+
+		EXPECT_EQ(r.all_of<description>(e), i % 5 == 0);
+		if (i % 5 == 0)
+			EXPECT_EQ(r.get<description>(e).text, std::to_string(i));
+	}
+}
+
+TEST(meta_binary, load_scene_remaps_entities) {
+	static_assert(kengine::meta::binary::is_read_in_place<kengine::model::instance>);
+
+	entt::registry source;
+	register_types<kengine::model::instance>(source);
+
+	// Entities that aren't saved, so that saved identifiers don't match the scene indices
+	for (int i = 0; i < 10; ++i)
+		(void)source.create();
+
+	const auto outside = source.create();
+	std::vector<entt::entity> entities(3);
+	source.create(entities.begin(), entities.end());
+	const auto model = entities[0];
+	source.emplace<kengine::model::instance>(entities[1], model);
+	source.emplace<kengine::model::instance>(entities[2], outside);
+
+	const auto data = kengine::meta::binary::save_scene(entities, source);
+
+	entt::registry r;
+	register_types<kengine::model::instance>(r);
+	for (int i = 0; i < 5; ++i)
+		(void)r.create();
+
+	const auto loaded = kengine::meta::binary::load_scene(data, r);
+	ASSERT_EQ(loaded.size(), entities.size());
+	EXPECT_EQ(r.get<kengine::model::instance>(loaded[1]).model, loaded[0]);
+	// Entities that weren't saved can't be referenced
+	EXPECT_EQ(r.get<kengine::model::instance>(loaded[2]).model, entt::entity(entt::null));
+}
+
+TEST(meta_binary, load_scene_skips_unknown_types) {
+	entt::registry source;
+	register_types<kengine::core::name, tag>(source);
+
+	const auto e = source.create();
+	source.emplace<kengine::core::name>(e, "entity");
+	source.emplace<tag>(e);
+	const auto data = kengine::meta::binary::save_scene({ &e, 1 }, source);
+
+	entt::registry r;
+	register_types<kengine::core::name>(r);
+	const auto loaded = kengine::meta::binary::load_scene(data, r);
+	ASSERT_EQ(loaded.size(), 1);
+	EXPECT_EQ(r.get<kengine::core::name>(loaded[0]).name, "entity");
+	EXPECT_FALSE(r.all_of<tag>(loaded[0]));
+}
+
+TEST(meta_binary, load_scene_invalid) {
+	entt::registry r;
+	const std::vector<std::byte> data(64);
+	EXPECT_TRUE(kengine::meta::binary::load_scene(data, r).empty());
+}
\ No newline at end of file
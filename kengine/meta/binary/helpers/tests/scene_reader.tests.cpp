@@ -0,0 +1,79 @@
+// stl
+#include <cstring>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/meta/binary/helpers/scene_reader.hpp"
+#include "kengine/meta/binary/helpers/scene_writer.hpp"
+
+using namespace kengine::meta::binary;
+
+static std::vector<std::byte> make_scene() noexcept {
+	scene_writer writer(3);
+	writer.add_column("empty", column_kind::empty, 42, 0, { 0, 2 }, {});
+
+	const std::uint32_t values[] = { 1, 2, 3 };
+	std::vector<std::byte> data(sizeof(values));
+	std::memcpy(data.data(), values, sizeof(values));
+	writer.add_column("values", column_kind::trivially_copyable, 84, sizeof(std::uint32_t), { 0, 1, 2 }, std::move(data));
+
+	return writer.finish();
+}
+
+TEST(scene_reader, read) {
+	const auto data = make_scene();
+	const scene_reader reader(data);
+	ASSERT_TRUE(reader.is_valid());
+	EXPECT_EQ(reader.get_entity_count(), 3);
+
+	const auto columns = reader.get_columns();
+	ASSERT_EQ(columns.size(), 2);
+
+	EXPECT_EQ(reader.get_string(columns[0].type_name), "empty");
+	EXPECT_EQ(columns[0].kind, column_kind::empty);
+	EXPECT_EQ(columns[0].schema_hash, 42);
+	const auto empty_indices = reader.get_entity_indices(columns[0]);
+	ASSERT_EQ(empty_indices.size(), 2);
+	EXPECT_EQ(empty_indices[0], 0);
+	EXPECT_EQ(empty_indices[1], 2);
+
+	EXPECT_EQ(reader.get_string(columns[1].type_name), "values");
+	const auto values_data = reader.get_data(columns[1]);
+	ASSERT_EQ(values_data.size(), 3 * sizeof(std::uint32_t));
+	const auto values = reinterpret_cast<const std::uint32_t *>(values_data.data());
+	EXPECT_EQ(values[0], 1);
+	EXPECT_EQ(values[1], 2);
+	EXPECT_EQ(values[2], 3);
+}
+
+TEST(scene_reader, blocks_are_aligned) {
+	const auto data = make_scene();
+	const scene_reader reader(data);
+	ASSERT_TRUE(reader.is_valid());
+	for (const auto & column : reader.get_columns()) {
+		EXPECT_EQ(column.entities_offset % scene_alignment, 0);
+		EXPECT_EQ(column.data_offset % scene_alignment, 0);
+	}
+}
+
+TEST(scene_reader, invalid_magic) {
+	auto data = make_scene();
+	data[0] = std::byte{ 'X' };
+	EXPECT_FALSE(scene_reader(data).is_valid());
+}
+
+TEST(scene_reader, truncated) {
+	auto data = make_scene();
+	data.resize(data.size() - 1);
+	EXPECT_FALSE(scene_reader(data).is_valid());
+}
+
+TEST(scene_reader, out_of_range_entity_index) {
+	scene_writer writer(1);
+	writer.add_column("empty", column_kind::empty, 0, 0, { 1 }, {});
+	const auto data = writer.finish();
+	EXPECT_FALSE(scene_reader(data).is_valid());
+}
\ No newline at end of file
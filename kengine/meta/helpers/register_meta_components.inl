@@ -27,8 +27,14 @@
 #include "kengine/meta/imgui/helpers/impl/edit.hpp"
 #endif
 
+#ifdef KENGINE_META_BINARY
+#include "kengine/meta/binary/helpers/impl/load_column.hpp"
+#include "kengine/meta/binary/helpers/impl/save_column.hpp"
+#endif
+
 #ifdef KENGINE_META_JSON
 #include "kengine/meta/json/helpers/impl/load.hpp"
+#include "kengine/meta/json/helpers/impl/load_batch.hpp"
 #include "kengine/meta/json/helpers/impl/save.hpp"
 #endif
 
@@ -46,8 +52,13 @@ namespace kengine::meta {
 			meta::imgui::display,
 			meta::imgui::edit,
 #endif
+#ifdef KENGINE_META_BINARY
+			meta::binary::load_column,
+			meta::binary::save_column,
+#endif
 #ifdef KENGINE_META_JSON
 			meta::json::load,
+			meta::json::load_batch,
 			meta::json::save,
 #endif
 			meta::count,
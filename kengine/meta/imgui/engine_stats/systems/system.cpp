@@ -24,7 +24,7 @@
 #include "kengine/core/sort/helpers/get_name_sorted_entities.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 #include "kengine/meta/functions/count.hpp"
 #include "kengine/meta/functions/has.hpp"
 
@@ -44,14 +44,14 @@ namespace kengine::meta::imgui::engine_stats {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, log, log_category, "Initializing");
 
-			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute));
 
 			e.emplace<core::name>("Entities/Stats");
 			auto & tool = e.emplace<kengine::imgui::tool::tool>();
 			enabled = &tool.enabled;
 		}
 
-		void execute(float delta_time) noexcept {
+		void execute(float delta_time, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
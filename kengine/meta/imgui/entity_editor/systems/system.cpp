@@ -18,7 +18,7 @@
 #include "kengine/imgui/helpers/get_scale.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 #include "kengine/meta/imgui/helpers/edit_entity.hpp"
 
 namespace kengine::meta::imgui::entity_editor {
@@ -33,14 +33,14 @@ namespace kengine::meta::imgui::entity_editor {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, log, log_category, "Initializing");
 
-			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute));
 
 			e.emplace<core::name>("Entities/Editor");
 			auto & tool = e.emplace<kengine::imgui::tool::tool>(true);
 			enabled = &tool.enabled;
 		}
 
-		void execute(float delta_time) noexcept {
+		void execute(float delta_time, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
@@ -20,7 +20,7 @@
 #include "kengine/core/sort/helpers/get_name_sorted_entities.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 #include "kengine/meta/functions/has.hpp"
 #include "kengine/meta/functions/match_string.hpp"
 #include "kengine/meta/imgui/helpers/display_entity.hpp"
@@ -43,7 +43,7 @@ namespace kengine::meta::imgui::entity_selector {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, log, log_category, "Initializing");
 
-			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute));
 
 			e.emplace<core::name>("Entities/Selector");
 			auto & tool = e.emplace<kengine::imgui::tool::tool>();
@@ -52,7 +52,7 @@ namespace kengine::meta::imgui::entity_selector {
 
 		char name_search[1024] = "";
 		bool search_out_of_date = true;
-		void execute(float delta_time) noexcept {
+		void execute(float delta_time, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
@@ -42,6 +42,9 @@ namespace kengine::meta {
 
 		if (putils::reflection::imgui_edit(*comp)) {
 			kengine_logf(*e.registry(), verbose, "meta::imgui::edit", "Modified {}'s {}", e, putils::reflection::get_class_name<T>());
+			// Let observers know the component was modified in place
+			if constexpr (!std::is_empty<T>())
+				e.patch<T>();
 			return true;
 		}
 
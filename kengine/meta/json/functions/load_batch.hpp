@@ -0,0 +1,19 @@
+#pragma once
+
+// stl
+#include <span>
+
+// nlohmann
+#include <nlohmann/json.hpp>
+
+// kengine
+#include "kengine/base_function.hpp"
+
+namespace kengine::meta::json {
+	using load_batch_signature = void(std::span<const nlohmann::json * const>, std::span<const entt::entity>, entt::registry &);
+	//! putils reflect all
+	//! parents: [refltype::base]
+	struct load_batch : base_function<load_batch_signature> {};
+}
+
+#include "load_batch.rpp"
\ No newline at end of file
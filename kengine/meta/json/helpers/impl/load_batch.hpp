@@ -0,0 +1,21 @@
+#pragma once
+
+// stl
+#include <type_traits>
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// kengine
+#include "kengine/meta/json/functions/load_batch.hpp"
+#include "kengine/meta/helpers/impl/meta_component_implementation.hpp"
+
+namespace kengine::meta {
+	template<typename T>
+	struct meta_component_implementation<json::load_batch, T> {
+		static constexpr bool value = std::is_move_assignable_v<T>;
+		static void function(std::span<const nlohmann::json * const> components_json, std::span<const entt::entity> entities, entt::registry & r) noexcept;
+	};
+}
+
+#include "load_batch.inl"
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "load_batch.hpp"
+
+// stl
+#include <algorithm>
+#include <execution>
+#include <vector>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// putils
+#include "putils/range.hpp"
+#include "putils/reflection_helpers/json_helper.hpp"
+#include "putils/thread_name.hpp"
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::meta {
+	template<typename T>
+	void meta_component_implementation<json::load_batch, T>::function(std::span<const nlohmann::json * const> components_json, std::span<const entt::entity> entities, entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, very_verbose, "meta::json::load_batch", "Loading {} for {} entities from JSON", putils::reflection::get_class_name<T>(), entities.size());
+
+		if constexpr (!std::is_empty<T>()) {
+			// Parsing doesn't touch the registry, so it's done in parallel (but not vectorized, as it allocates)
+			std::vector<T> components(components_json.size());
+			std::for_each(std::execution::par, putils_range(components_json), [&](const nlohmann::json * const & json) noexcept {
+				const putils::scoped_thread_name thread_name("JSON loader");
+				const auto index = &json - components_json.data();
+				putils::reflection::from_json(*json, components[index]);
+			});
+
+			// Components are attached from the calling thread, so that storages and signals are never used concurrently
+			for (size_t i = 0; i < components.size(); ++i)
+				r.emplace_or_replace<T>(entities[i], std::move(components[i]));
+		}
+		else {
+			kengine_log(r, very_verbose, "meta::json::load_batch", "Component is empty, not parsing anything");
+			for (const auto e : entities)
+				r.emplace_or_replace<T>(e);
+		}
+	}
+}
\ No newline at end of file
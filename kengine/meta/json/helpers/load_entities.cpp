@@ -0,0 +1,104 @@
+#include "load_entities.hpp"
+
+// stl
+#include <map>
+#include <string>
+#include <vector>
+
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// putils
+#include "putils/string.hpp"
+
+// kengine
+#include "kengine/core/assert/helpers/kengine_assert.hpp"
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/json/functions/load.hpp"
+#include "kengine/meta/json/functions/load_batch.hpp"
+#include "kengine/meta/json/helpers/loader_index.hpp"
+
+namespace kengine::meta::json {
+	static constexpr auto log_category = "meta_json";
+
+	// Entities (and the matching component JSON) that a given loader should receive
+	struct loader_matches {
+		std::vector<size_t> indices;
+		std::vector<const nlohmann::json *> components_json;
+		std::vector<entt::entity> entities;
+	};
+
+	static void report_unknown_keys(const entt::registry & r, const std::map<std::string, size_t, std::less<>> & unknown_keys) noexcept {
+		if (unknown_keys.empty())
+			return;
+
+		std::string report;
+		for (const auto & [key, count] : unknown_keys) {
+			if (!report.empty())
+				report += ", ";
+			report += putils::string<128>("'{}' ({} entities)", key, count).c_str();
+		}
+		kengine_logf(r, warning, log_category, "No loader found for {} JSON keys: {}", unknown_keys.size(), report);
+	}
+
+	void load_entities(std::span<const nlohmann::json> entities_json, std::span<const entt::entity> entities, entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, verbose, log_category, "Loading {} entities from JSON", entities.size());
+
+		kengine_assert(r, entities_json.size() == entities.size());
+		if (entities_json.size() != entities.size())
+			return;
+
+		const auto & index = get_loader_index(r);
+
+		// Only visit the keys actually present in each entity, instead of looking up every registered type in every entity
+		std::vector<loader_matches> matches(index.named_types.size());
+		std::map<std::string, size_t, std::less<>> unknown_keys;
+		for (size_t i = 0; i < entities_json.size(); ++i) {
+			const auto & entity_json = entities_json[i];
+			if (!entity_json.is_object())
+				continue;
+
+			for (const auto & [key, value] : entity_json.items()) {
+				const auto it = index.slots.find(std::string_view(key));
+				if (it == index.slots.end()) {
+					++unknown_keys[key];
+					continue;
+				}
+
+				auto & type_matches = matches[it->second];
+				type_matches.indices.push_back(i);
+				type_matches.components_json.push_back(&value);
+				type_matches.entities.push_back(entities[i]);
+			}
+		}
+		report_unknown_keys(r, unknown_keys);
+
+		// Component types are processed one after the other, so that the registry's storages and signals are only ever used from this thread.
+		// Parsing is parallelized by the load_batch implementations themselves
+		for (size_t slot = 0; slot < matches.size(); ++slot) {
+			const auto & type_matches = matches[slot];
+			if (type_matches.entities.empty())
+				continue;
+
+			const auto type_entity = index.named_types[slot];
+			if (const auto batch = r.try_get<load_batch>(type_entity))
+				(*batch)(type_matches.components_json, type_matches.entities, r);
+			else if (const auto loader = r.try_get<load>(type_entity))
+				for (const auto i : type_matches.indices)
+					(*loader)(entities_json[i], { r, entities[i] });
+		}
+
+		// Types without a name can't be matched against keys, so give them every entity
+		for (const auto type_entity : index.unnamed_types) {
+			if (const auto loader = r.try_get<load>(type_entity)) {
+				for (size_t i = 0; i < entities.size(); ++i)
+					(*loader)(entities_json[i], { r, entities[i] });
+			}
+			else
+				kengine_logf(r, warning, log_category, "Type entity {} only has load_batch but no name, it can't be matched against JSON keys", type_entity);
+		}
+	}
+}
\ No newline at end of file
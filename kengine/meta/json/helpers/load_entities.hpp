@@ -0,0 +1,14 @@
+#pragma once
+
+// stl
+#include <span>
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// nlohmann
+#include <nlohmann/json.hpp>
+
+namespace kengine::meta::json {
+	KENGINE_META_JSON_EXPORT void load_entities(std::span<const nlohmann::json> entities_json, std::span<const entt::entity> entities, entt::registry & r) noexcept;
+}
\ No newline at end of file
@@ -1,21 +1,13 @@
 #include "load_entity.hpp"
 
-// stl
-#include <algorithm>
-#include <execution>
-
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
 
-// putils
-#include "putils/range.hpp"
-
 // kengine
-#include "kengine/core/data/name.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
-#include "kengine/meta/json/functions/load.hpp"
+#include "kengine/meta/json/helpers/load_entities.hpp"
 
 namespace kengine::meta::json {
 	static constexpr auto log_category = "meta_json";
@@ -25,10 +17,7 @@ namespace kengine::meta::json {
 		kengine_logf(*e.registry(), verbose, log_category, "Loading {} from JSON", e);
 		kengine_logf(*e.registry(), very_verbose, log_category, "Input: {}", entity_json.dump(4));
 
-		const auto view = e.registry()->view<const load>();
-		std::for_each(std::execution::par_unseq, putils_range(view), [&](entt::entity loader_entity) {
-			const auto & [loader] = view.get(loader_entity);
-			loader(entity_json, e);
-		});
+		const auto entity = e.entity();
+		load_entities({ &entity_json, 1 }, { &entity, 1 }, *e.registry());
 	}
 }
\ No newline at end of file
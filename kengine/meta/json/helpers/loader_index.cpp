@@ -0,0 +1,74 @@
+#include "loader_index.hpp"
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/data/name.hpp"
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/meta/json/functions/load.hpp"
+#include "kengine/meta/json/functions/load_batch.hpp"
+
+namespace kengine::meta::json {
+	static constexpr auto log_category = "meta_json";
+
+	static void invalidate_loader_index(entt::registry & r, entt::entity) noexcept {
+		r.ctx().get<loader_index>().dirty = true;
+	}
+
+	// Names are constructed for many non-type entities, so only invalidate for loaders
+	static void on_name_constructed(entt::registry & r, entt::entity e) noexcept {
+		if (r.any_of<load, load_batch>(e))
+			invalidate_loader_index(r, e);
+	}
+
+	static void add_loader(entt::registry & r, loader_index & index, entt::entity type_entity) noexcept {
+		const auto name = r.try_get<core::name>(type_entity);
+		if (!name) {
+			index.unnamed_types.push_back(type_entity);
+			return;
+		}
+
+		const auto [it, inserted] = index.slots.try_emplace(name->name.c_str(), index.named_types.size());
+		if (inserted)
+			index.named_types.push_back(type_entity);
+		else
+			kengine_logf(r, warning, log_category, "Several type entities can load '{}', only {} will be used", name->name, index.named_types[it->second]);
+	}
+
+	static void rebuild_loader_index(entt::registry & r, loader_index & index) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_log(r, verbose, log_category, "Rebuilding loader index");
+
+		index.slots.clear();
+		index.named_types.clear();
+		index.unnamed_types.clear();
+
+		for (const auto type_entity : r.view<load_batch>())
+			add_loader(r, index, type_entity);
+		for (const auto type_entity : r.view<load>(entt::exclude<load_batch>))
+			add_loader(r, index, type_entity);
+
+		index.dirty = false;
+	}
+
+	const loader_index & get_loader_index(entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		auto index = r.ctx().find<loader_index>();
+		if (!index) {
+			index = &r.ctx().emplace<loader_index>();
+
+			r.on_construct<load>().connect<&invalidate_loader_index>();
+			r.on_destroy<load>().connect<&invalidate_loader_index>();
+			r.on_construct<load_batch>().connect<&invalidate_loader_index>();
+			r.on_destroy<load_batch>().connect<&invalidate_loader_index>();
+			r.on_construct<core::name>().connect<&on_name_constructed>();
+		}
+
+		if (index->dirty)
+			rebuild_loader_index(r, *index);
+		return *index;
+	}
+}
\ No newline at end of file
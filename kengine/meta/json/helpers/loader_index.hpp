@@ -0,0 +1,22 @@
+#pragma once
+
+// stl
+#include <vector>
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// kengine
+#include "kengine/core/helpers/string_hash.hpp"
+
+namespace kengine::meta::json {
+	// Registry context variable mapping component names to the type entities able to load them
+	struct loader_index {
+		string_map<size_t> slots;
+		std::vector<entt::entity> named_types; // Indexed by the values in `slots`
+		std::vector<entt::entity> unnamed_types;
+		bool dirty = true;
+	};
+
+	KENGINE_META_JSON_EXPORT const loader_index & get_loader_index(entt::registry & r) noexcept;
+}
\ No newline at end of file
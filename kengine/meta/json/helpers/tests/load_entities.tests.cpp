@@ -0,0 +1,134 @@
+// stl
+#include <chrono>
+#include <string>
+#include <vector>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/data/name.hpp"
+#include "kengine/core/data/transform.hpp"
+#include "kengine/meta/helpers/register_metadata.hpp"
+#include "kengine/meta/helpers/register_meta_component_implementation.hpp"
+#include "kengine/meta/json/functions/load.hpp"
+#include "kengine/meta/json/functions/load_batch.hpp"
+#include "kengine/meta/json/helpers/impl/load.hpp"
+#include "kengine/meta/json/helpers/impl/load_batch.hpp"
+#include "kengine/meta/json/helpers/load_entities.hpp"
+
+static std::vector<nlohmann::json> make_entities_json(size_t count) noexcept {
+	std::vector<nlohmann::json> ret(count);
+	for (size_t i = 0; i < count; ++i) {
+		auto & json = ret[i];
+		json["name"]["name"] = "entity";
+		// Only give a transform to every other entity
+		if (i % 2 == 0)
+			json["transform"]["bounding_box"]["position"]["x"] = float(i);
+	}
+	return ret;
+}
+
+TEST(meta_json, load_entities) {
+	entt::registry r;
+	kengine::meta::register_metadata<kengine::core::name, kengine::core::transform>(r);
+	kengine::meta::register_meta_component_implementation<
+		kengine::meta::json::load_batch,
+		kengine::core::name, kengine::core::transform
+	>(r);
+
+	const auto entities_json = make_entities_json(100);
+	std::vector<entt::entity> entities(entities_json.size());
+	r.create(entities.begin(), entities.end());
+	kengine::meta::json::load_entities(entities_json, entities, r);
+
+	for (size_t i = 0; i < entities.size(); ++i) {
+		const auto e = entities[i];
+		EXPECT_TRUE(r.all_of<kengine::core::name>(e));
+		EXPECT_EQ(r.get<kengine::core::name>(e).name, "entity");
+
+		if (i % 2 == 0) {
+			EXPECT_TRUE(r.all_of<kengine::core::transform>(e));
+			EXPECT_EQ(r.get<kengine::core::transform>(e).bounding_box.position.x, float(i));
+		}
+		else
+			EXPECT_FALSE(r.all_of<kengine::core::transform>(e));
+	}
+}
+
+TEST(meta_json, load_entities_falls_back_to_load) {
+	entt::registry r;
+	kengine::meta::register_metadata<kengine::core::name, kengine::core::transform>(r);
+	kengine::meta::register_meta_component_implementation<kengine::meta::json::load_batch, kengine::core::name>(r);
+	kengine::meta::register_meta_component_implementation<kengine::meta::json::load, kengine::core::name, kengine::core::transform>(r);
+
+	const auto entities_json = make_entities_json(10);
+	std::vector<entt::entity> entities(entities_json.size());
+	r.create(entities.begin(), entities.end());
+	kengine::meta::json::load_entities(entities_json, entities, r);
+
+	for (size_t i = 0; i < entities.size(); ++i) {
+		const auto e = entities[i];
+		EXPECT_EQ(r.get<kengine::core::name>(e).name, "entity");
+		EXPECT_EQ(r.all_of<kengine::core::transform>(e), i % 2 == 0);
+	}
+}
+
+TEST(meta_json, load_entities_ignores_unknown_keys) {
+	entt::registry r;
+	kengine::meta::register_metadata<kengine::core::name, kengine::core::transform>(r);
+	kengine::meta::register_meta_component_implementation<kengine::meta::json::load_batch, kengine::core::name>(r);
+
+	auto entities_json = make_entities_json(10);
+	for (auto & json : entities_json)
+		json["unknown_component"]["value"] = 42;
+
+	std::vector<entt::entity> entities(entities_json.size());
+	r.create(entities.begin(), entities.end());
+	kengine::meta::json::load_entities(entities_json, entities, r);
+
+	for (const auto e : entities) {
+		EXPECT_EQ(r.get<kengine::core::name>(e).name, "entity");
+		EXPECT_FALSE(r.all_of<kengine::core::transform>(e));
+	}
+
+	// Loaders registered after the first load are picked up
+	kengine::meta::register_meta_component_implementation<kengine::meta::json::load_batch, kengine::core::transform>(r);
+	kengine::meta::json::load_entities(entities_json, entities, r);
+
+	for (size_t i = 0; i < entities.size(); ++i)
+		EXPECT_EQ(r.all_of<kengine::core::transform>(entities[i]), i % 2 == 0);
+}
+
+// Benchmark loading a large scene. Disabled by default, run it with --gtest_also_run_disabled_tests
+TEST(meta_json, DISABLED_benchmark_load_entities) {
+	entt::registry r;
+	kengine::meta::register_metadata<kengine::core::name, kengine::core::transform>(r);
+	kengine::meta::register_meta_component_implementation<
+		kengine::meta::json::load_batch,
+		kengine::core::name, kengine::core::transform
+	>(r);
+
+	constexpr size_t entity_count = 100'000;
+	const auto entities_json = make_entities_json(entity_count);
+	std::vector<entt::entity> entities(entity_count);
+
+	// The first load builds the loader index
+	r.create(entities.begin(), entities.end());
+	kengine::meta::json::load_entities(entities_json, entities, r);
+
+	constexpr size_t iterations = 5;
+	std::chrono::steady_clock::duration elapsed{ 0 };
+	for (size_t i = 0; i < iterations; ++i) {
+		r.create(entities.begin(), entities.end());
+		const auto start = std::chrono::steady_clock::now();
+		kengine::meta::json::load_entities(entities_json, entities, r);
+		elapsed += std::chrono::steady_clock::now() - start;
+	}
+
+	const auto milliseconds = double(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000. / double(iterations);
+	testing::Test::RecordProperty("load_" + std::to_string(entity_count) + "_entities", std::to_string(milliseconds));
+}
\ No newline at end of file
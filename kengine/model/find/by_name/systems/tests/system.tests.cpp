@@ -0,0 +1,64 @@
+// entt
+#include <entt/entity/registry.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/data/name.hpp"
+#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/model/data/instance.hpp"
+#include "kengine/model/find/by_name/data/instance_of_name.hpp"
+#include "kengine/model/find/by_name/systems/system.hpp"
+
+struct model_find_by_name : testing::Test {
+	entt::registry r;
+	const entt::entity system = kengine::model::find::by_name::add_system(r);
+
+	entt::entity find_model(const char * name) noexcept {
+		const auto e = r.create();
+		r.emplace<kengine::model::find::by_name::instance_of_name>(e).model.name = name;
+		r.get<kengine::main_loop::execute>(system)(0.f);
+		return r.get<kengine::model::instance>(e).model;
+	}
+};
+
+TEST_F(model_find_by_name, creates_model) {
+	const auto model = find_model("hello");
+	ASSERT_NE(model, entt::null);
+	EXPECT_EQ(r.get<kengine::core::name>(model).name, "hello");
+}
+
+TEST_F(model_find_by_name, finds_created_model) {
+	const auto model = find_model("hello");
+	EXPECT_EQ(find_model("hello"), model);
+	EXPECT_NE(find_model("world"), model);
+}
+
+TEST_F(model_find_by_name, finds_existing_model) {
+	const auto model = r.create();
+	r.emplace<kengine::core::name>(model, "hello");
+	EXPECT_EQ(find_model("hello"), model);
+}
+
+TEST_F(model_find_by_name, finds_patched_model) {
+	const auto model = find_model("hello");
+	r.patch<kengine::core::name>(model, [](kengine::core::name & name) noexcept { name.name = "world"; });
+	EXPECT_EQ(find_model("world"), model);
+	EXPECT_NE(find_model("hello"), model);
+}
+
+TEST_F(model_find_by_name, finds_model_modified_in_place) {
+	const auto model = find_model("hello");
+	r.get<kengine::core::name>(model).name = "world";
+	EXPECT_EQ(find_model("world"), model);
+	EXPECT_NE(find_model("hello"), model);
+}
+
+TEST_F(model_find_by_name, forgets_destroyed_model) {
+	const auto model = find_model("hello");
+	r.destroy(model);
+	const auto new_model = find_model("hello");
+	EXPECT_NE(new_model, entt::null);
+	EXPECT_TRUE(r.valid(new_model));
+}
\ No newline at end of file
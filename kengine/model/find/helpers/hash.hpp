@@ -0,0 +1,11 @@
+#pragma once
+
+// stl
+#include <cstddef>
+
+namespace kengine::model::find {
+	template<typename T>
+	std::size_t hash(const T & value) noexcept;
+}
+
+#include "hash.inl"
\ No newline at end of file
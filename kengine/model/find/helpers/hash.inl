@@ -0,0 +1,26 @@
+#include "hash.hpp"
+
+// stl
+#include <functional>
+#include <string_view>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace kengine::model::find {
+	template<typename T>
+	std::size_t hash(const T & value) noexcept {
+		if constexpr (requires { std::hash<T>{}(value); })
+			return std::hash<T>{}(value);
+		else if constexpr (requires { std::string_view(value.c_str()); })
+			return std::hash<std::string_view>{}(value.c_str());
+		else {
+			static_assert(putils::reflection::has_attributes<T>());
+			std::size_t ret = 0;
+			putils::reflection::for_each_attribute<T>([&](const auto & attr) noexcept {
+				ret ^= find::hash(value.*(attr.ptr)) + 0x9e3779b9 + (ret << 6) + (ret >> 2);
+			});
+			return ret;
+		}
+	}
+}
\ No newline at end of file
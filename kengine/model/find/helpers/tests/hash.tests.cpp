@@ -0,0 +1,38 @@
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/data/name.hpp"
+#include "kengine/model/find/helpers/hash.hpp"
+
+namespace {
+	struct key {
+		kengine::core::name name;
+		int id = 0;
+	};
+}
+
+#define refltype key
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(id)
+	);
+};
+#undef refltype
+
+TEST(model_find, hash_string) {
+	const kengine::core::name::string a = "hello";
+	const kengine::core::name::string b = "hello";
+	const kengine::core::name::string c = "world";
+	EXPECT_EQ(kengine::model::find::hash(a), kengine::model::find::hash(b));
+	EXPECT_NE(kengine::model::find::hash(a), kengine::model::find::hash(c));
+}
+
+TEST(model_find, hash_reflection) {
+	const key a{ .name = { "hello" }, .id = 42 };
+	const key b{ .name = { "hello" }, .id = 42 };
+	const key c{ .name = { "hello" }, .id = 43 };
+	EXPECT_EQ(kengine::model::find::hash(a), kengine::model::find::hash(b));
+	EXPECT_NE(kengine::model::find::hash(a), kengine::model::find::hash(c));
+}
\ No newline at end of file
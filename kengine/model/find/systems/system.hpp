@@ -1,5 +1,9 @@
 #pragma once
 
+// stl
+#include <cstddef>
+#include <unordered_map>
+
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
@@ -9,11 +13,12 @@
 #include "putils/reflection_helpers/json_helper.hpp"
 
 // kengine
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/model/data/instance.hpp"
 #include "kengine/model/find/data/instance_of.hpp"
+#include "kengine/model/find/helpers/hash.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
 
 namespace kengine::model::find {
@@ -24,8 +29,18 @@ namespace kengine::model::find {
 
 		entt::registry & r;
 
+		// Existing models, indexed by the hash of their model component
+		std::unordered_multimap<std::size_t, entt::entity> models_by_hash;
+		std::unordered_map<entt::entity, std::size_t> model_hashes;
+
+		const entt::scoped_connection connections[3] = {
+			r.on_construct<model_component>().template connect<&system::add_model>(this),
+			r.on_update<model_component>().template connect<&system::update_model>(this),
+			r.on_destroy<model_component>().template connect<&system::remove_model>(this),
+		};
+
 		struct processed {};
-		kengine::new_entity_processor<processed, InstanceOf> processor{ r, putils_forward_to_this(find_or_create_model) };
+		kengine::reactive_entity_processor<processed, InstanceOf> processor{ r, putils_forward_to_this(find_or_create_model) };
 
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
@@ -33,12 +48,16 @@ namespace kengine::model::find {
 			kengine_log(r, log, log_category.c_str(), "Initializing");
 			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
 
+			for (const auto model : r.view<model_component>())
+				add_model(r, model);
+
 			processor.process();
 		}
 
 		void execute(float delta_time) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category.c_str(), "Executing");
+			rehashed_since_execute = false;
 			processor.process();
 		}
 
@@ -53,19 +72,80 @@ namespace kengine::model::find {
 
 			kengine_logf(r, verbose, log_category.c_str(), "Looking for model for {} (model {}: {})", e, putils::reflection::get_class_name<model_component>(), model_reference.model);
 
-			for (const auto & [model, model_comp] : r.view<model_component>().each())
-				if (is_equal(model_comp, model_reference.model)) {
-					comp.model = model;
-					kengine_logf(r, verbose, log_category.c_str(), "Found existing model ({})", model);
-					return;
-				}
+			const auto hash = find::hash(model_reference.model);
+			auto model = find_model(hash, model_reference.model);
+			if (model == entt::null && !rehashed_since_execute) {
+				// Model components may have been modified in place, without going through `patch`
+				rehash_models();
+				model = find_model(hash, model_reference.model);
+			}
+
+			if (model != entt::null) {
+				comp.model = model;
+				kengine_logf(r, verbose, log_category.c_str(), "Found existing model ({})", model);
+				return;
+			}
 
-			const auto model = r.create();
+			model = r.create();
 			kengine_logf(r, log, log_category.c_str(), "Created new model {} for {} {}", model, putils::reflection::get_class_name<model_component>(), model_reference.model);
+			// Indexed by add_model
 			r.emplace<model_component>(model, model_reference.model);
 			comp.model = model;
 		}
 
+		entt::entity find_model(std::size_t hash, const model_component & model_reference) const noexcept {
+			const auto [begin, end] = models_by_hash.equal_range(hash);
+			for (auto it = begin; it != end; ++it) {
+				const auto model = it->second;
+				// Hashes may collide, or be outdated
+				if (is_equal(r.get<model_component>(model), model_reference))
+					return model;
+			}
+			return entt::null;
+		}
+
+		// Only done once per execution, so that creating many models doesn't rehash them all each time
+		bool rehashed_since_execute = false;
+		void rehash_models() noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, verbose, log_category.c_str(), "Rehashing models");
+
+			rehashed_since_execute = true;
+			for (const auto & [model, model_comp] : r.view<model_component>().each()) {
+				const auto it = model_hashes.find(model);
+				if (it != model_hashes.end() && it->second == find::hash(model_comp))
+					continue;
+
+				kengine_logf(r, verbose, log_category.c_str(), "Model {} was modified in place", model);
+				update_model(r, model);
+			}
+		}
+
+		void add_model(entt::registry &, entt::entity model) noexcept {
+			const auto hash = find::hash(r.get<model_component>(model));
+			models_by_hash.emplace(hash, model);
+			model_hashes[model] = hash;
+		}
+
+		void update_model(entt::registry &, entt::entity model) noexcept {
+			remove_model(r, model);
+			add_model(r, model);
+		}
+
+		void remove_model(entt::registry &, entt::entity model) noexcept {
+			const auto it = model_hashes.find(model);
+			if (it == model_hashes.end())
+				return;
+
+			const auto [begin, end] = models_by_hash.equal_range(it->second);
+			for (auto index_it = begin; index_it != end; ++index_it)
+				if (index_it->second == model) {
+					models_by_hash.erase(index_it);
+					break;
+				}
+			model_hashes.erase(it);
+		}
+
 		template<typename T>
 		static bool is_equal(const T & lhs, const T & rhs) noexcept {
 			if constexpr (std::equality_comparable<T>)
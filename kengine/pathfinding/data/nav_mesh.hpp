@@ -32,6 +32,8 @@ namespace kengine::pathfinding {
 		float detail_sample_dist = 75.f;
 		float detail_sample_max_error = 20.f;
 		int query_max_search_nodes = 65535;
+		int tile_size = 0; // Size of navmesh tiles, in cells. 0 builds a single tile covering the whole mesh
+		int max_obstacles = 128; // Maximum number of obstacles, for tiled navmeshes
 	};
 }
 
@@ -0,0 +1,13 @@
+#pragma once
+
+// entt
+#include <entt/entity/entity.hpp>
+
+namespace kengine::pathfinding {
+	//! putils reflect all
+	struct obstacle {
+		entt::entity environment = entt::null; // Entity whose navmesh the obstacle is on. Should have a model with a tiled nav_mesh
+	};
+}
+
+#include "obstacle.rpp"
@@ -0,0 +1,50 @@
+#pragma once
+
+// stl
+#include <span>
+#include <vector>
+
+// putils
+#include "putils/point.hpp"
+
+// kengine
+#include "kengine/base_function.hpp"
+
+namespace kengine::pathfinding {
+	namespace get_paths_impl {
+		//! kengine registration off
+		//! putils reflect all
+		//! used_types: [putils::point3f]
+		struct request {
+			putils::point3f start;
+			putils::point3f end;
+		};
+
+		// Steps of a path, in `paths::points`
+		//! kengine registration off
+		//! putils reflect all
+		struct path_range {
+			size_t first_point = 0;
+			size_t point_count = 0;
+		};
+
+		// Results of a batch of requests. Can be reused across calls to avoid reallocating
+		//! kengine registration off
+		//! putils reflect all
+		//! used_types: [kengine::pathfinding::get_paths_impl::path_range, putils::point3f]
+		struct paths {
+			std::vector<putils::point3f> points;
+			std::vector<path_range> ranges; // One per request, in the same order
+		};
+	}
+
+	// `environment` is the entity instantiating the `model Entity` this component is attached to
+	using get_paths_signature = void(entt::handle environment, std::span<const get_paths_impl::request> requests, get_paths_impl::paths & out);
+
+	//! putils reflect all
+	//! parents: [refltype::base]
+	//! used_types: [kengine::pathfinding::get_paths_impl::request, kengine::pathfinding::get_paths_impl::paths]
+	struct get_paths : base_function<get_paths_signature> {};
+}
+
+#include "get_paths.rpp"
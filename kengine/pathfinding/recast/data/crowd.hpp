@@ -1,19 +1,38 @@
 #pragma once
 
+// stl
+#include <vector>
+
 // recast
 #include <DetourCrowd.h>
 
+// putils
+#include "putils/point.hpp"
+
 // kengine
 #include "kengine/pathfinding/recast/helpers/unique_ptr.hpp"
 
 namespace kengine::pathfinding::recast {
 	using crowd_ptr = unique_ptr<dtCrowd, dtFreeCrowd>;
 
+	// Last values written to an agent, used to only update agents whose components changed
+	//! kengine registration off
+	struct agent_sync_state {
+		putils::point3f position_in_world;
+		putils::point3f size_in_nav_mesh;
+		float max_speed = 0.f;
+		putils::point3f destination_in_nav_mesh;
+		putils::point3f search_extents;
+		bool has_target = false;
+	};
+
 	//! putils reflect name
 	//! class_name: recast_crowd
 	struct crowd {
 		crowd_ptr ptr = nullptr;
+		std::vector<dtCrowdAgent *> active_agents; // Scratch buffer for the crowd's update
+		std::vector<agent_sync_state> agent_states; // Indexed by agent index
 	};
 }
 
-#include "crowd.rpp"
\ No newline at end of file
+#include "crowd.rpp"
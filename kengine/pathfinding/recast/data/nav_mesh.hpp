@@ -1,18 +1,27 @@
 #pragma once
 
+// stl
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
 // recast
 #include <DetourNavMesh.h>
 #include <DetourNavMeshQuery.h>
+#include <DetourTileCache.h>
 
 // putils
 #include "putils/default_constructors.hpp"
 
 // kengine
+#include "kengine/pathfinding/recast/helpers/path_cache.hpp"
 #include "kengine/pathfinding/recast/helpers/unique_ptr.hpp"
 
 namespace kengine::pathfinding::recast {
 	using nav_mesh_ptr = unique_ptr<dtNavMesh, dtFreeNavMesh>;
 	using nav_mesh_query_ptr = unique_ptr<dtNavMeshQuery, dtFreeNavMeshQuery>;
+	using tile_cache_ptr = unique_ptr<dtTileCache, dtFreeTileCache>;
 
 	//! kengine registration off
 	struct nav_mesh_data {
@@ -20,12 +29,43 @@ namespace kengine::pathfinding::recast {
 		int size = 0;
 	};
 
+	// Obstacles may be destroyed from any thread, so they queue their removal for the system to apply along with tile updates
+	//! kengine registration off
+	struct obstacle_removal_queue {
+		std::mutex mutex;
+		std::vector<dtObstacleRef> refs;
+	};
+
+	// Only used by tiled navmeshes. The tile cache references the other members, so they're kept alive along with it
+	//! kengine registration off
+	struct tile_cache_data {
+		std::unique_ptr<dtTileCacheAlloc> allocator;
+		std::unique_ptr<dtTileCacheCompressor> compressor;
+		std::unique_ptr<dtTileCacheMeshProcess> mesh_process;
+		tile_cache_ptr ptr = nullptr;
+		bool pending_changes = false; // Obstacles were added since the last update
+		std::shared_ptr<obstacle_removal_queue> removed_obstacles; // Shared with obstacles, which may outlive the nav_mesh
+	};
+
+	// Navmesh queries can't be shared between threads, so concurrent path queries each borrow one from this pool
+	//! kengine registration off
+	struct nav_mesh_query_pool {
+		std::mutex mutex;
+		std::vector<nav_mesh_query_ptr> available;
+	};
+
 	//! putils reflect name
 	//! class_name: recast_nav_mesh
 	struct nav_mesh {
 		nav_mesh_data data;
 		nav_mesh_ptr ptr = nullptr;
 		nav_mesh_query_ptr nav_mesh_query = nullptr;
+		tile_cache_data tile_cache;
+
+		// Only used by `get_path` and `get_paths`. Held by pointer to keep the component movable
+		std::unique_ptr<nav_mesh_query_pool> query_pool;
+		std::unique_ptr<path_cache> paths;
+		std::unique_ptr<std::shared_mutex> tiles_mutex; // Held shared by path queries, and exclusively while the tile cache rebuilds tiles
 	};
 }
 
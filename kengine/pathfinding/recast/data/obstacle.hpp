@@ -0,0 +1,55 @@
+#pragma once
+
+// stl
+#include <memory>
+#include <mutex>
+
+// entt
+#include <entt/entity/handle.hpp>
+
+// recast
+#include <DetourTileCache.h>
+
+// putils
+#include "putils/default_constructors.hpp"
+#include "putils/rect.hpp"
+
+// impl
+#include "nav_mesh.hpp"
+
+namespace kengine::pathfinding::recast {
+	//! putils reflect all
+	//! class_name: recast_obstacle
+	//! used_types: [putils::rect3f]
+	struct obstacle {
+		dtObstacleRef ref = 0;
+		entt::handle environment;
+		putils::rect3f box_in_nav_mesh; // Used to detect when the obstacle moves
+
+		std::shared_ptr<obstacle_removal_queue> removal_queue; // The queue of the tile cache the obstacle was added to
+
+		~obstacle() noexcept {
+			if (!removal_queue || ref == 0)
+				return;
+
+			// The tile cache is only modified by the system, under the nav_mesh's `tiles_mutex`
+			const std::lock_guard lock(removal_queue->mutex);
+			removal_queue->refs.push_back(ref);
+		}
+
+		PUTILS_DELETE_COPY(obstacle);
+		obstacle() noexcept = default;
+		obstacle(obstacle && rhs) noexcept {
+			*this = std::move(rhs);
+		}
+		obstacle & operator=(obstacle && rhs) noexcept {
+			std::swap(ref, rhs.ref);
+			std::swap(environment, rhs.environment);
+			std::swap(box_in_nav_mesh, rhs.box_in_nav_mesh);
+			std::swap(removal_queue, rhs.removal_queue);
+			return *this;
+		}
+	};
+}
+
+#include "obstacle.rpp"
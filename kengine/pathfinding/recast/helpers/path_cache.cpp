@@ -0,0 +1,78 @@
+#include "path_cache.hpp"
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::pathfinding::recast {
+	path_cache::path_cache(size_t capacity) noexcept
+		: capacity(capacity) {
+		index.reserve(capacity);
+	}
+
+	bool path_cache::find(const key & k, corridor & out) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const std::lock_guard lock(mutex);
+		const auto it = index.find(k);
+		if (it == index.end())
+			return false;
+
+		// Move to the front, as it was just used
+		entries.splice(entries.begin(), entries, it->second);
+		out = it->second->value;
+		return true;
+	}
+
+	void path_cache::insert(const key & k, const corridor & value, size_t corridor_generation) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (capacity == 0)
+			return;
+
+		const std::lock_guard lock(mutex);
+		if (corridor_generation != generation)
+			return; // The navmesh changed since the corridor was computed
+		if (const auto it = index.find(k); it != index.end()) {
+			entries.splice(entries.begin(), entries, it->second);
+			it->second->value = value;
+			return;
+		}
+
+		if (entries.size() >= capacity) {
+			// Recycle the least recently used entry instead of allocating a new one
+			index.erase(entries.back().k);
+			entries.splice(entries.begin(), entries, std::prev(entries.end()));
+			entries.front() = { k, value };
+		}
+		else
+			entries.push_front({ k, value });
+
+		index.emplace(k, entries.begin());
+	}
+
+	void path_cache::clear() noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const std::lock_guard lock(mutex);
+		entries.clear();
+		index.clear();
+		++generation;
+	}
+
+	size_t path_cache::size() noexcept {
+		const std::lock_guard lock(mutex);
+		return entries.size();
+	}
+
+	size_t path_cache::get_generation() noexcept {
+		const std::lock_guard lock(mutex);
+		return generation;
+	}
+
+	size_t path_cache::key_hash::operator()(const key & k) const noexcept {
+		auto ret = std::hash<dtPolyRef>{}(k.start);
+		ret ^= std::hash<dtPolyRef>{}(k.end) + 0x9e3779b9 + (ret << 6) + (ret >> 2);
+		ret ^= std::hash<unsigned int>{}((unsigned int)k.include_flags << 16 | k.exclude_flags) + 0x9e3779b9 + (ret << 6) + (ret >> 2);
+		return ret;
+	}
+}
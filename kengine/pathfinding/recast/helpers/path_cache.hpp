@@ -0,0 +1,55 @@
+#pragma once
+
+// stl
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// recast
+#include <DetourNavMesh.h>
+
+// putils
+#include "putils/vector.hpp"
+
+// kengine
+#include "kengine/pathfinding/functions/get_path.hpp"
+
+namespace kengine::pathfinding::recast {
+	// Thread-safe LRU cache of polygon corridors, so that repeated queries between the same polygons skip `findPath`
+	struct KENGINE_PATHFINDING_RECAST_EXPORT path_cache {
+		struct key {
+			dtPolyRef start = 0;
+			dtPolyRef end = 0;
+			unsigned short include_flags = 0;
+			unsigned short exclude_flags = 0;
+
+			bool operator==(const key &) const noexcept = default;
+		};
+
+		static constexpr char corridor_name[] = "nav_mesh_corridor";
+		using corridor = putils::vector<dtPolyRef, KENGINE_PATHFINDING_NAV_MESH_MAX_PATH_LENGTH, corridor_name>;
+
+		path_cache(size_t capacity) noexcept;
+
+		bool find(const key & k, corridor & out) noexcept;
+		void insert(const key & k, const corridor & value, size_t generation) noexcept;
+		void clear() noexcept;
+		size_t size() noexcept;
+		size_t get_generation() noexcept;
+
+		struct key_hash {
+			size_t operator()(const key & k) const noexcept;
+		};
+
+		struct entry {
+			key k;
+			corridor value;
+		};
+
+		size_t capacity;
+		size_t generation = 0; // Incremented by clear, so that corridors computed before it aren't inserted afterwards
+		std::mutex mutex;
+		std::list<entry> entries; // Most recently used first
+		std::unordered_map<key, std::list<entry>::iterator, key_hash> index;
+	};
+}
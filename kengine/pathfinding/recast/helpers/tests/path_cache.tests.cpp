@@ -0,0 +1,97 @@
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/pathfinding/recast/helpers/path_cache.hpp"
+
+using path_cache = kengine::pathfinding::recast::path_cache;
+
+static path_cache::corridor make_corridor(std::initializer_list<dtPolyRef> polys) noexcept {
+	path_cache::corridor ret;
+	for (const auto poly : polys)
+		ret.push_back(poly);
+	return ret;
+}
+
+TEST(path_cache, find_missing) {
+	path_cache cache{ 4 };
+	path_cache::corridor out;
+	EXPECT_FALSE(cache.find({ 1, 2 }, out));
+}
+
+TEST(path_cache, insert_and_find) {
+	path_cache cache{ 4 };
+	cache.insert({ 1, 3 }, make_corridor({ 1, 2, 3 }), cache.get_generation());
+
+	path_cache::corridor out;
+	EXPECT_TRUE(cache.find({ 1, 3 }, out));
+	ASSERT_EQ(out.size(), 3);
+	EXPECT_EQ(out[0], 1);
+	EXPECT_EQ(out[1], 2);
+	EXPECT_EQ(out[2], 3);
+}
+
+TEST(path_cache, filter_flags_are_part_of_key) {
+	path_cache cache{ 4 };
+	cache.insert({ 1, 3, 1, 0 }, make_corridor({ 1, 2, 3 }), cache.get_generation());
+
+	path_cache::corridor out;
+	EXPECT_FALSE(cache.find({ 1, 3, 2, 0 }, out));
+	EXPECT_FALSE(cache.find({ 1, 3, 1, 1 }, out));
+	EXPECT_TRUE(cache.find({ 1, 3, 1, 0 }, out));
+}
+
+TEST(path_cache, evicts_least_recently_used) {
+	path_cache cache{ 2 };
+	cache.insert({ 1, 1 }, make_corridor({ 1 }), cache.get_generation());
+	cache.insert({ 2, 2 }, make_corridor({ 2 }), cache.get_generation());
+
+	path_cache::corridor out;
+	EXPECT_TRUE(cache.find({ 1, 1 }, out)); // { 2, 2 } is now the least recently used
+
+	cache.insert({ 3, 3 }, make_corridor({ 3 }), cache.get_generation());
+	EXPECT_EQ(cache.size(), 2);
+	EXPECT_TRUE(cache.find({ 1, 1 }, out));
+	EXPECT_FALSE(cache.find({ 2, 2 }, out));
+	EXPECT_TRUE(cache.find({ 3, 3 }, out));
+}
+
+TEST(path_cache, insert_existing_updates) {
+	path_cache cache{ 2 };
+	cache.insert({ 1, 2 }, make_corridor({ 1, 2 }), cache.get_generation());
+	cache.insert({ 1, 2 }, make_corridor({ 1, 5, 2 }), cache.get_generation());
+	EXPECT_EQ(cache.size(), 1);
+
+	path_cache::corridor out;
+	EXPECT_TRUE(cache.find({ 1, 2 }, out));
+	EXPECT_EQ(out.size(), 3);
+}
+
+TEST(path_cache, clear) {
+	path_cache cache{ 2 };
+	cache.insert({ 1, 2 }, make_corridor({ 1, 2 }), cache.get_generation());
+	cache.clear();
+	EXPECT_EQ(cache.size(), 0);
+
+	path_cache::corridor out;
+	EXPECT_FALSE(cache.find({ 1, 2 }, out));
+}
+
+TEST(path_cache, zero_capacity) {
+	path_cache cache{ 0 };
+	cache.insert({ 1, 2 }, make_corridor({ 1, 2 }), cache.get_generation());
+	EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(path_cache, ignores_outdated_generation) {
+	path_cache cache{ 2 };
+	const auto generation = cache.get_generation();
+
+	// The navmesh changed while the corridor was being computed
+	cache.clear();
+	cache.insert({ 1, 2 }, make_corridor({ 1, 2 }), generation);
+	EXPECT_EQ(cache.size(), 0);
+
+	cache.insert({ 1, 2 }, make_corridor({ 1, 2 }), cache.get_generation());
+	EXPECT_EQ(cache.size(), 1);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+// stl
+#include <shared_mutex>
+
 // glm
 #include <glm/glm.hpp>
 
@@ -7,7 +10,11 @@
 #include "putils/point.hpp"
 
 // kengine
+#include "kengine/core/data/transform.hpp"
 #include "kengine/pathfinding/data/nav_mesh.hpp"
+#include "kengine/pathfinding/functions/get_path.hpp"
+#include "kengine/pathfinding/functions/get_paths.hpp"
+#include "kengine/pathfinding/recast/data/nav_mesh.hpp"
 #include "kengine/render/data/model_data.hpp"
 
 #include "config.hpp"
@@ -15,8 +22,27 @@
 namespace kengine::pathfinding::recast {
 	static constexpr auto log_category = "pathfinding_recast";
 
+	// Polygon flags set on built nav meshes
+	enum flags {
+		walk = 1,
+	};
+
 	extern const config * g_config;
 	void build_recast_component(entt::registry & r, entt::entity e, const render::model_data & model_data, const kengine::pathfinding::nav_mesh & nav_mesh) noexcept;
 	void process_built_recast_components(entt::registry & r) noexcept;
 	void do_pathfinding(entt::registry & r, float delta_time) noexcept;
+
+	// Borrows a query from the navmesh's pool for the duration of its lifetime, as queries can't be shared between threads
+	// Tiles can't be rebuilt while it's alive
+	struct borrowed_query {
+		const recast::nav_mesh & recast;
+		std::shared_lock<std::shared_mutex> tiles_lock;
+		nav_mesh_query_ptr ptr;
+
+		borrowed_query(const entt::registry & r, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept;
+		~borrowed_query() noexcept;
+	};
+
+	get_path::callable get_path_implementation(const core::transform * model_transform, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept;
+	get_paths::callable get_paths_implementation(const core::transform * model_transform, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept;
 }
\ No newline at end of file
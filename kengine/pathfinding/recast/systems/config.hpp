@@ -6,6 +6,7 @@ namespace kengine::pathfinding::recast {
 	//! metadata: [("config", true)]
 	struct config {
 		float path_optimization_range = 2.f;
+		int path_cache_size = 1024; // Number of polygon corridors cached per navmesh. Read when the navmesh is built
 	};
 }
 
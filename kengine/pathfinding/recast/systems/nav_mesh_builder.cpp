@@ -1,6 +1,13 @@
 // stl
+#include <algorithm>
+#include <cstddef>
+#include <execution>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
 
 // entt
 #include <entt/entity/handle.hpp>
@@ -8,11 +15,14 @@
 
 // recast
 #include <Recast.h>
+#include <DetourCommon.h>
 #include <DetourNavMeshBuilder.h>
+#include <DetourTileCache.h>
+#include <DetourTileCacheBuilder.h>
 
 // putils
-#include "putils/lengthof.hpp"
 #include "putils/on_scope_exit.hpp"
+#include "putils/range.hpp"
 #include "putils/thread_name.hpp"
 #include "putils/with.hpp"
 
@@ -24,8 +34,6 @@
 #include "kengine/core/data/transform.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
-#include "kengine/glm/helpers/convert_to_referencial.hpp"
-#include "kengine/glm/helpers/get_model_matrix.hpp"
 #include "kengine/pathfinding/data/nav_mesh.hpp"
 #include "kengine/pathfinding/functions/get_path.hpp"
 #include "kengine/pathfinding/recast/data/nav_mesh.hpp"
@@ -41,6 +49,10 @@ namespace kengine::pathfinding::recast {
 		using contour_set_ptr = unique_ptr<rcContourSet, rcFreeContourSet>;
 		using poly_mesh_ptr = unique_ptr<rcPolyMesh, rcFreePolyMesh>;
 		using poly_mesh_detail_ptr = unique_ptr<rcPolyMeshDetail, rcFreePolyMeshDetail>;
+		using height_field_layer_set_ptr = unique_ptr<rcHeightfieldLayerSet, rcFreeHeightfieldLayerSet>;
+
+		// Maximum number of layers (i.e. overlapping walkable surfaces) per tile
+		static constexpr int max_layers_per_tile = 32;
 
 		static std::optional<nav_mesh> create_recast_mesh(const char * file, entt::handle e, const pathfinding::nav_mesh & nav_mesh, const render::model_data & model_data) noexcept {
 			KENGINE_PROFILING_SCOPE;
@@ -48,6 +60,9 @@ namespace kengine::pathfinding::recast {
 
 			const auto & r = *e.registry();
 
+			if (nav_mesh.tile_size > 0)
+				return create_tiled_recast_mesh(file, e, nav_mesh, model_data);
+
 			recast::nav_mesh result;
 
 			const putils::string<4096> binary_file("{}.nav", file);
@@ -74,6 +89,416 @@ namespace kengine::pathfinding::recast {
 			return result;
 		}
 
+		// Tile layers are stored uncompressed, trading memory for faster obstacle updates
+		struct uncompressed_tile_layers : dtTileCacheCompressor {
+			int maxCompressedSize(const int buffer_size) final {
+				return buffer_size;
+			}
+
+			dtStatus compress(const unsigned char * buffer, const int buffer_size, unsigned char * compressed, const int max_compressed_size, int * compressed_size) final {
+				if (buffer_size > max_compressed_size)
+					return DT_FAILURE | DT_BUFFER_TOO_SMALL;
+				memcpy(compressed, buffer, buffer_size);
+				*compressed_size = buffer_size;
+				return DT_SUCCESS;
+			}
+
+			dtStatus decompress(const unsigned char * compressed, const int compressed_size, unsigned char * buffer, const int max_buffer_size, int * buffer_size) final {
+				if (compressed_size > max_buffer_size)
+					return DT_FAILURE | DT_BUFFER_TOO_SMALL;
+				memcpy(buffer, compressed, compressed_size);
+				*buffer_size = compressed_size;
+				return DT_SUCCESS;
+			}
+		};
+
+		struct mesh_process : dtTileCacheMeshProcess {
+			void process(dtNavMeshCreateParams * params, unsigned char * poly_areas, unsigned short * poly_flags) final {
+				for (int i = 0; i < params->polyCount; ++i)
+					if (poly_areas[i] == DT_TILECACHE_WALKABLE_AREA)
+						poly_flags[i] = flags::walk;
+			}
+		};
+
+		static std::optional<nav_mesh> create_tiled_recast_mesh(const char * file, entt::handle e, const pathfinding::nav_mesh & nav_mesh, const render::model_data & model_data) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto & r = *e.registry();
+			const auto & mesh_data = model_data.meshes[nav_mesh.concerned_mesh];
+
+			const auto vertices = get_vertices(r, model_data, mesh_data);
+			if (vertices == nullptr)
+				return std::nullopt;
+
+			const auto cfg = get_config(r, nav_mesh, mesh_data, vertices.get());
+			if (cfg.width == 0 || cfg.height == 0) {
+				kengine_assert_failed(r, "[Recast] Mesh was 0 height or width?");
+				return std::nullopt;
+			}
+
+			// Tile cache layer headers store a tile's dimensions (border included) as unsigned chars
+			const auto tile_size_with_border = nav_mesh.tile_size + get_tile_border_size(cfg) * 2;
+			if (tile_size_with_border > std::numeric_limits<unsigned char>::max()) {
+				kengine_assert_failed(r, "[Recast] tile_size is too large: tiles are {} cells wide once bordered, tile caches support at most 255", tile_size_with_border);
+				return std::nullopt;
+			}
+
+			const auto tiles_x = (cfg.width + nav_mesh.tile_size - 1) / nav_mesh.tile_size;
+			const auto tiles_z = (cfg.height + nav_mesh.tile_size - 1) / nav_mesh.tile_size;
+			kengine_logf(r, verbose, log_category, "Building {}x{} navmesh tiles", tiles_x, tiles_z);
+
+			recast::nav_mesh result;
+
+			result.tile_cache = create_tile_cache(r, nav_mesh, cfg, tiles_x * tiles_z * max_layers_per_tile);
+			if (result.tile_cache.ptr == nullptr)
+				return std::nullopt;
+
+			result.ptr = create_tiled_nav_mesh(r, nav_mesh, cfg, tiles_x * tiles_z);
+			if (result.ptr == nullptr)
+				return std::nullopt;
+
+			const putils::string<4096> binary_file("{}.nav", file);
+			auto layers = load_tiled_binary_file(binary_file.c_str(), nav_mesh);
+			if (!layers.empty()) {
+				kengine_log(r, verbose, log_category, "Found binary file");
+			}
+			else {
+				kengine_logf(r, verbose, log_category, "Found no binary file for {}, creating tile layers", file);
+				layers = create_tile_layers(r, nav_mesh, cfg, mesh_data, vertices.get(), tiles_x, tiles_z, *result.tile_cache.compressor);
+				if (layers.empty())
+					return std::nullopt;
+				save_tiled_binary_file(r, binary_file.c_str(), layers, nav_mesh);
+			}
+
+			for (auto & layer : layers) {
+				const auto status = result.tile_cache.ptr->addTile((unsigned char *)layer.data.get(), layer.size, DT_COMPRESSEDTILE_FREE_DATA, nullptr);
+				if (dtStatusFailed(status)) {
+					kengine_log(r, warning, log_category, "[Recast] Failed to add tile layer to tile cache");
+					continue;
+				}
+				// Now owned by the tile cache
+				(void)layer.data.release();
+			}
+
+			for (int z = 0; z < tiles_z; ++z)
+				for (int x = 0; x < tiles_x; ++x)
+					if (dtStatusFailed(result.tile_cache.ptr->buildNavMeshTilesAt(x, z, result.ptr.get())))
+						kengine_logf(r, warning, log_category, "[Recast] Failed to build navmesh tile {}x{}", x, z);
+
+			result.nav_mesh_query = create_nav_mesh_query(r, nav_mesh, *result.ptr);
+			if (result.nav_mesh_query == nullptr)
+				return std::nullopt;
+
+			return result;
+		}
+
+		static tile_cache_data create_tile_cache(const entt::registry & r, const pathfinding::nav_mesh & nav_mesh, const rcConfig & cfg, int max_tiles) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Creating tile cache");
+
+			tile_cache_data ret;
+			ret.allocator = std::make_unique<dtTileCacheAlloc>();
+			ret.compressor = std::make_unique<uncompressed_tile_layers>();
+			ret.mesh_process = std::make_unique<mesh_process>();
+
+			dtTileCacheParams params;
+			memset(&params, 0, sizeof(params));
+			rcVcopy(params.orig, cfg.bmin);
+			params.cs = cfg.cs;
+			params.ch = cfg.ch;
+			params.width = nav_mesh.tile_size;
+			params.height = nav_mesh.tile_size;
+			params.walkableHeight = nav_mesh.character_height;
+			params.walkableRadius = nav_mesh.character_radius;
+			params.walkableClimb = nav_mesh.character_climb;
+			params.maxSimplificationError = cfg.maxSimplificationError;
+			params.maxTiles = max_tiles;
+			params.maxObstacles = nav_mesh.max_obstacles;
+
+			tile_cache_ptr tile_cache{ dtAllocTileCache() };
+			if (tile_cache == nullptr) {
+				kengine_assert_failed(r, "[Recast] Failed to allocate tile cache");
+				return ret;
+			}
+
+			const auto status = tile_cache->init(&params, ret.allocator.get(), ret.compressor.get(), ret.mesh_process.get());
+			if (dtStatusFailed(status)) {
+				kengine_assert_failed(r, "[Recast] Failed to init tile cache");
+				return ret;
+			}
+
+			ret.ptr = std::move(tile_cache);
+			ret.removed_obstacles = std::make_shared<obstacle_removal_queue>();
+			return ret;
+		}
+
+		static nav_mesh_ptr create_tiled_nav_mesh(const entt::registry & r, const pathfinding::nav_mesh & nav_mesh, const rcConfig & cfg, int tile_count) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Creating tiled nav mesh");
+
+			// Poly refs are made of a tile index and a poly index, which share 22 bits
+			const auto tile_bits = std::min((int)dtIlog2(dtNextPow2(tile_count * max_layers_per_tile)), 14);
+			const auto poly_bits = 22 - tile_bits;
+
+			dtNavMeshParams params;
+			memset(&params, 0, sizeof(params));
+			rcVcopy(params.orig, cfg.bmin);
+			params.tileWidth = nav_mesh.tile_size * cfg.cs;
+			params.tileHeight = nav_mesh.tile_size * cfg.cs;
+			params.maxTiles = 1 << tile_bits;
+			params.maxPolys = 1 << poly_bits;
+
+			nav_mesh_ptr ret{ dtAllocNavMesh() };
+			if (ret == nullptr) {
+				kengine_assert_failed(r, "[Recast] Failed to allocate Detour navmesh");
+				return nullptr;
+			}
+
+			const auto status = ret->init(&params);
+			if (dtStatusFailed(status)) {
+				kengine_assert_failed(r, "[Recast] Failed to init tiled Detour navmesh");
+				return nullptr;
+			}
+
+			return ret;
+		}
+
+		static std::vector<nav_mesh_data> create_tile_layers(const entt::registry & r, const pathfinding::nav_mesh & nav_mesh, const rcConfig & cfg, const render::model_data::mesh & mesh_data, const float * vertices, int tiles_x, int tiles_z, dtTileCacheCompressor & compressor) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, verbose, log_category, "Creating tile layers");
+
+			const auto indices = get_indices(mesh_data);
+			const auto triangles_per_tile = get_triangles_per_tile(cfg, nav_mesh.tile_size, vertices, indices, tiles_x, tiles_z);
+
+			std::vector<std::vector<nav_mesh_data>> layers_per_tile(tiles_x * tiles_z);
+			std::vector<int> tile_indices(layers_per_tile.size());
+			std::iota(tile_indices.begin(), tile_indices.end(), 0);
+
+			std::for_each(std::execution::par, putils_range(tile_indices), [&](int tile_index) noexcept {
+				const putils::scoped_thread_name thread_name("Recast tile builder");
+				layers_per_tile[tile_index] = create_layers_for_tile(
+					r, cfg, nav_mesh.tile_size, vertices, (int)mesh_data.vertices.nb_elements,
+					triangles_per_tile[tile_index],
+					tile_index % tiles_x, tile_index / tiles_x,
+					compressor
+				);
+			});
+
+			std::vector<nav_mesh_data> ret;
+			for (auto & layers : layers_per_tile)
+				for (auto & layer : layers)
+					ret.push_back(std::move(layer));
+			return ret;
+		}
+
+		static std::vector<int> get_indices(const render::model_data::mesh & mesh_data) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			std::vector<int> indices(mesh_data.indices.nb_elements);
+			if (mesh_data.index_type == putils::meta::type<unsigned int>::index) {
+				const auto unsigned_indices = (const unsigned int *)mesh_data.indices.data;
+				for (size_t i = 0; i < indices.size(); ++i)
+					indices[i] = (int)unsigned_indices[i];
+			}
+			else
+				memcpy(indices.data(), mesh_data.indices.data, indices.size() * sizeof(int));
+			return indices;
+		}
+
+		// Buckets triangles by the tiles they overlap, so that each tile only rasterizes its own triangles
+		static std::vector<std::vector<int>> get_triangles_per_tile(const rcConfig & cfg, int tile_size, const float * vertices, const std::vector<int> & indices, int tiles_x, int tiles_z) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			std::vector<std::vector<int>> ret(tiles_x * tiles_z);
+
+			// Tiles are rasterized with a border, so include triangles that overlap it
+			const auto border_size = (float)(cfg.walkableRadius + 3) * cfg.cs;
+			const auto tile_world_size = (float)tile_size * cfg.cs;
+
+			for (size_t triangle = 0; triangle + 2 < indices.size(); triangle += 3) {
+				float min_x = FLT_MAX, min_z = FLT_MAX, max_x = -FLT_MAX, max_z = -FLT_MAX;
+				for (size_t i = 0; i < 3; ++i) {
+					const auto vertex = vertices + indices[triangle + i] * 3;
+					min_x = std::min(min_x, vertex[0]);
+					max_x = std::max(max_x, vertex[0]);
+					min_z = std::min(min_z, vertex[2]);
+					max_z = std::max(max_z, vertex[2]);
+				}
+
+				const auto first_x = std::clamp((int)((min_x - border_size - cfg.bmin[0]) / tile_world_size), 0, tiles_x - 1);
+				const auto last_x = std::clamp((int)((max_x + border_size - cfg.bmin[0]) / tile_world_size), 0, tiles_x - 1);
+				const auto first_z = std::clamp((int)((min_z - border_size - cfg.bmin[2]) / tile_world_size), 0, tiles_z - 1);
+				const auto last_z = std::clamp((int)((max_z + border_size - cfg.bmin[2]) / tile_world_size), 0, tiles_z - 1);
+
+				for (int z = first_z; z <= last_z; ++z)
+					for (int x = first_x; x <= last_x; ++x) {
+						auto & triangles = ret[z * tiles_x + x];
+						triangles.insert(triangles.end(), indices.begin() + triangle, indices.begin() + triangle + 3);
+					}
+			}
+
+			return ret;
+		}
+
+		static int get_tile_border_size(const rcConfig & cfg) noexcept {
+			return cfg.walkableRadius + 3;
+		}
+
+		static std::vector<nav_mesh_data> create_layers_for_tile(const entt::registry & r, const rcConfig & cfg, int tile_size, const float * vertices, int vertex_count, const std::vector<int> & triangles, int tile_x, int tile_z, dtTileCacheCompressor & compressor) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, very_verbose, log_category, "Creating layers for tile {}x{}", tile_x, tile_z);
+
+			std::vector<nav_mesh_data> ret;
+			if (triangles.empty())
+				return ret;
+
+			rcConfig tile_cfg = cfg;
+			tile_cfg.tileSize = tile_size;
+			tile_cfg.borderSize = get_tile_border_size(tile_cfg);
+			tile_cfg.width = tile_size + tile_cfg.borderSize * 2;
+			tile_cfg.height = tile_size + tile_cfg.borderSize * 2;
+
+			const auto tile_world_size = (float)tile_size * cfg.cs;
+			const auto border_world_size = (float)tile_cfg.borderSize * cfg.cs;
+			tile_cfg.bmin[0] = cfg.bmin[0] + (float)tile_x * tile_world_size - border_world_size;
+			tile_cfg.bmin[2] = cfg.bmin[2] + (float)tile_z * tile_world_size - border_world_size;
+			tile_cfg.bmax[0] = cfg.bmin[0] + (float)(tile_x + 1) * tile_world_size + border_world_size;
+			tile_cfg.bmax[2] = cfg.bmin[2] + (float)(tile_z + 1) * tile_world_size + border_world_size;
+
+			rcContext ctx;
+
+			height_field_ptr height_field{ rcAllocHeightfield() };
+			if (height_field == nullptr || !rcCreateHeightfield(&ctx, *height_field, tile_cfg.width, tile_cfg.height, tile_cfg.bmin, tile_cfg.bmax, tile_cfg.cs, tile_cfg.ch)) {
+				kengine_assert_failed(r, "[Recast] Failed to create tile height field");
+				return ret;
+			}
+
+			const auto triangle_count = (int)triangles.size() / 3;
+			std::vector<unsigned char> triangle_areas(triangle_count, 0);
+			rcMarkWalkableTriangles(&ctx, tile_cfg.walkableSlopeAngle, vertices, vertex_count, triangles.data(), triangle_count, triangle_areas.data());
+			if (!rcRasterizeTriangles(&ctx, vertices, vertex_count, triangles.data(), triangle_areas.data(), triangle_count, *height_field, tile_cfg.walkableClimb)) {
+				kengine_assert_failed(r, "[Recast] Failed to rasterize tile triangles");
+				return ret;
+			}
+
+			rcFilterLowHangingWalkableObstacles(&ctx, tile_cfg.walkableClimb, *height_field);
+			rcFilterLedgeSpans(&ctx, tile_cfg.walkableHeight, tile_cfg.walkableClimb, *height_field);
+			rcFilterWalkableLowHeightSpans(&ctx, tile_cfg.walkableHeight, *height_field);
+
+			compact_height_field_ptr compact_height_field{ rcAllocCompactHeightfield() };
+			if (compact_height_field == nullptr || !rcBuildCompactHeightfield(&ctx, tile_cfg.walkableHeight, tile_cfg.walkableClimb, *height_field, *compact_height_field)) {
+				kengine_assert_failed(r, "[Recast] Failed to build tile compact height field");
+				return ret;
+			}
+
+			if (!rcErodeWalkableArea(&ctx, tile_cfg.walkableRadius, *compact_height_field)) {
+				kengine_assert_failed(r, "[Recast] Failed to erode tile walkable area");
+				return ret;
+			}
+
+			height_field_layer_set_ptr layer_set{ rcAllocHeightfieldLayerSet() };
+			if (layer_set == nullptr || !rcBuildHeightfieldLayers(&ctx, *compact_height_field, tile_cfg.borderSize, tile_cfg.walkableHeight, *layer_set)) {
+				kengine_assert_failed(r, "[Recast] Failed to build tile height field layers");
+				return ret;
+			}
+
+			for (int i = 0; i < std::min(layer_set->nlayers, max_layers_per_tile); ++i) {
+				const auto & layer = layer_set->layers[i];
+
+				dtTileCacheLayerHeader header;
+				header.magic = DT_TILECACHE_MAGIC;
+				header.version = DT_TILECACHE_VERSION;
+				header.tx = tile_x;
+				header.ty = tile_z;
+				header.tlayer = i;
+				dtVcopy(header.bmin, layer.bmin);
+				dtVcopy(header.bmax, layer.bmax);
+				header.width = (unsigned char)layer.width;
+				header.height = (unsigned char)layer.height;
+				header.minx = (unsigned char)layer.minx;
+				header.maxx = (unsigned char)layer.maxx;
+				header.miny = (unsigned char)layer.miny;
+				header.maxy = (unsigned char)layer.maxy;
+				header.hmin = (unsigned short)layer.hmin;
+				header.hmax = (unsigned short)layer.hmax;
+
+				unsigned char * data = nullptr;
+				nav_mesh_data layer_data;
+				const auto status = dtBuildTileCacheLayer(&compressor, &header, layer.heights, layer.areas, layer.cons, &data, &layer_data.size);
+				if (dtStatusFailed(status)) {
+					kengine_assert_failed(r, "[Recast] Failed to build tile cache layer");
+					continue;
+				}
+				layer_data.data.reset(data);
+				ret.push_back(std::move(layer_data));
+			}
+
+			return ret;
+		}
+
+		static std::vector<nav_mesh_data> load_tiled_binary_file(const char * binary_file, const pathfinding::nav_mesh & nav_mesh) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			std::vector<nav_mesh_data> layers;
+
+			std::ifstream f(binary_file, std::ifstream::binary);
+			if (!f)
+				return layers;
+
+			pathfinding::nav_mesh header;
+			f.read((char *)&header, sizeof(header));
+			if (std::memcmp(&header, &nav_mesh, sizeof(header)))
+				return layers; // Different parameters
+
+			size_t layer_count = 0;
+			f.read((char *)&layer_count, sizeof(layer_count));
+			if (!f)
+				return layers;
+
+			// Sizes come from the file, so they're checked against what's left of it before allocating
+			std::error_code error;
+			const auto file_size = std::filesystem::file_size(binary_file, error);
+			if (error)
+				return layers;
+			auto remaining_size = file_size - std::min<std::uintmax_t>(file_size, f.tellg());
+
+			if (layer_count > remaining_size / sizeof(nav_mesh_data::size))
+				return layers; // Truncated or corrupt file
+
+			layers.resize(layer_count);
+			for (auto & layer : layers) {
+				f.read((char *)&layer.size, sizeof(layer.size));
+				remaining_size -= std::min<std::uintmax_t>(remaining_size, sizeof(layer.size));
+				if (!f || layer.size <= 0 || std::uintmax_t(layer.size) > remaining_size) {
+					layers.clear();
+					return layers;
+				}
+
+				layer.data.reset(dtAlloc(layer.size, dtAllocHint::DT_ALLOC_PERM));
+				f.read((char *)layer.data.get(), layer.size);
+				remaining_size -= layer.size;
+			}
+
+			if (!f)
+				layers.clear();
+			return layers;
+		}
+
+		static void save_tiled_binary_file(const entt::registry & r, const char * binary_file, const std::vector<nav_mesh_data> & layers, const pathfinding::nav_mesh & nav_mesh) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, verbose, log_category, "Saving binary file {}", binary_file);
+
+			std::ofstream f(binary_file, std::ofstream::trunc | std::ofstream::binary);
+			f.write((const char *)&nav_mesh, sizeof(nav_mesh));
+
+			const auto layer_count = layers.size();
+			f.write((const char *)&layer_count, sizeof(layer_count));
+			for (const auto & layer : layers) {
+				f.write((const char *)&layer.size, sizeof(layer.size));
+				f.write((const char *)layer.data.get(), layer.size);
+			}
+		}
+
 		static nav_mesh_data load_binary_file(const char * binary_file, const pathfinding::nav_mesh & nav_mesh) noexcept {
 			KENGINE_PROFILING_SCOPE;
 
@@ -472,73 +897,31 @@ namespace kengine::pathfinding::recast {
 			return nav_mesh_query;
 		}
 
-		static get_path::callable get_path_implementation(const core::transform * model_transform, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept {
-			KENGINE_PROFILING_SCOPE;
-
-			return [&, model_transform](entt::handle environment, const putils::point3f & start_world_space, const putils::point3f & end_world_space) {
-				KENGINE_PROFILING_SCOPE;
-				kengine_logf(
-					*environment.registry(), verbose, log_category, "Getting path in {} from {} to {}",
-					environment, start_world_space, end_world_space
-				);
-				static const dtQueryFilter filter;
-
-				const auto model_to_world = glm::get_model_matrix(environment.get<core::transform>(), model_transform);
-				const auto world_to_model = ::glm::inverse(model_to_world);
-
-				const auto start = glm::convert_to_referencial(start_world_space, world_to_model);
-				const auto end = glm::convert_to_referencial(end_world_space, world_to_model);
-
-				get_path_impl::path ret;
-
-				const auto max_extent = std::max(nav_mesh.character_radius * 2.f, nav_mesh.character_height);
-				const float extents[3] = { max_extent, max_extent, max_extent };
-
-				dtPolyRef start_ref;
-				float start_pt[3];
-				auto status = recast.nav_mesh_query->findNearestPoly(start.raw, extents, &filter, &start_ref, start_pt);
-				if (dtStatusFailed(status) || start_ref == 0) {
-					kengine_log(*environment.registry(), verbose, log_category, "Failed to find nearest poly to start");
-					return ret;
-				}
-
-				dtPolyRef end_ref;
-				float end_pt[3];
-				status = recast.nav_mesh_query->findNearestPoly(end.raw, extents, &filter, &end_ref, end_pt);
-				if (dtStatusFailed(status) || end_ref == 0) {
-					kengine_log(*environment.registry(), verbose, log_category, "Failed to find nearest poly to end");
-					return ret;
-				}
+		// Owning copy of a model's meshes, as build tasks may start after the model_data component has been removed
+		struct model_data_copy {
+			render::model_data model_data;
+			std::vector<std::vector<std::byte>> buffers;
+		};
 
-				dtPolyRef path[KENGINE_PATHFINDING_NAV_MESH_MAX_PATH_LENGTH];
-				int path_count = 0;
-				status = recast.nav_mesh_query->findPath(start_ref, end_ref, start_pt, end_pt, &filter, path, &path_count, (int)putils::lengthof(path));
-				if (dtStatusFailed(status)) {
-					kengine_log(*environment.registry(), verbose, log_category, "Failed to find path");
-					return ret;
-				}
+		static std::shared_ptr<const model_data_copy> copy_model_data(const render::model_data & model_data) noexcept {
+			KENGINE_PROFILING_SCOPE;
 
-				ret.resize(ret.capacity());
-				int straight_path_count = 0;
+			const auto copy = std::make_shared<model_data_copy>();
+			copy->model_data.vertex_attributes = model_data.vertex_attributes;
+			copy->model_data.vertex_size = model_data.vertex_size;
+			copy->buffers.reserve(model_data.meshes.size() * 2);
 
-				static_assert(sizeof(putils::point3f) == sizeof(float[3]));
-				status = recast.nav_mesh_query->findStraightPath(start_pt, end_pt, path, path_count, ret[0].raw, nullptr, nullptr, &straight_path_count, (int)ret.capacity());
-				if (dtStatusFailed(status)) {
-					kengine_log(*environment.registry(), verbose, log_category, "Failed to find straight path");
-					return ret;
-				}
+			const auto copy_buffer = [&](const render::model_data::mesh::buffer & buffer) noexcept {
+				const auto bytes = static_cast<const std::byte *>(buffer.data);
+				const auto & owned = copy->buffers.emplace_back(bytes, bytes + buffer.nb_elements * buffer.element_size);
+				return render::model_data::mesh::buffer{ buffer.nb_elements, buffer.element_size, owned.data() };
+			};
 
-				ret.resize(straight_path_count);
-				for (auto & step : ret)
-					step = glm::convert_to_referencial(step, model_to_world);
+			for (const auto & mesh : model_data.meshes)
+				copy->model_data.meshes.push_back({ copy_buffer(mesh.vertices), copy_buffer(mesh.indices), mesh.index_type });
 
-				return ret;
-			};
+			return copy;
 		}
-
-		enum flags {
-			walk = 1,
-		};
 	};
 
 	void build_recast_component(entt::registry & r, entt::entity e, const render::model_data & model_data, const pathfinding::nav_mesh & nav_mesh) noexcept {
@@ -558,10 +941,12 @@ namespace kengine::pathfinding::recast {
 		kengine::async::start_task(
 			r, e,
 			async::task::string("recast: load {}", model_name),
-			std::async(std::launch::async, [&r, e, &model_name, &model_data, &nav_mesh] {
+			// The task may start much later, so it works on copies instead of referencing e's components
+			[&r, e, model_name, nav_mesh, model_data = build_recast_component::copy_model_data(model_data)] {
 				const putils::scoped_thread_name thread_name(putils::string<64>("Load navmesh for {}", model_name));
-				return build_recast_component::create_recast_mesh(model_name.c_str(), { r, e }, nav_mesh, model_data);
-			})
+				return build_recast_component::create_recast_mesh(model_name.c_str(), { r, e }, nav_mesh, model_data->model_data);
+			},
+			async::priority::low
 		);
 	}
 
@@ -573,9 +958,15 @@ namespace kengine::pathfinding::recast {
 			if (!opt)
 				return;
 
+			opt->query_pool = std::make_unique<nav_mesh_query_pool>();
+			opt->paths = std::make_unique<path_cache>((size_t)std::max(g_config->path_cache_size, 0));
+			opt->tiles_mutex = std::make_unique<std::shared_mutex>();
+
 			const auto & recast = r.emplace<nav_mesh>(e, std::move(*opt));
 			const auto & nav_mesh = r.get<pathfinding::nav_mesh>(e);
-			r.emplace<get_path>(e, build_recast_component::get_path_implementation(r.try_get<core::transform>(e), nav_mesh, recast));
+			const auto model_transform = r.try_get<core::transform>(e);
+			r.emplace<get_path>(e, get_path_implementation(model_transform, nav_mesh, recast));
+			r.emplace<get_paths>(e, get_paths_implementation(model_transform, nav_mesh, recast));
 		});
 	}
 }
@@ -0,0 +1,255 @@
+// stl
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// recast
+#include <DetourNavMeshQuery.h>
+
+// putils
+#include "putils/lengthof.hpp"
+#include "putils/range.hpp"
+#include "putils/thread_name.hpp"
+
+// kengine
+#include "kengine/core/assert/helpers/kengine_assert.hpp"
+#include "kengine/core/data/transform.hpp"
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/glm/helpers/convert_to_referencial.hpp"
+#include "kengine/glm/helpers/get_model_matrix.hpp"
+#include "kengine/glm/helpers/get_world_matrix.hpp"
+#include "kengine/pathfinding/data/nav_mesh.hpp"
+#include "kengine/pathfinding/functions/get_path.hpp"
+#include "kengine/pathfinding/functions/get_paths.hpp"
+#include "kengine/pathfinding/recast/data/nav_mesh.hpp"
+
+#include "common.hpp"
+
+namespace kengine::pathfinding::recast {
+	borrowed_query::borrowed_query(const entt::registry & r, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept
+		: recast(recast),
+		  tiles_lock(*recast.tiles_mutex) {
+		KENGINE_PROFILING_SCOPE;
+
+		{
+			const std::lock_guard lock(recast.query_pool->mutex);
+			auto & available = recast.query_pool->available;
+			if (!available.empty()) {
+				ptr = std::move(available.back());
+				available.pop_back();
+				return;
+			}
+		}
+
+		kengine_log(r, verbose, log_category, "Allocating new nav mesh query");
+		ptr.reset(dtAllocNavMeshQuery());
+		if (ptr == nullptr || dtStatusFailed(ptr->init(recast.ptr.get(), nav_mesh.query_max_search_nodes))) {
+			kengine_assert_failed(r, "[Recast] Failed to init Detour navmesh query");
+			ptr = nullptr;
+		}
+	}
+
+	borrowed_query::~borrowed_query() noexcept {
+		if (ptr == nullptr)
+			return;
+		const std::lock_guard lock(recast.query_pool->mutex);
+		recast.query_pool->available.push_back(std::move(ptr));
+	}
+
+	struct path_queries {
+		struct environment_matrices {
+			::glm::mat4 model_to_world;
+			::glm::mat4 world_to_model;
+		};
+		static environment_matrices get_environment_matrices(entt::handle environment, const core::transform * model_transform) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto & transform = environment.get<core::transform>();
+
+			// Queries may run on any thread, so they can't add the cache themselves, but reuse the one the system keeps for environments with agents
+			environment_matrices ret;
+			if (const auto cached = glm::try_get_world_matrix(environment, transform, model_transform)) {
+				ret.model_to_world = cached->model_to_world;
+				ret.world_to_model = cached->has_inverse ? cached->world_to_model : ::glm::inverse(ret.model_to_world);
+				return ret;
+			}
+
+			ret.model_to_world = glm::get_model_matrix(transform, model_transform);
+			ret.world_to_model = ::glm::inverse(ret.model_to_world);
+			return ret;
+		}
+
+		// Computes the path in model space. Returns false if no path was found
+		static bool find_path(const entt::registry & r, dtNavMeshQuery & query, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast, const putils::point3f & start, const putils::point3f & end, get_path_impl::path & ret) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			static const dtQueryFilter filter;
+
+			const auto max_extent = std::max(nav_mesh.character_radius * 2.f, nav_mesh.character_height);
+			const float extents[3] = { max_extent, max_extent, max_extent };
+
+			dtPolyRef start_ref;
+			float start_pt[3];
+			auto status = query.findNearestPoly(start.raw, extents, &filter, &start_ref, start_pt);
+			if (dtStatusFailed(status) || start_ref == 0) {
+				kengine_log(r, verbose, log_category, "Failed to find nearest poly to start");
+				return false;
+			}
+
+			dtPolyRef end_ref;
+			float end_pt[3];
+			status = query.findNearestPoly(end.raw, extents, &filter, &end_ref, end_pt);
+			if (dtStatusFailed(status) || end_ref == 0) {
+				kengine_log(r, verbose, log_category, "Failed to find nearest poly to end");
+				return false;
+			}
+
+			const path_cache::key key{ start_ref, end_ref, filter.getIncludeFlags(), filter.getExcludeFlags() };
+			path_cache::corridor corridor;
+			const auto generation = recast.paths->get_generation();
+			if (!recast.paths->find(key, corridor)) {
+				corridor.resize(corridor.capacity());
+				int path_count = 0;
+				status = query.findPath(start_ref, end_ref, start_pt, end_pt, &filter, &corridor[0], &path_count, (int)corridor.capacity());
+				if (dtStatusFailed(status)) {
+					kengine_log(r, verbose, log_category, "Failed to find path");
+					return false;
+				}
+				corridor.resize(path_count);
+
+				// Partial corridors only lead towards the end polygon, and may be complete in later queries with more search nodes
+				if (!dtStatusDetail(status, DT_PARTIAL_RESULT))
+					recast.paths->insert(key, corridor, generation);
+			}
+
+			ret.resize(ret.capacity());
+			int straight_path_count = 0;
+
+			static_assert(sizeof(putils::point3f) == sizeof(float[3]));
+			status = query.findStraightPath(start_pt, end_pt, &corridor[0], (int)corridor.size(), ret[0].raw, nullptr, nullptr, &straight_path_count, (int)ret.capacity());
+			if (dtStatusFailed(status)) {
+				kengine_log(r, verbose, log_category, "Failed to find straight path");
+				ret.clear();
+				return false;
+			}
+
+			ret.resize(straight_path_count);
+			return true;
+		}
+
+		static get_path::callable get_path_implementation(const core::transform * model_transform, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			return [&, model_transform](entt::handle environment, const putils::point3f & start_world_space, const putils::point3f & end_world_space) {
+				KENGINE_PROFILING_SCOPE;
+
+				const auto & r = *environment.registry();
+				kengine_logf(r, verbose, log_category, "Getting path in {} from {} to {}", environment, start_world_space, end_world_space);
+
+				get_path_impl::path ret;
+
+				const borrowed_query query(r, nav_mesh, recast);
+				if (query.ptr == nullptr)
+					return ret;
+
+				const auto matrices = get_environment_matrices(environment, model_transform);
+				const auto start = glm::convert_to_referencial(start_world_space, matrices.world_to_model);
+				const auto end = glm::convert_to_referencial(end_world_space, matrices.world_to_model);
+
+				if (!find_path(r, *query.ptr, nav_mesh, recast, start, end, ret))
+					return ret;
+
+				for (auto & step : ret)
+					step = glm::convert_to_referencial(step, matrices.model_to_world);
+				return ret;
+			};
+		}
+
+		static get_paths::callable get_paths_implementation(const core::transform * model_transform, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			return [&, model_transform](entt::handle environment, std::span<const get_paths_impl::request> requests, get_paths_impl::paths & out) {
+				KENGINE_PROFILING_SCOPE;
+
+				const auto & r = *environment.registry();
+				kengine_logf(r, verbose, log_category, "Getting {} paths in {}", requests.size(), environment);
+
+				out.points.clear();
+				out.ranges.clear();
+				out.ranges.resize(requests.size());
+				if (requests.empty())
+					return;
+
+				const auto matrices = get_environment_matrices(environment, model_transform);
+
+				// Requests are split into one contiguous chunk per thread, each with its own query and output buffer
+				const auto chunk_count = std::min<size_t>(requests.size(), std::max(std::thread::hardware_concurrency(), 1u));
+				const auto chunk_size = (requests.size() + chunk_count - 1) / chunk_count;
+
+				std::vector<std::vector<putils::point3f>> chunk_points(chunk_count);
+				std::vector<size_t> chunk_indices(chunk_count);
+				std::iota(chunk_indices.begin(), chunk_indices.end(), 0);
+
+				std::for_each(std::execution::par, putils_range(chunk_indices), [&](size_t chunk_index) noexcept {
+					const putils::scoped_thread_name thread_name("Recast path query");
+
+					const borrowed_query query(r, nav_mesh, recast);
+					if (query.ptr == nullptr)
+						return;
+
+					auto & points = chunk_points[chunk_index];
+					const auto first_request = chunk_index * chunk_size;
+					const auto last_request = std::min(first_request + chunk_size, requests.size());
+					points.reserve((last_request - first_request) * 8);
+
+					get_path_impl::path path;
+					for (size_t i = first_request; i < last_request; ++i) {
+						const auto & request = requests[i];
+						const auto start = glm::convert_to_referencial(request.start, matrices.world_to_model);
+						const auto end = glm::convert_to_referencial(request.end, matrices.world_to_model);
+
+						auto & range = out.ranges[i];
+						range.first_point = points.size(); // Relative to the chunk for now
+						if (!find_path(r, *query.ptr, nav_mesh, recast, start, end, path))
+							continue;
+
+						range.point_count = path.size();
+						for (const auto & step : path)
+							points.push_back(glm::convert_to_referencial(step, matrices.model_to_world));
+					}
+				});
+
+				size_t total_points = 0;
+				for (const auto & points : chunk_points)
+					total_points += points.size();
+				out.points.reserve(total_points);
+
+				for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+					const auto chunk_offset = out.points.size();
+					const auto first_request = chunk_index * chunk_size;
+					const auto last_request = std::min(first_request + chunk_size, requests.size());
+					for (size_t i = first_request; i < last_request; ++i)
+						out.ranges[i].first_point += chunk_offset;
+
+					const auto & points = chunk_points[chunk_index];
+					out.points.insert(out.points.end(), points.begin(), points.end());
+				}
+			};
+		}
+	};
+
+	get_path::callable get_path_implementation(const core::transform * model_transform, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept {
+		return path_queries::get_path_implementation(model_transform, nav_mesh, recast);
+	}
+
+	get_paths::callable get_paths_implementation(const core::transform * model_transform, const pathfinding::nav_mesh & nav_mesh, const recast::nav_mesh & recast) noexcept {
+		return path_queries::get_paths_implementation(model_transform, nav_mesh, recast);
+	}
+}
@@ -5,13 +5,18 @@
 // stl
 #include <algorithm>
 #include <execution>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
 
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
 
 // putils
-#include "putils/lengthof.hpp"
 #include "putils/range.hpp"
 #include "putils/thread_name.hpp"
 
@@ -20,14 +25,16 @@
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/glm/helpers/convert_to_referencial.hpp"
-#include "kengine/glm/helpers/get_model_matrix.hpp"
+#include "kengine/glm/helpers/get_world_matrix.hpp"
 #include "kengine/model/helpers/get.hpp"
 #include "kengine/model/helpers/try_get.hpp"
 #include "kengine/pathfinding/data/nav_mesh.hpp"
 #include "kengine/pathfinding/data/navigation.hpp"
+#include "kengine/pathfinding/data/obstacle.hpp"
 #include "kengine/pathfinding/recast/data/agent.hpp"
 #include "kengine/pathfinding/recast/data/crowd.hpp"
 #include "kengine/pathfinding/recast/data/nav_mesh.hpp"
+#include "kengine/pathfinding/recast/data/obstacle.hpp"
 #include "kengine/physics/data/inertia.hpp"
 
 #include "common.hpp"
@@ -38,12 +45,117 @@ namespace kengine::pathfinding::recast {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Doing pathfinding");
 
+			remove_old_obstacles(r);
+			update_obstacles(r);
+			update_tile_caches(r, delta_time);
+
 			remove_old_agents(r);
 			move_changed_agents(r);
 			create_new_agents(r);
 			update_crowds(r, delta_time);
 		}
 
+		static void remove_old_obstacles(entt::registry & r) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Removing old obstacles");
+
+			for (const auto e : r.view<recast::obstacle>(entt::exclude<pathfinding::obstacle>)) {
+				kengine_logf(r, verbose, log_category, "Removing obstacle {}", e);
+				r.remove<recast::obstacle>(e);
+			}
+		}
+
+		static void update_obstacles(entt::registry & r) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Updating obstacles");
+
+			for (auto [e, obstacle, transform] : r.view<pathfinding::obstacle, core::transform>().each()) {
+				if (obstacle.environment == entt::null) {
+					kengine_logf(r, very_verbose, log_category, "Obstacle {} has null environment", e);
+					r.remove<recast::obstacle>(e);
+					continue;
+				}
+
+				const entt::handle environment{ r, obstacle.environment };
+				const auto nav_mesh = model::try_get<recast::nav_mesh>(environment);
+				if (!nav_mesh || !nav_mesh->tile_cache.ptr) {
+					kengine_logf(r, very_verbose, log_category, "Obstacle {}'s environment {} has no tiled nav mesh", e, environment);
+					continue;
+				}
+
+				const auto environment_info = get_environment_info(environment);
+				const putils::rect3f box_in_nav_mesh{
+					glm::convert_to_referencial(transform.bounding_box.position, environment_info.world_to_model),
+					transform.bounding_box.size / environment_info.environment_scale
+				};
+
+				if (const auto existing = r.try_get<recast::obstacle>(e)) {
+					const auto & box = existing->box_in_nav_mesh;
+					if (existing->environment == environment && existing->removal_queue == nav_mesh->tile_cache.removed_obstacles && box.position == box_in_nav_mesh.position && box.size == box_in_nav_mesh.size)
+						continue;
+					kengine_logf(r, verbose, log_category, "Moving obstacle {}", e);
+					// Destroying the component queues the old obstacle's removal from the tile cache
+					r.remove<recast::obstacle>(e);
+				}
+
+				const auto bmin = box_in_nav_mesh.position - box_in_nav_mesh.size / 2.f;
+				const auto bmax = box_in_nav_mesh.position + box_in_nav_mesh.size / 2.f;
+
+				dtObstacleRef ref = 0;
+				const auto status = nav_mesh->tile_cache.ptr->addBoxObstacle(bmin.raw, bmax.raw, &ref);
+				if (dtStatusFailed(status)) {
+					// The tile cache's request queue is full, try again next frame
+					kengine_logf(r, verbose, log_category, "Failed to add obstacle {} to {}, will retry", e, environment);
+					continue;
+				}
+
+				kengine_logf(r, verbose, log_category, "Added obstacle {} to {}", e, environment);
+				nav_mesh->tile_cache.pending_changes = true;
+				auto & recast_obstacle = r.emplace<recast::obstacle>(e);
+				recast_obstacle.ref = ref;
+				recast_obstacle.environment = environment;
+				recast_obstacle.box_in_nav_mesh = box_in_nav_mesh;
+				recast_obstacle.removal_queue = nav_mesh->tile_cache.removed_obstacles;
+			}
+		}
+
+		static void update_tile_caches(entt::registry & r, float delta_time) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Updating tile caches");
+
+			// Rebuilds the tiles touched by obstacles added or removed since the last update
+			for (auto [e, nav_mesh] : r.view<recast::nav_mesh>().each()) {
+				auto & tile_cache = nav_mesh.tile_cache;
+				if (!tile_cache.ptr)
+					continue;
+
+				std::vector<dtObstacleRef> removed_obstacles;
+				if (tile_cache.removed_obstacles) {
+					const std::lock_guard removal_lock(tile_cache.removed_obstacles->mutex);
+					std::swap(removed_obstacles, tile_cache.removed_obstacles->refs);
+				}
+
+				if (!tile_cache.pending_changes && removed_obstacles.empty())
+					continue;
+
+				// Path queries read the tiles being rebuilt
+				const std::unique_lock lock(*nav_mesh.tiles_mutex);
+
+				for (const auto ref : removed_obstacles) {
+					kengine_logf(r, verbose, log_category, "Removing obstacle from {}", e);
+					tile_cache.ptr->removeObstacle(ref);
+				}
+
+				bool up_to_date = true;
+				tile_cache.ptr->update(delta_time, nav_mesh.ptr.get(), &up_to_date);
+
+				// Rebuilt tiles invalidate the polygon references in cached paths
+				if (nav_mesh.paths)
+					nav_mesh.paths->clear();
+				tile_cache.pending_changes = !up_to_date;
+			}
+		}
+
 		static void remove_old_agents(entt::registry & r) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Removing old agents");
@@ -96,8 +208,8 @@ namespace kengine::pathfinding::recast {
 			ret.environment_scale = environment_transform.bounding_box.size;
 			if (model_transform)
 				ret.environment_scale *= model_transform->bounding_box.size;
-			ret.model_to_world = glm::get_model_matrix(environment_transform, model_transform);
-			ret.world_to_model = ::glm::inverse(ret.model_to_world);
+			ret.model_to_world = glm::get_world_matrix(environment, environment_transform, model_transform);
+			ret.world_to_model = glm::get_inverse_world_matrix(environment, environment_transform, model_transform);
 			return ret;
 		}
 
@@ -134,12 +246,14 @@ namespace kengine::pathfinding::recast {
 
 			crowd = &e.emplace<recast::crowd>();
 			crowd->ptr.reset(dtAllocCrowd());
+			crowd->active_agents.resize(KENGINE_RECAST_MAX_AGENTS);
+			crowd->agent_states.resize(KENGINE_RECAST_MAX_AGENTS);
 			crowd->ptr->init(KENGINE_RECAST_MAX_AGENTS, nav_mesh->ptr->getParams()->tileWidth, nav_mesh->ptr.get());
 
 			return crowd;
 		}
 
-		static void attach_agent_component(entt::handle e, const object_info & object_info, const crowd & crowd, entt::entity crowd_id) noexcept {
+		static void attach_agent_component(entt::handle e, const object_info & object_info, crowd & crowd, entt::entity crowd_id) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(*e.registry(), very_verbose, log_category, "Attaching agent component to {} (crowd {})", e, crowd_id);
 
@@ -156,6 +270,15 @@ namespace kengine::pathfinding::recast {
 
 			const auto idx = crowd.ptr->addAgent(object_info.object_in_nav_mesh.position.raw, &params);
 			kengine_assert(*e.registry(), idx >= 0);
+			if (idx < 0)
+				return;
+
+			// Position and params were just set, but the agent still needs a target
+			auto & state = crowd.agent_states[idx];
+			state = {};
+			state.size_in_nav_mesh = object_info.object_in_nav_mesh.size;
+			state.max_speed = object_info.max_speed;
+			state.position_in_world = e.get<core::transform>().bounding_box.position;
 
 			auto & agent = e.emplace<recast::agent>();
 			agent.index = idx;
@@ -205,44 +328,84 @@ namespace kengine::pathfinding::recast {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Updating crowds");
 
+			// Make sure storages exist before crowd updates look them up in parallel
+			r.storage<core::transform>();
+			r.storage<physics::inertia>();
+			r.storage<pathfinding::navigation>();
+			r.storage<recast::agent>();
+
 			const auto view = r.view<crowd>();
-			std::for_each(std::execution::par_unseq, putils_range(view), [&](entt::entity environment) noexcept {
+
+			// Environments' cached world matrices may need to be emplaced, which can't be done in parallel
+			for (const auto environment : view)
+				get_environment_info({ r, environment });
+
+			std::for_each(std::execution::par, putils_range(view), [&](entt::entity environment) noexcept {
 				const putils::scoped_thread_name thread_name("Recast crowd updater");
-				const auto & [crowd] = view.get(environment);
+				auto & [crowd] = view.get(environment);
 				update_crowd(delta_time, { r, environment }, crowd);
 			});
 		}
 
-		static void update_crowd(float delta_time, entt::handle environment, const crowd & crowd) noexcept {
+		struct crowd_update_context {
+			entt::registry & r;
+			const pathfinding::nav_mesh & params;
+			const recast::nav_mesh & recast_nav_mesh;
+			const environment_info & environment;
+			recast::crowd & recast_crowd;
+			entt::storage_for_t<core::transform> & transforms;
+			entt::storage_for_t<physics::inertia> & inertias;
+			const entt::storage_for_t<pathfinding::navigation> & navigations;
+			const entt::storage_for_t<recast::agent> & agents;
+		};
+
+		static void update_crowd(float delta_time, entt::handle environment, crowd & crowd) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(*environment.registry(), very_verbose, log_category, "Updating crowd for {}", environment);
 
-			const auto & nav_mesh = model::get<recast::nav_mesh>(environment);
+			auto & r = *environment.registry();
 			const auto environment_info = get_environment_info(environment);
 
-			static dtCrowdAgent * active_agents[KENGINE_RECAST_MAX_AGENTS];
-
-			const auto nb_agents = crowd.ptr->getActiveAgents(active_agents, (int)putils::lengthof(active_agents));
-
-			auto & r = *environment.registry();
+			const crowd_update_context context{
+				.r = r,
+				.params = model::get<pathfinding::nav_mesh>(environment),
+				.recast_nav_mesh = model::get<recast::nav_mesh>(environment),
+				.environment = environment_info,
+				.recast_crowd = crowd,
+				.transforms = r.storage<core::transform>(),
+				.inertias = r.storage<physics::inertia>(),
+				.navigations = r.storage<pathfinding::navigation>(),
+				.agents = r.storage<recast::agent>()
+			};
 
-			// Overwrite agent with user-updated components
-			for (int i = 0; i < nb_agents; ++i) {
-				const auto agent = active_agents[i];
-				const auto e = entt::entity(intptr_t(agent->params.userData));
-				const auto & [transform, navigation] = r.get<core::transform, pathfinding::navigation>(e);
-				write_to_agent({ r, e }, transform, navigation, environment_info, nav_mesh, crowd);
+			const auto nb_agents = crowd.ptr->getActiveAgents(crowd.active_agents.data(), (int)crowd.active_agents.size());
+			const std::span<dtCrowdAgent *> active_agents{ crowd.active_agents.data(), size_t(nb_agents) };
+
+			// Overwrite agents with user-updated components. Agents are split into one chunk per thread, so that each chunk can borrow its own nav mesh query
+			const auto chunk_count = std::min<size_t>(active_agents.size(), std::max(std::thread::hardware_concurrency(), 1u));
+			if (chunk_count > 0) {
+				const auto chunk_size = (active_agents.size() + chunk_count - 1) / chunk_count;
+				std::vector<size_t> chunk_indices(chunk_count);
+				std::iota(chunk_indices.begin(), chunk_indices.end(), 0);
+				std::for_each(std::execution::par, putils_range(chunk_indices), [&](size_t chunk_index) noexcept {
+					const auto first = chunk_index * chunk_size;
+					const auto last = std::min(first + chunk_size, active_agents.size());
+					write_to_agents(context, active_agents.subspan(first, last - first));
+				});
 			}
 
 			crowd.ptr->update(delta_time, nullptr);
 
 			// Update user components with agent info
-			for (int i = 0; i < nb_agents; ++i) {
-				const auto agent = active_agents[i];
+			std::for_each(std::execution::par_unseq, putils_range(active_agents), [&](const dtCrowdAgent * agent) noexcept {
 				const auto e = entt::entity(intptr_t(agent->params.userData));
-				const auto & [transform, physics] = r.get<core::transform, physics::inertia>(e);
-				read_from_agent(transform, physics, *agent, environment_info);
-			}
+				auto & transform = context.transforms.get(e);
+				read_from_agent(transform, context.inertias.get(e), *agent, environment_info);
+
+				// Remember where we put the agent, to detect when the user moves it
+				const auto & recast_agent = context.agents.get(e);
+				crowd.agent_states[recast_agent.index].position_in_world = transform.bounding_box.position;
+			});
 		}
 
 		static void read_from_agent(core::transform & transform, physics::inertia & physics, const dtCrowdAgent & agent, const environment_info & environment_info) noexcept {
@@ -252,45 +415,68 @@ namespace kengine::pathfinding::recast {
 			transform.bounding_box.position = glm::convert_to_referencial(agent.npos, environment_info.model_to_world);
 		}
 
-		static void write_to_agent(entt::handle e, const core::transform & transform, const navigation & navigation, const environment_info & environment_info, const nav_mesh & nav_mesh, const crowd & crowd) noexcept {
+		static void write_to_agents(const crowd_update_context & context, std::span<dtCrowdAgent * const> agents) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(*e.registry(), very_verbose, log_category, "Writing to agent {}", e);
 
-			const auto object_info = get_object_info(environment_info, transform, navigation);
-			update_agent_component(e, object_info, crowd);
+			// Only borrowed if an agent needs a new target
+			std::optional<borrowed_query> query;
 
-			const auto destination_in_model = glm::convert_to_referencial(navigation.destination, environment_info.world_to_model);
-			const auto search_extents = putils::point3f{ navigation.search_distance, navigation.search_distance, navigation.search_distance } / environment_info.environment_scale;
-			update_destination(e, nav_mesh, crowd, destination_in_model, search_extents);
-		}
+			for (const auto agent : agents) {
+				const auto e = entt::entity(intptr_t(agent->params.userData));
+				const auto & transform = context.transforms.get(e);
+				const auto & navigation = context.navigations.get(e);
+				auto & state = context.recast_crowd.agent_states[context.agents.get(e).index];
+
+				const auto object_info = get_object_info(context.environment, transform, navigation);
+				if (object_info.object_in_nav_mesh.size != state.size_in_nav_mesh || object_info.max_speed != state.max_speed) {
+					fill_crowd_agent_params(agent->params, object_info);
+					state.size_in_nav_mesh = object_info.object_in_nav_mesh.size;
+					state.max_speed = object_info.max_speed;
+				}
 
-		static void update_agent_component(entt::handle e, const object_info & object_info, const crowd & crowd) noexcept {
-			KENGINE_PROFILING_SCOPE;
-			kengine_logf(*e.registry(), very_verbose, log_category, "Updating agent component for {}", e);
+				if (transform.bounding_box.position != state.position_in_world) {
+					kengine_logf(context.r, very_verbose, log_category, "Agent {} was moved", e);
+					memcpy(agent->npos, object_info.object_in_nav_mesh.position.raw, sizeof(float[3]));
+					memcpy(agent->nvel, context.inertias.get(e).movement.raw, sizeof(float[3]));
+					state.position_in_world = transform.bounding_box.position;
+				}
 
-			const auto & agent = e.get<recast::agent>();
-			const auto editableAgent = crowd.ptr->getEditableAgent(agent.index);
-			fill_crowd_agent_params(editableAgent->params, object_info);
-			memcpy(editableAgent->npos, object_info.object_in_nav_mesh.position.raw, sizeof(float[3]));
-			memcpy(editableAgent->nvel, e.get<physics::inertia>().movement.raw, sizeof(float[3]));
+				const auto destination_in_model = glm::convert_to_referencial(navigation.destination, context.environment.world_to_model);
+				const auto search_extents = putils::point3f{ navigation.search_distance, navigation.search_distance, navigation.search_distance } / context.environment.environment_scale;
+				if (state.has_target && destination_in_model == state.destination_in_nav_mesh && search_extents == state.search_extents)
+					continue;
+
+				if (!query) {
+					query.emplace(context.r, context.params, context.recast_nav_mesh);
+					if (query->ptr == nullptr)
+						return;
+				}
+
+				state.destination_in_nav_mesh = destination_in_model;
+				state.search_extents = search_extents;
+				state.has_target = update_destination({ context.r, e }, *query->ptr, context.recast_crowd, destination_in_model, search_extents);
+			}
 		}
 
-		static void update_destination(entt::handle e, const nav_mesh & nav_mesh, const crowd & crowd, const putils::point3f & destination_in_model, const putils::point3f & search_extents) noexcept {
+		static bool update_destination(entt::handle e, const dtNavMeshQuery & query, const crowd & crowd, const putils::point3f & destination_in_model, const putils::point3f & search_extents) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(*e.registry(), very_verbose, log_category, "Updating destination for {}", e);
 
 			static const dtQueryFilter filter;
 			dtPolyRef nearest_poly;
 			float nearest_point[3];
-			const auto status = nav_mesh.nav_mesh_query->findNearestPoly(destination_in_model.raw, search_extents.raw, &filter, &nearest_poly, nearest_point);
+			const auto status = query.findNearestPoly(destination_in_model.raw, search_extents.raw, &filter, &nearest_poly, nearest_point);
 			if (dtStatusFailed(status) || nearest_poly == 0) {
 				kengine_log(*e.registry(), very_verbose, log_category, "Failed to find nearest poly to destination");
-				return;
+				return false;
 			}
 
 			const auto & agent = e.get<recast::agent>();
-			if (!crowd.ptr->requestMoveTarget(agent.index, nearest_poly, nearest_point))
+			if (!crowd.ptr->requestMoveTarget(agent.index, nearest_poly, nearest_point)) {
 				kengine_assert_failed(*e.registry(), "[Recast] Failed to request move");
+				return false;
+			}
+			return true;
 		}
 	};
 
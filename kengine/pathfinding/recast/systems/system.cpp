@@ -1,6 +1,9 @@
 #include "system.hpp"
 #include "common.hpp"
 
+// stl
+#include <optional>
+
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
@@ -9,16 +12,31 @@
 #include "putils/forward_to.hpp"
 
 // kengine
+#include "kengine/async/data/result.hpp"
+#include "kengine/async/data/task.hpp"
+#include "kengine/async/helpers/start_task.hpp"
 #include "kengine/config/data/configurable.hpp"
 #include "kengine/core/data/name.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/data/transform.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/glm/data/world_matrix.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/helpers/declare_access.hpp"
+#include "kengine/model/data/instance.hpp"
 #include "kengine/pathfinding/data/nav_mesh.hpp"
+#include "kengine/pathfinding/data/navigation.hpp"
+#include "kengine/pathfinding/data/obstacle.hpp"
+#include "kengine/pathfinding/functions/get_path.hpp"
+#include "kengine/pathfinding/functions/get_paths.hpp"
 #include "kengine/pathfinding/recast/data/agent.hpp"
 #include "kengine/pathfinding/recast/data/crowd.hpp"
 #include "kengine/pathfinding/recast/data/nav_mesh.hpp"
+#include "kengine/pathfinding/recast/data/obstacle.hpp"
+#include "kengine/physics/data/inertia.hpp"
+#include "kengine/render/data/asset.hpp"
+#include "kengine/render/data/model_data.hpp"
 
 #include "config.hpp"
 
@@ -29,7 +47,7 @@ namespace kengine::pathfinding::recast {
 		entt::registry & r;
 
 		struct processed {};
-		kengine::new_entity_processor<processed, render::model_data, pathfinding::nav_mesh> processor{
+		kengine::reactive_entity_processor<processed, render::model_data, pathfinding::nav_mesh> processor{
 			r,
 			[this](auto &&... args) noexcept {
 				build_recast_component(r, FWD(args)...);
@@ -47,6 +65,13 @@ namespace kengine::pathfinding::recast {
 			e.emplace<kengine::config::configurable>();
 			g_config = &e.emplace<config>();
 
+			main_loop::declare_access(
+				e,
+				main_loop::reads<config, core::name, model::instance, render::asset, render::model_data, pathfinding::nav_mesh, navigation, pathfinding::obstacle>{},
+				main_loop::writes<processed, nav_mesh, agent, crowd, obstacle, core::transform, physics::inertia, get_path, get_paths, glm::world_matrix, async::task, async::pooled_result<std::optional<nav_mesh>>>{}
+			);
+
+			kengine::async::prepare_tasks<std::optional<nav_mesh>>(r);
 			processor.process();
 		}
 
@@ -66,6 +91,7 @@ namespace kengine::pathfinding::recast {
 		system::processed,
 		agent,
 		crowd,
-		nav_mesh
+		nav_mesh,
+		obstacle
 	)
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+// stl
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/model/data/instance.hpp"
+#include "kengine/pathfinding/data/nav_mesh.hpp"
+#include "kengine/pathfinding/data/navigation.hpp"
+#include "kengine/pathfinding/recast/data/nav_mesh.hpp"
+#include "kengine/pathfinding/recast/systems/system.hpp"
+#include "kengine/physics/data/inertia.hpp"
+#include "kengine/render/data/model_data.hpp"
+
+// Flat ground on which agents walk
+static constexpr float ground_size = 100.f;
+static const float ground_vertices[] = {
+	0.f, 0.f, 0.f,
+	ground_size, 0.f, 0.f,
+	ground_size, 0.f, ground_size,
+	0.f, 0.f, ground_size
+};
+static const unsigned int ground_indices[] = { 0, 2, 1, 0, 3, 2 };
+
+// Crowds are limited to KENGINE_RECAST_MAX_AGENTS, so agents are spread across environments sharing the same navmesh
+static constexpr size_t agents_per_environment = 1'000;
+
+// Benchmark measuring crowd updates. Disabled by default, run it with --gtest_also_run_disabled_tests
+static double get_milliseconds_per_update(size_t agent_count) noexcept {
+	entt::registry r;
+	const auto system = kengine::pathfinding::recast::add_system(r);
+	const auto & execute = r.get<kengine::main_loop::execute>(system);
+	constexpr auto delta_time = 1.f / 60.f;
+
+	const auto model = r.create();
+	auto & model_data = r.emplace<kengine::render::model_data>(model);
+	model_data.vertex_attributes.push_back({ "position", 0, putils::meta::type<float[3]>::index });
+	model_data.vertex_size = sizeof(float[3]);
+	model_data.meshes.push_back({
+		.vertices = { 4, sizeof(float[3]), ground_vertices },
+		.indices = { 6, sizeof(unsigned int), ground_indices },
+		.index_type = putils::meta::type<unsigned int>::index
+	});
+	r.emplace<kengine::pathfinding::nav_mesh>(model).cell_size = .5f;
+
+	// The navmesh is built asynchronously
+	const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+	while (!r.all_of<kengine::pathfinding::recast::nav_mesh>(model) && std::chrono::steady_clock::now() < timeout) {
+		execute(delta_time);
+		std::this_thread::yield();
+	}
+	if (!r.all_of<kengine::pathfinding::recast::nav_mesh>(model))
+		return -1.;
+
+	const auto environment_count = (agent_count + agents_per_environment - 1) / agents_per_environment;
+	for (size_t environment_index = 0; environment_index < environment_count; ++environment_index) {
+		const auto environment = r.create();
+		r.emplace<kengine::core::transform>(environment);
+		r.emplace<kengine::model::instance>(environment, model);
+
+		// Agents walk across the ground, towards the opposite side
+		const auto side = size_t(std::sqrt(float(agents_per_environment))) + 1;
+		const auto spacing = (ground_size - 2.f) / float(side);
+		for (size_t i = 0; i < agents_per_environment && environment_index * agents_per_environment + i < agent_count; ++i) {
+			const auto e = r.create();
+			auto & transform = r.emplace<kengine::core::transform>(e);
+			transform.bounding_box.position = { 1.f + float(i % side) * spacing, 0.f, 1.f + float(i / side) * spacing };
+			transform.bounding_box.size = { .5f, 1.f, .5f };
+			r.emplace<kengine::physics::inertia>(e);
+
+			auto & navigation = r.emplace<kengine::pathfinding::navigation>(e);
+			navigation.environment = environment;
+			navigation.destination = { ground_size - transform.bounding_box.position.x, 0.f, ground_size - transform.bounding_box.position.z };
+		}
+	}
+
+	// Let the system create the agents and give them their targets
+	for (int i = 0; i < 10; ++i)
+		execute(delta_time);
+
+	constexpr size_t updates = 20;
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < updates; ++i)
+		execute(delta_time);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	return double(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000. / double(updates);
+}
+
+TEST(recast, DISABLED_benchmark_crowd_update) {
+	for (const size_t agent_count : { 1'000, 5'000, 10'000 })
+		testing::Test::RecordProperty("crowd_update_" + std::to_string(agent_count), std::to_string(get_milliseconds_per_update(agent_count)));
+}
@@ -8,6 +8,10 @@ namespace kengine::physics::bullet {
 		bool enable_debug = false;
 		bool editor_mode = false;
 		float gravity = 1.f;
+
+		bool multithreaded = false;
+		float fixed_time_step = 1.f / 60.f;
+		int max_sub_steps = 1;
 	};
 }
 
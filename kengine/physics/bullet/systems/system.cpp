@@ -1,8 +1,16 @@
 #include "system.hpp"
 
 // stl
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 // entt
 #include <entt/entity/handle.hpp>
@@ -16,7 +24,11 @@
 
 // bullet
 #include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <LinearMath/btThreads.h>
 
 // magic_enum
 #include <magic_enum.hpp>
@@ -32,20 +44,26 @@
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
 #include "kengine/core/data/name.hpp"
 #include "kengine/core/data/transform.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
+#include "kengine/core/helpers/thread_pool.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
-#include "kengine/glm/helpers/get_model_matrix.hpp"
+#include "kengine/glm/data/world_matrix.hpp"
+#include "kengine/glm/helpers/get_world_matrix.hpp"
 #include "kengine/model/data/instance.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/helpers/declare_access.hpp"
+#include "kengine/physics/data/collision_events.hpp"
 #include "kengine/physics/data/model_collider.hpp"
 #include "kengine/physics/data/inertia.hpp"
 #include "kengine/physics/functions/on_collision.hpp"
 #include "kengine/physics/functions/query_position.hpp"
 #include "kengine/physics/kinematic/data/kinematic.hpp"
 #include "kengine/render/data/debug_graphics.hpp"
+#include "kengine/skeleton/data/bone_index.hpp"
 #include "kengine/skeleton/data/bone_names.hpp"
 #include "kengine/skeleton/data/bone_matrices.hpp"
+#include "kengine/skeleton/helpers/build_bone_index.hpp"
 #include "kengine/skeleton/helpers/get_bone_matrix.hpp"
 
 #include "config.hpp"
@@ -71,28 +89,130 @@ namespace putils {
 namespace kengine::physics::bullet {
 	static constexpr auto log_category = "bullet";
 
+#if BT_THREADSAFE
+	// Runs Bullet's parallel loops on the core thread pool, instead of on threads of its own which would compete with it
+	struct thread_pool_task_scheduler : btITaskScheduler {
+		// The thread calling stepSimulation takes part in the loops
+		int thread_count = std::min(int(get_thread_pool().get_thread_count()) + 1, BT_MAX_THREAD_COUNT);
+
+		thread_pool_task_scheduler() noexcept
+			: btITaskScheduler("kengine thread pool") {}
+
+		int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+		int getNumThreads() const override { return thread_count; }
+		void setNumThreads(int num_threads) override { thread_count = std::clamp(num_threads, 1, BT_MAX_THREAD_COUNT); }
+
+		void parallelFor(int begin, int end, int grain_size, const btIParallelForBody & body) override {
+			KENGINE_PROFILING_SCOPE;
+			run_chunks(begin, end, grain_size, [&](int, int chunk_begin, int chunk_end) noexcept {
+				body.forLoop(chunk_begin, chunk_end);
+			});
+		}
+
+		btScalar parallelSum(int begin, int end, int grain_size, const btIParallelSumBody & body) override {
+			KENGINE_PROFILING_SCOPE;
+			std::vector<btScalar> sums(get_chunk_count(begin, end, grain_size), btScalar(0));
+			run_chunks(begin, end, grain_size, [&](int chunk, int chunk_begin, int chunk_end) noexcept {
+				sums[chunk] = body.sumLoop(chunk_begin, chunk_end);
+			});
+
+			btScalar ret = 0;
+			for (const auto sum : sums)
+				ret += sum;
+			return ret;
+		}
+
+		// No more chunks than threads, but none smaller than grain_size
+		int get_chunk_size(int begin, int end, int grain_size) const noexcept {
+			return std::max({ grain_size, 1, (end - begin + thread_count - 1) / thread_count });
+		}
+
+		int get_chunk_count(int begin, int end, int grain_size) const noexcept {
+			if (end <= begin)
+				return 0;
+			const auto chunk_size = get_chunk_size(begin, end, grain_size);
+			return (end - begin + chunk_size - 1) / chunk_size;
+		}
+
+		template<typename Func>
+		void run_chunks(int begin, int end, int grain_size, Func && func) noexcept {
+			const auto chunk_size = get_chunk_size(begin, end, grain_size);
+			const auto chunk_count = get_chunk_count(begin, end, grain_size);
+
+			std::atomic<int> next_chunk = 0;
+			const auto run_remaining_chunks = [&]() noexcept {
+				for (auto chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) {
+					const auto chunk_begin = begin + chunk * chunk_size;
+					func(chunk, chunk_begin, std::min(chunk_begin + chunk_size, end));
+				}
+			};
+
+			// Helpers reference this stack frame, so it can only be left once they've all returned
+			auto & pool = get_thread_pool();
+			std::atomic<int> running_helpers = std::max(chunk_count - 1, 0);
+			for (int i = 1; i < chunk_count; ++i)
+				pool.push(
+					[&]() noexcept {
+						run_remaining_chunks();
+						--running_helpers;
+					},
+					thread_pool::priority::high
+				);
+
+			run_remaining_chunks();
+
+			// Helpers which haven't started yet may be queued behind other tasks, so run them here rather than wait for a worker
+			while (running_helpers > 0)
+				if (!pool.run_pending_task(thread_pool::priority::high))
+					std::this_thread::yield();
+		}
+	};
+#endif
+
 	struct system {
 		entt::registry & r;
 		const config * cfg = nullptr;
+		collision_events * events = nullptr;
 
 		struct processed {};
-		kengine::new_entity_processor<processed, core::transform, inertia, model::instance> processor{ r, putils_forward_to_this(add_or_update_bullet_data) };
+		kengine::reactive_entity_processor<processed, core::transform, inertia, model::instance> processor{ r, putils_forward_to_this(add_or_update_bullet_data) };
+
+		// Reverse index from model entities to their instances, so that changes to a model don't require scanning all instances
+		std::unordered_map<entt::entity, std::vector<entt::entity>> instances_by_model;
+
+		// Position of each instance in instances_by_model, so that it can be unindexed without scanning all models
+		struct instance_slot {
+			entt::entity model_entity;
+			size_t index;
+		};
+		std::unordered_map<entt::entity, instance_slot> instance_slots;
 
-		const entt::scoped_connection connections[6] = {
-			r.on_construct<model_collider>().connect<&system::update_all_instances>(this),
-			r.on_update<model_collider>().connect<&system::update_all_instances>(this),
+		// Bone of each of a model's colliders, resolved once so that updating skeletons doesn't require looking bones up by name
+		struct collider_bones {
+			std::vector<std::optional<skeleton::bone_indices>> bones;
+		};
+
+		const entt::scoped_connection connections[10] = {
+			r.on_construct<model_collider>().connect<&system::rebuild_all_instances>(this),
+			r.on_update<model_collider>().connect<&system::rebuild_all_instances>(this),
 			r.on_construct<skeleton::bone_names>().connect<&system::update_all_instances>(this),
 			r.on_update<skeleton::bone_names>().connect<&system::update_all_instances>(this),
+			r.on_construct<skeleton::bone_index>().connect<&system::update_all_instances>(this),
+			r.on_update<skeleton::bone_index>().connect<&system::update_all_instances>(this),
 			r.on_construct<skeleton::bone_matrices>().connect<&system::on_skeleton_updated>(this),
 			r.on_update<skeleton::bone_matrices>().connect<&system::on_skeleton_updated>(this),
+			r.on_update<model::instance>().connect<&system::on_instance_updated>(this),
+			r.on_destroy<model::instance>().connect<&system::on_instance_destroyed>(this),
 		};
 
 		btDefaultCollisionConfiguration collisionConfiguration;
-		btCollisionDispatcher dispatcher{ &collisionConfiguration };
-		std::unique_ptr<btDbvtBroadphase> overlappingPairCache = std::make_unique<btDbvtBroadphase>(); // Had to make this a ptr for gcc, otherwise failed to instantiate std::is_constructible
-		btSequentialImpulseConstraintSolver solver;
+		std::unique_ptr<btCollisionDispatcher> dispatcher;
+		std::unique_ptr<btDbvtBroadphase> overlappingPairCache;
+		std::unique_ptr<btConstraintSolverPoolMt> solver_pool; // Only used by the multithreaded world
+		std::unique_ptr<btSequentialImpulseConstraintSolver> solver;
 
-		btDiscreteDynamicsWorld dynamics_world{ &dispatcher, overlappingPairCache.get(), &solver, &collisionConfiguration };
+		std::unique_ptr<btDiscreteDynamicsWorld> dynamics_world;
+		bool multithreaded_requested = false;
 
 		struct bullet_data {
 			struct motion_state : public btMotionState {
@@ -121,7 +241,7 @@ namespace kengine::physics::bullet {
 			~bullet_data() noexcept {
 				KENGINE_PROFILING_SCOPE;
 				if (state)
-					state->owning_system->dynamics_world.removeRigidBody(body.get());
+					state->owning_system->dynamics_world->removeRigidBody(body.get());
 			}
 
 			bullet_data() noexcept = default;
@@ -140,6 +260,16 @@ namespace kengine::physics::bullet {
 			e.emplace<core::name>("Physics");
 			e.emplace<kengine::config::configurable>();
 			cfg = &e.emplace<config>();
+			events = &e.emplace<collision_events>();
+
+			// on_collision callbacks are called from execute, so they may only access these components. Systems which need more should consume collision_events instead
+			main_loop::declare_access(
+				e,
+				main_loop::reads<config, model::instance, model_collider, kinematic::kinematic, skeleton::bone_matrices, skeleton::bone_names, skeleton::bone_index, kengine::physics::on_collision>{},
+				main_loop::writes<core::transform, inertia, bullet_data, processed, collider_bones, collision_events, render::debug_graphics, glm::world_matrix>{}
+			);
+
+			create_world(cfg->multithreaded);
 
 			processor.process();
 		}
@@ -164,20 +294,79 @@ namespace kengine::physics::bullet {
 				r.remove<bullet_data>(e);
 			}
 
+			if (cfg->multithreaded != multithreaded_requested)
+				create_world(cfg->multithreaded);
+
 			kengine_log(r, very_verbose, log_category, "Updating gravity");
-			dynamics_world.setGravity({ 0.f, -cfg->gravity, 0.f });
+			dynamics_world->setGravity({ 0.f, -cfg->gravity, 0.f });
 
 			kengine_log(r, very_verbose, log_category, "Stepping simulation");
-			dynamics_world.stepSimulation(delta_time);
+			dynamics_world->stepSimulation(delta_time, cfg->max_sub_steps, cfg->fixed_time_step);
 			detect_collisions();
 
 #ifndef KENGINE_NDEBUG
 			drawer.cleanup();
-			dynamics_world.setDebugDrawer(cfg->enable_debug ? &drawer : nullptr);
-			dynamics_world.debugDrawWorld();
+			dynamics_world->setDebugDrawer(cfg->enable_debug ? &drawer : nullptr);
+			dynamics_world->debugDrawWorld();
+#endif
+		}
+
+		static btITaskScheduler * get_task_scheduler() noexcept {
+#if BT_THREADSAFE
+			// Bullet's task scheduler is global, so it's shared by all systems
+			static thread_pool_task_scheduler scheduler;
+			static const bool installed = [] {
+				btSetTaskScheduler(&scheduler);
+				return true;
+			}();
+			(void)installed;
+			return &scheduler;
+#else
+			return nullptr;
 #endif
 		}
 
+		void create_world(bool multithreaded) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, log, log_category, "Creating {} world", multithreaded ? "multithreaded" : "single-threaded");
+
+			multithreaded_requested = multithreaded;
+
+			// Bodies are moved over to the new world
+			const auto bodies = r.view<bullet_data>();
+			if (dynamics_world)
+				for (const auto & [e, bullet] : bodies.each())
+					dynamics_world->removeRigidBody(bullet.body.get());
+
+			dynamics_world = nullptr;
+			solver = nullptr;
+			solver_pool = nullptr;
+			overlappingPairCache = nullptr;
+			dispatcher = nullptr;
+
+			const auto scheduler = multithreaded ? get_task_scheduler() : nullptr;
+			if (multithreaded && !scheduler) {
+				kengine_log(r, warning, log_category, "Bullet was built without multithreading support, falling back to a single-threaded world");
+				multithreaded = false;
+			}
+
+			overlappingPairCache = std::make_unique<btDbvtBroadphase>();
+			if (multithreaded) {
+				dispatcher = std::make_unique<btCollisionDispatcherMt>(&collisionConfiguration);
+				solver_pool = std::make_unique<btConstraintSolverPoolMt>(scheduler->getNumThreads());
+				solver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+				dynamics_world = std::make_unique<btDiscreteDynamicsWorldMt>(dispatcher.get(), overlappingPairCache.get(), solver_pool.get(), solver.get(), &collisionConfiguration);
+			}
+			else {
+				dispatcher = std::make_unique<btCollisionDispatcher>(&collisionConfiguration);
+				solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+				dynamics_world = std::make_unique<btDiscreteDynamicsWorld>(dispatcher.get(), overlappingPairCache.get(), solver.get(), &collisionConfiguration);
+			}
+
+			for (const auto & [e, bullet] : bodies.each())
+				dynamics_world->addRigidBody(bullet.body.get());
+		}
+
 		using collision_shape_map = std::map<putils::point3f, std::unique_ptr<btCollisionShape>>;
 		template<putils::invocable<btCollisionShape *()> Func>
 		btCollisionShape * get_collision_shape(collision_shape_map & shapes, const putils::vec3f & size, Func && creator) noexcept {
@@ -196,12 +385,74 @@ namespace kengine::physics::bullet {
 			KENGINE_PROFILING_SCOPE;
 
 			if (r.all_of<core::transform, inertia, model::instance>(e))
+				update_instance(e, r.get<core::transform>(e), r.get<inertia>(e), r.get<model::instance>(e));
+		}
+
+		void on_instance_updated(entt::registry & r, entt::entity e) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			// The instance may now point to a different model
+			unindex_instance(e);
+			if (r.all_of<core::transform, inertia, model::instance, processed>(e))
 				add_or_update_bullet_data(e, r.get<core::transform>(e), r.get<inertia>(e), r.get<model::instance>(e));
 		}
 
+		void on_instance_destroyed(entt::registry & r, entt::entity e) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			unindex_instance(e);
+		}
+
+		void index_instance(entt::entity e, entt::entity model_entity) noexcept {
+			if (const auto it = instance_slots.find(e); it != instance_slots.end()) {
+				if (it->second.model_entity == model_entity)
+					return;
+				unindex_instance(e);
+			}
+
+			auto & instances = instances_by_model[model_entity];
+			instance_slots.emplace(e, instance_slot{ model_entity, instances.size() });
+			instances.push_back(e);
+		}
+
+		void unindex_instance(entt::entity e) noexcept {
+			const auto it = instance_slots.find(e);
+			if (it == instance_slots.end())
+				return;
+
+			// Swap and pop, then fix the index of the instance that was moved
+			auto & instances = instances_by_model[it->second.model_entity];
+			const auto index = it->second.index;
+			instances[index] = instances.back();
+			instances.pop_back();
+			if (index < instances.size())
+				instance_slots[instances[index]].index = index;
+
+			instance_slots.erase(it);
+		}
+
+		template<typename Func>
+		void for_each_instance(entt::entity model_entity, Func && func) noexcept {
+			const auto it = instances_by_model.find(model_entity);
+			if (it == instances_by_model.end())
+				return;
+
+			// Iterate by index, as func may re-index instances
+			const auto & instances = it->second;
+			for (size_t i = 0; i < instances.size();) {
+				const auto e = instances[i];
+				if (r.all_of<core::transform, inertia, model::instance>(e))
+					func(e, r.get<core::transform>(e), r.get<inertia>(e), r.get<model::instance>(e));
+				// If e was unindexed, another instance was swapped into its slot
+				if (i < instances.size() && instances[i] == e)
+					++i;
+			}
+		}
+
 		void add_or_update_bullet_data(entt::entity e, core::transform & transform, inertia & inertia, const model::instance & instance) noexcept {
 			KENGINE_PROFILING_SCOPE;
 
+			index_instance(e, instance.model);
+
 			if (!r.all_of<model_collider>(instance.model)) {
 				kengine_logf(r, verbose, log_category, "Not adding bullet_data to {} because its model doesn't have a model_collider", e);
 				return;
@@ -218,13 +469,43 @@ namespace kengine::physics::bullet {
 			add_bullet_data(e, transform, inertia, instance.model);
 		}
 
+		// Updates existing bullet_data in place, only re-creating it if the collider topology changed
+		void update_instance(entt::entity e, core::transform & transform, inertia & inertia, const model::instance & instance) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto comp = r.try_get<bullet_data>(e);
+			const auto model_collider = r.try_get<physics::model_collider>(instance.model);
+			if (!comp || !model_collider || comp->shape->getNumChildShapes() != int(model_collider->colliders.size())) {
+				add_or_update_bullet_data(e, transform, inertia, instance);
+				return;
+			}
+
+			kengine_logf(r, very_verbose, log_category, "Updating bullet_data in place for {}", e);
+			update_child_transforms(*comp, transform, r.try_get<skeleton::bone_matrices>(e), instance.model);
+			// Moving child shapes changes the compound shape's inertia
+			update_mass_properties(*comp, inertia);
+		}
+
+		void rebuild_all_instances(entt::registry & r, entt::entity model_entity) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, verbose, log_category, "Rebuilding all instances of {}", model_entity);
+
+			r.remove<collider_bones>(model_entity);
+
+			for_each_instance(model_entity, [this](entt::entity e, core::transform & transform, inertia & inertia, const model::instance & instance) {
+				add_or_update_bullet_data(e, transform, inertia, instance);
+			});
+		}
+
 		void update_all_instances(entt::registry & r, entt::entity model_entity) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(r, verbose, log_category, "Updating all instances of {}", model_entity);
 
-			for (const auto & [e, transform, inertia, instance] : r.view<core::transform, inertia, model::instance>().each())
-				if (instance.model == model_entity)
-					add_or_update_bullet_data(e, transform, inertia, instance);
+			r.remove<collider_bones>(model_entity);
+
+			for_each_instance(model_entity, [this](entt::entity e, core::transform & transform, inertia & inertia, const model::instance & instance) {
+				update_instance(e, transform, inertia, instance);
+			});
 		}
 
 		void add_bullet_data(entt::entity e, core::transform & transform, inertia & inertia, entt::entity model_entity) noexcept {
@@ -240,11 +521,11 @@ namespace kengine::physics::bullet {
 			const auto & model_collider = r.get<kengine::physics::model_collider>(model_entity);
 
 			const auto skeleton = r.try_get<skeleton::bone_matrices>(e);
-			const auto bone_names = r.try_get<skeleton::bone_names>(model_entity);
-			const auto model_transform = r.try_get<core::transform>(model_entity);
+			const auto & bones = get_collider_bones(model_entity);
+			const auto model_matrix = get_model_matrix(model_entity);
 
-			for (const auto & collider : model_collider.colliders)
-				add_shape(comp, collider, transform, skeleton, bone_names, model_transform);
+			for (size_t i = 0; i < model_collider.colliders.size(); ++i)
+				add_shape(comp, model_collider.colliders[i], transform, skeleton, bones.bones[i], model_matrix);
 
 			btVector3 local_inertia{ 0.f, 0.f, 0.f };
 			{
@@ -257,10 +538,10 @@ namespace kengine::physics::bullet {
 			comp.body->setUserIndex(int(e));
 
 			update_bullet_data(e, comp, transform, inertia, model_entity, true);
-			dynamics_world.addRigidBody(comp.body.get());
+			dynamics_world->addRigidBody(comp.body.get());
 		}
 
-		void add_shape(bullet_data & comp, const model_collider::collider & collider, const core::transform & transform, const skeleton::bone_matrices * skeleton, const skeleton::bone_names * bone_names, const core::transform * model_transform) {
+		void add_shape(bullet_data & comp, const model_collider::collider & collider, const core::transform & transform, const skeleton::bone_matrices * skeleton, const std::optional<skeleton::bone_indices> & bone, const ::glm::mat4 & model_matrix) {
 			KENGINE_PROFILING_SCOPE;
 
 			const auto size = collider.transform.bounding_box.size * transform.bounding_box.size;
@@ -298,7 +579,7 @@ namespace kengine::physics::bullet {
 						return;
 				}
 			}
-			comp.shape->addChildShape(to_bullet(transform, collider, skeleton, bone_names, model_transform), shape);
+			comp.shape->addChildShape(to_bullet(transform, collider, skeleton, bone, model_matrix), shape);
 		}
 
 		void update_bullet_data(entt::entity e, bullet_data & comp, const core::transform & transform, inertia & inertia, entt::entity model_entity, bool first = false) noexcept {
@@ -311,10 +592,7 @@ namespace kengine::physics::bullet {
 				comp.body->setLinearVelocity(to_bullet(inertia.movement));
 				comp.body->setAngularVelocity(btVector3{ inertia.pitch, inertia.yaw, inertia.roll });
 
-				btVector3 local_inertia{ 0.f, 0.f, 0.f };
-				if (inertia.mass != 0.f)
-					comp.body->getCollisionShape()->calculateLocalInertia(inertia.mass, local_inertia);
-				comp.body->setMassProps(inertia.mass, local_inertia);
+				update_mass_properties(comp, inertia);
 
 				comp.body->forceActivationState(kinematic ? ISLAND_SLEEPING : ACTIVE_TAG);
 				comp.body->setWorldTransform(to_bullet(transform));
@@ -340,37 +618,183 @@ namespace kengine::physics::bullet {
 
 			inertia.changed = false;
 
-			const auto skeleton = r.try_get<skeleton::bone_matrices>(e);
-			const auto bone_names = r.try_get<skeleton::bone_names>(model_entity);
+			update_child_transforms(comp, transform, r.try_get<skeleton::bone_matrices>(e), model_entity);
+		}
 
-			if (skeleton && bone_names) {
-				const auto model_transform = r.try_get<core::transform>(model_entity);
-				int i = 0;
-				for (const auto & collider : r.get<model_collider>(model_entity).colliders) {
-					comp.shape->updateChildTransform(i, to_bullet(transform, collider, skeleton, bone_names, model_transform));
-					++i;
+		void update_mass_properties(bullet_data & comp, const inertia & inertia) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			btVector3 local_inertia{ 0.f, 0.f, 0.f };
+			if (inertia.mass != 0.f)
+				comp.body->getCollisionShape()->calculateLocalInertia(inertia.mass, local_inertia);
+			comp.body->setMassProps(inertia.mass, local_inertia);
+		}
+
+		void update_child_transforms(bullet_data & comp, const core::transform & transform, const skeleton::bone_matrices * skeleton, entt::entity model_entity) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			if (!skeleton || !r.all_of<skeleton::bone_names>(model_entity))
+				return;
+
+			const auto & bones = get_collider_bones(model_entity);
+			const auto model_matrix = get_model_matrix(model_entity);
+			const auto & colliders = r.get<model_collider>(model_entity).colliders;
+			for (size_t i = 0; i < colliders.size(); ++i)
+				// Only recompute the compound shape's bounding box once all children have moved
+				comp.shape->updateChildTransform(int(i), to_bullet(transform, colliders[i], skeleton, bones.bones[i], model_matrix), false);
+			comp.shape->recalculateLocalAabb();
+		}
+
+		// Used to re-align bones. Cached on the model entity, so it's only recomputed when the model moves rather than for each of its instances
+		::glm::mat4 get_model_matrix(entt::entity model_entity) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			static const core::transform identity;
+			return glm::get_world_matrix({ r, model_entity }, identity, r.try_get<core::transform>(model_entity));
+		}
+
+		const collider_bones & get_collider_bones(entt::entity model_entity) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			if (const auto bones = r.try_get<collider_bones>(model_entity))
+				return *bones;
+
+			kengine_logf(r, verbose, log_category, "Resolving collider bones for {}", model_entity);
+
+			const auto & colliders = r.get<model_collider>(model_entity).colliders;
+			auto & ret = r.emplace<collider_bones>(model_entity);
+			ret.bones.resize(colliders.size());
+
+			const auto names = r.try_get<skeleton::bone_names>(model_entity);
+			if (!names)
+				return ret;
+
+			// Models indexed by kengine_skeleton_index already have a bone_index
+			std::optional<skeleton::bone_index> built_index;
+			auto index = r.try_get<skeleton::bone_index>(model_entity);
+			if (!index) {
+				built_index = skeleton::build_bone_index(*names);
+				index = &*built_index;
+			}
+
+			for (size_t i = 0; i < colliders.size(); ++i) {
+				const auto & bone_name = colliders[i].bone_name;
+				if (bone_name.empty())
+					continue;
+
+				const auto it = index->bones.find(std::string_view(bone_name.c_str()));
+				if (it == index->bones.end()) {
+					kengine_assert_failed(r, "'{}' bone not found", bone_name);
+					continue;
 				}
+				ret.bones[i] = it->second;
 			}
+
+			return ret;
 		}
 
+		// Reused across steps to avoid re-allocating
+		struct touching_manifold {
+			std::uint64_t pair;
+			const btPersistentManifold * manifold;
+		};
+		std::vector<touching_manifold> touching_manifolds;
+		std::vector<std::uint64_t> touching_pairs;
+		std::vector<std::uint64_t> previous_touching_pairs; // Sorted
+
+		static std::uint64_t make_pair_key(entt::entity e1, entt::entity e2) noexcept {
+			const auto lhs = std::uint64_t(entt::to_integral(e1));
+			const auto rhs = std::uint64_t(entt::to_integral(e2));
+			return lhs < rhs ? (lhs << 32) | rhs : (rhs << 32) | lhs;
+		}
+
+		static entt::entity get_first(std::uint64_t pair) noexcept { return entt::entity(pair >> 32); }
+		static entt::entity get_second(std::uint64_t pair) noexcept { return entt::entity(pair & 0xffffffff); }
+
 		void detect_collisions() noexcept {
 			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Detecting collisions");
+
+			events->events.clear();
+			events->contacts.clear();
+
+			// Gather manifolds once, ignoring those without contact points
+			touching_manifolds.clear();
+			const auto num_manifolds = dispatcher->getNumManifolds();
+			for (int i = 0; i < num_manifolds; ++i) {
+				const auto contact_manifold = dispatcher->getManifoldByIndexInternal(i);
+				if (contact_manifold->getNumContacts() <= 0)
+					continue;
+
+				const auto e1 = entt::entity(contact_manifold->getBody0()->getUserIndex());
+				const auto e2 = entt::entity(contact_manifold->getBody1()->getUserIndex());
+				touching_manifolds.push_back({ make_pair_key(e1, e2), contact_manifold });
+			}
+
+			// Group manifolds by pair, as compound shapes may generate several manifolds for the same pair
+			std::ranges::sort(touching_manifolds, {}, &touching_manifold::pair);
+
+			touching_pairs.clear();
+			for (size_t i = 0; i < touching_manifolds.size();) {
+				const auto pair = touching_manifolds[i].pair;
+
+				collision_events::event event{
+					.first = get_first(pair),
+					.second = get_second(pair),
+					.event_phase = std::ranges::binary_search(previous_touching_pairs, pair) ? collision_events::phase::persist : collision_events::phase::begin,
+					.first_contact = events->contacts.size(),
+				};
+
+				for (; i < touching_manifolds.size() && touching_manifolds[i].pair == pair; ++i)
+					add_contacts(*touching_manifolds[i].manifold, event.first);
+
+				event.contact_count = events->contacts.size() - event.first_contact;
+				kengine_logf(r, verbose, log_category, "Collision between {} & {} ({})", event.first, event.second, magic_enum::enum_name(event.event_phase));
+				events->events.push_back(event);
+				touching_pairs.push_back(pair);
+			}
+
+			// Pairs that were touching during the previous step, but aren't anymore
+			size_t current_index = 0;
+			for (const auto pair : previous_touching_pairs) {
+				while (current_index < touching_pairs.size() && touching_pairs[current_index] < pair)
+					++current_index;
+				if (current_index < touching_pairs.size() && touching_pairs[current_index] == pair)
+					continue;
+
+				kengine_logf(r, verbose, log_category, "Collision between {} & {} ended", get_first(pair), get_second(pair));
+				events->events.push_back({
+					.first = get_first(pair),
+					.second = get_second(pair),
+					.event_phase = collision_events::phase::end,
+					.first_contact = events->contacts.size(),
+				});
+			}
+
+			std::swap(previous_touching_pairs, touching_pairs);
 
-			const auto num_manifolds = dispatcher.getNumManifolds();
-			if (num_manifolds <= 0)
+			if (events->events.empty())
 				return;
-			kengine_log(r, very_verbose, log_category, "Detecting collisions");
+
 			for (const auto & [callback_entity, on_collision] : r.view<kengine::physics::on_collision>().each())
-				for (int i = 0; i < num_manifolds; ++i) {
-					const auto contact_manifold = dispatcher.getManifoldByIndexInternal(i);
-					const auto object_a = (btCollisionObject *)(contact_manifold->getBody0());
-					const auto object_b = (btCollisionObject *)(contact_manifold->getBody1());
-
-					const auto e1 = entt::entity(object_a->getUserIndex());
-					const auto e2 = entt::entity(object_b->getUserIndex());
-					kengine_logf(r, verbose, log_category, "Collision between {} & {}", e1, e2);
-					on_collision(e1, e2);
-				}
+				for (const auto & event : events->events)
+					if (event.event_phase != collision_events::phase::end)
+						on_collision(event.first, event.second);
+		}
+
+		void add_contacts(const btPersistentManifold & contact_manifold, entt::entity first) noexcept {
+			// Contact points are expressed relative to the manifold's bodies, which may be in the opposite order
+			const bool swapped = entt::entity(contact_manifold.getBody0()->getUserIndex()) != first;
+
+			for (int i = 0; i < contact_manifold.getNumContacts(); ++i) {
+				const auto & point = contact_manifold.getContactPoint(i);
+				events->contacts.push_back({
+					.position_on_first = to_putils(swapped ? point.getPositionWorldOnB() : point.getPositionWorldOnA()),
+					.position_on_second = to_putils(swapped ? point.getPositionWorldOnA() : point.getPositionWorldOnB()),
+					.normal_on_second = to_putils(swapped ? -point.m_normalWorldOnB : point.m_normalWorldOnB),
+					.distance = point.getDistance(),
+					.impulse = point.getAppliedImpulse(),
+				});
+			}
 		}
 
 		void query_position(const putils::point3f & pos, float radius, const entity_iterator_func & func) noexcept {
@@ -404,7 +828,7 @@ namespace kengine::physics::bullet {
 			};
 
 			callback callback(r, ghost, func);
-			dynamics_world.contactTest(&ghost, callback);
+			dynamics_world->contactTest(&ghost, callback);
 		}
 
 		::glm::vec3 to_vec(const putils::point3f & p) noexcept { return { p.x, p.y, p.z }; }
@@ -427,16 +851,15 @@ namespace kengine::physics::bullet {
 			return ret;
 		}
 
-		btTransform to_bullet(const core::transform & parent, const model_collider::collider & collider, const skeleton::bone_matrices * skeleton, const skeleton::bone_names * bone_names, const core::transform * model_transform) noexcept {
+		btTransform to_bullet(const core::transform & parent, const model_collider::collider & collider, const skeleton::bone_matrices * skeleton, const std::optional<skeleton::bone_indices> & bone, const ::glm::mat4 & model_matrix) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Converting transform for collider");
 
 			::glm::mat4 mat{ 1.f };
 
-			if (!collider.bone_name.empty() && skeleton && bone_names) {
-				// Also apply model transform to re-align bones
-				mat *= glm::get_model_matrix({}, model_transform);
-				mat *= skeleton::get_bone_matrix(r, collider.bone_name.c_str(), *skeleton, *bone_names);
+			if (bone && skeleton) {
+				mat *= model_matrix;
+				mat *= skeleton::get_bone_matrix(*bone, *skeleton);
 			}
 
 			mat = ::glm::translate(mat, to_vec(collider.transform.bounding_box.position));
@@ -510,6 +933,7 @@ namespace kengine::physics::bullet {
 	DEFINE_KENGINE_SYSTEM_CREATOR(
 		system,
 		system::bullet_data,
+		system::collider_bones,
 		system::processed
 	)
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+// stl
+#include <chrono>
+#include <cmath>
+#include <string>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/model/data/instance.hpp"
+#include "kengine/physics/bullet/systems/config.hpp"
+#include "kengine/physics/bullet/systems/system.hpp"
+#include "kengine/physics/data/inertia.hpp"
+#include "kengine/physics/data/model_collider.hpp"
+
+// Benchmark comparing step times of the single-threaded and multithreaded worlds. Disabled by default, run it with --gtest_also_run_disabled_tests
+static double get_milliseconds_per_step(size_t body_count, bool multithreaded) noexcept {
+	entt::registry r;
+	const auto system = kengine::physics::bullet::add_system(r);
+	r.get<kengine::physics::bullet::config>(system).multithreaded = multithreaded;
+
+	const auto model = r.create();
+	r.emplace<kengine::physics::model_collider>(model).colliders.push_back({ .shape = kengine::physics::model_collider::collider::box });
+
+	const auto ground = r.create();
+	auto & ground_transform = r.emplace<kengine::core::transform>(ground);
+	ground_transform.bounding_box.position = { 0.f, -1.f, 0.f };
+	ground_transform.bounding_box.size = { 1000.f, 1.f, 1000.f };
+	r.emplace<kengine::physics::inertia>(ground).mass = 0.f;
+	r.emplace<kengine::model::instance>(ground, model);
+
+	// Bodies are stacked in columns, so that the solver has contacts to resolve
+	const auto side = size_t(std::ceil(std::sqrt(float(body_count) / 10.f)));
+	for (size_t i = 0; i < body_count; ++i) {
+		const auto e = r.create();
+		auto & transform = r.emplace<kengine::core::transform>(e);
+		transform.bounding_box.position = { float(i % side) * 2.f, .5f + float(i / (side * side)) * 1.1f, float(i / side % side) * 2.f };
+		r.emplace<kengine::physics::inertia>(e);
+		r.emplace<kengine::model::instance>(e, model);
+	}
+
+	const auto & execute = r.get<kengine::main_loop::execute>(system);
+	constexpr auto delta_time = 1.f / 60.f;
+
+	// Let the system create the bodies, and the stacks settle into contact
+	for (int i = 0; i < 10; ++i)
+		execute(delta_time);
+
+	constexpr size_t steps = 20;
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < steps; ++i)
+		execute(delta_time);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	return double(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000. / double(steps);
+}
+
+TEST(bullet, DISABLED_benchmark_step) {
+	for (const size_t body_count : { 1'000, 5'000, 10'000 }) {
+		const auto count = std::to_string(body_count);
+		testing::Test::RecordProperty("step_" + count + "_single_threaded", std::to_string(get_milliseconds_per_step(body_count, false)));
+		testing::Test::RecordProperty("step_" + count + "_multithreaded", std::to_string(get_milliseconds_per_step(body_count, true)));
+	}
+}
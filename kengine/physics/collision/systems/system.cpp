@@ -19,6 +19,9 @@ namespace kengine::physics::collision {
 	struct system {
 		entt::registry & r;
 
+		// Cached to avoid looking the storage up for each collision
+		const entt::storage_for_t<physics::collision::collision> & collisions = r.storage<physics::collision::collision>();
+
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
 			KENGINE_PROFILING_SCOPE;
@@ -29,16 +32,23 @@ namespace kengine::physics::collision {
 		void on_collision(entt::entity first, entt::entity second) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(r, verbose, log_category, "Collision between {} and {}", first, second);
+
+			if (collisions.empty())
+				return;
+
 			trigger(first, second);
 			trigger(second, first);
 		}
 
 		void trigger(entt::entity first, entt::entity second) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			const auto collision = r.try_get<physics::collision::collision>(first);
-			if (!collision || collision->on_collide == nullptr)
+			if (!collisions.contains(first))
+				return;
+
+			const auto & collision = collisions.get(first);
+			if (collision.on_collide == nullptr)
 				return;
-			collision->on_collide(first, second);
+			collision.on_collide(first, second);
 		}
 	};
 
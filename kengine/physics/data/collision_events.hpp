@@ -0,0 +1,53 @@
+#pragma once
+
+// stl
+#include <vector>
+
+// entt
+#include <entt/entity/entity.hpp>
+
+// putils
+#include "putils/point.hpp"
+
+namespace kengine::physics {
+	/*!
+	 * putils reflect all
+	 * used_types: [
+	 * 		refltype::contact,
+	 * 		refltype::event
+	 * ]
+	 */
+	struct collision_events {
+		//! putils reflect all
+		//! class_name: collision_events_contact
+		//! used_types: [putils::point3f, putils::vec3f]
+		struct contact {
+			putils::point3f position_on_first{ 0.f, 0.f, 0.f };
+			putils::point3f position_on_second{ 0.f, 0.f, 0.f };
+			putils::vec3f normal_on_second{ 0.f, 0.f, 0.f };
+			float distance = 0.f;
+			float impulse = 0.f;
+		};
+
+		enum class phase {
+			begin,
+			persist,
+			end,
+		};
+
+		//! putils reflect all
+		//! class_name: collision_events_event
+		struct event {
+			entt::entity first = entt::null;
+			entt::entity second = entt::null;
+			phase event_phase = phase::begin;
+			size_t first_contact = 0; // Index into contacts
+			size_t contact_count = 0; // Always 0 for `end` events
+		};
+
+		std::vector<event> events;
+		std::vector<contact> contacts;
+	};
+}
+
+#include "collision_events.rpp"
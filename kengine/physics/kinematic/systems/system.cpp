@@ -1,18 +1,26 @@
 #include "system.hpp"
 
+// stl
+#include <vector>
+
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
 
+// glm
+#include <glm/glm.hpp>
+
 // putils
-#include "putils/angle.hpp"
 #include "putils/forward_to.hpp"
 
 // kengine
 #include "kengine/core/data/transform.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/glm/helpers/batch_transform.hpp"
+#include "kengine/glm/helpers/to_vec.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/helpers/declare_access.hpp"
 #include "kengine/physics/data/inertia.hpp"
 #include "kengine/physics/kinematic/data/kinematic.hpp"
 
@@ -28,26 +36,35 @@ namespace kengine::physics::kinematic {
 			kengine_log(r, log, log_category, "Initializing");
 
 			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			main_loop::declare_access(e, main_loop::reads<inertia, kinematic>{}, main_loop::writes<core::transform>{});
 		}
 
+		// Gathered from the view on each step, so that the batch layer can run over contiguous arrays
+		std::vector<core::transform> transforms;
+		std::vector<::glm::vec3> movements;
+		std::vector<::glm::vec3> rotations;
+
 		void execute(float delta_time) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
-			for (const auto & [e, transform, inertia] : r.view<core::transform, inertia, kinematic>().each()) {
-				kengine_logf(r, very_verbose, log_category, "Moving {}", e);
+			const auto view = r.view<core::transform, inertia, kinematic>();
 
-				transform.bounding_box.position += inertia.movement * delta_time;
+			transforms.clear();
+			movements.clear();
+			rotations.clear();
+			for (const auto & [e, transform, inertia] : view.each()) {
+				transforms.push_back(transform);
+				movements.push_back(glm::to_vec(inertia.movement));
+				rotations.push_back({ inertia.yaw, inertia.pitch, inertia.roll });
+			}
 
-				const auto apply_rotation = [delta_time](float & transform_member, float physics_member) noexcept {
-					transform_member += physics_member * delta_time;
-					transform_member = putils::constrain_angle(transform_member);
-				};
+			glm::batch::integrate(transforms, movements, rotations, delta_time);
 
-				apply_rotation(transform.pitch, inertia.pitch);
-				apply_rotation(transform.yaw, inertia.yaw);
-				apply_rotation(transform.roll, inertia.roll);
-			}
+			// The view is iterated in the same order as above
+			size_t i = 0;
+			for (const auto & [e, transform, inertia] : view.each())
+				transform = transforms[i++];
 		}
 	};
 
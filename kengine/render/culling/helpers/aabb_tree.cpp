@@ -0,0 +1,333 @@
+#include "aabb_tree.hpp"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::render::culling {
+	static aabb combine(const aabb & lhs, const aabb & rhs) noexcept {
+		return {
+			{ std::min(lhs.min.x, rhs.min.x), std::min(lhs.min.y, rhs.min.y), std::min(lhs.min.z, rhs.min.z) },
+			{ std::max(lhs.max.x, rhs.max.x), std::max(lhs.max.y, rhs.max.y), std::max(lhs.max.z, rhs.max.z) },
+		};
+	}
+
+	// Half of the surface area, used as the cost heuristic when inserting
+	static float get_area(const aabb & box) noexcept {
+		const auto size = box.max - box.min;
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+
+	static bool contains(const aabb & outer, const aabb & inner) noexcept {
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+			   inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+	}
+
+	static bool overlaps(const aabb & lhs, const aabb & rhs) noexcept {
+		return lhs.min.x <= rhs.max.x && rhs.min.x <= lhs.max.x &&
+			   lhs.min.y <= rhs.max.y && rhs.min.y <= lhs.max.y &&
+			   lhs.min.z <= rhs.max.z && rhs.min.z <= lhs.max.z;
+	}
+
+	static int & child_slot(aabb_tree::node & parent, int child) noexcept {
+		return parent.children[0] == child ? parent.children[0] : parent.children[1];
+	}
+
+	aabb_tree::aabb_tree(float margin) noexcept
+		: margin(margin) {}
+
+	int aabb_tree::insert(const aabb & box, entt::entity entity) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto proxy = allocate_node();
+		nodes[proxy].box = fatten(box);
+		nodes[proxy].entity = entity;
+		insert_leaf(proxy);
+		++proxy_count;
+		return proxy;
+	}
+
+	void aabb_tree::remove(int proxy) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		remove_leaf(proxy);
+		free_node(proxy);
+		--proxy_count;
+	}
+
+	// Returns whether the proxy had to be re-inserted
+	bool aabb_tree::move(int proxy, const aabb & box) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		// Keep the current leaf unless the box left it, or shrank so much that the leaf became too conservative
+		const auto & current = nodes[proxy].box;
+		const auto fat_box = fatten(box);
+		if (contains(current, box) && contains(fatten(fat_box), current))
+			return false;
+
+		remove_leaf(proxy);
+		nodes[proxy].box = fat_box;
+		insert_leaf(proxy);
+		return true;
+	}
+
+	void aabb_tree::query(const frustum & frustum, std::vector<entt::entity> & out) const noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (root == null_node)
+			return;
+
+		// Leaves in partially visible subtrees are gathered, then tested in batches
+		std::vector<aabb> candidate_boxes;
+		std::vector<entt::entity> candidates;
+
+		std::vector<int> stack{ root };
+		while (!stack.empty()) {
+			const auto index = stack.back();
+			stack.pop_back();
+
+			const auto & node = nodes[index];
+			if (node.is_leaf()) {
+				candidate_boxes.push_back(node.box);
+				candidates.push_back(node.entity);
+				continue;
+			}
+
+			switch (intersect(frustum, node.box)) {
+				case intersection::outside:
+					break;
+				case intersection::inside:
+					add_all_leaves(index, out);
+					break;
+				case intersection::intersecting:
+					stack.push_back(node.children[0]);
+					stack.push_back(node.children[1]);
+					break;
+			}
+		}
+
+		std::vector<std::uint8_t> visible(candidates.size());
+		intersect(frustum, candidate_boxes, visible);
+		for (size_t i = 0; i < candidates.size(); ++i)
+			if (visible[i])
+				out.push_back(candidates[i]);
+	}
+
+	void aabb_tree::query(const aabb & box, std::vector<entt::entity> & out) const noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (root == null_node)
+			return;
+
+		std::vector<int> stack{ root };
+		while (!stack.empty()) {
+			const auto index = stack.back();
+			stack.pop_back();
+
+			const auto & node = nodes[index];
+			if (!overlaps(node.box, box))
+				continue;
+
+			if (node.is_leaf())
+				out.push_back(node.entity);
+			else {
+				stack.push_back(node.children[0]);
+				stack.push_back(node.children[1]);
+			}
+		}
+	}
+
+	size_t aabb_tree::size() const noexcept {
+		return proxy_count;
+	}
+
+	int aabb_tree::get_height() const noexcept {
+		if (root == null_node)
+			return 0;
+		return nodes[root].height;
+	}
+
+	const aabb & aabb_tree::get_fat_aabb(int proxy) const noexcept {
+		return nodes[proxy].box;
+	}
+
+	int aabb_tree::allocate_node() noexcept {
+		if (free_list == null_node) {
+			nodes.emplace_back();
+			return int(nodes.size() - 1);
+		}
+
+		const auto index = free_list;
+		free_list = nodes[index].parent;
+		nodes[index] = node{};
+		return index;
+	}
+
+	void aabb_tree::free_node(int index) noexcept {
+		nodes[index] = node{};
+		nodes[index].parent = free_list;
+		free_list = index;
+	}
+
+	aabb aabb_tree::fatten(const aabb & box) const noexcept {
+		const putils::vec3f offset{ margin, margin, margin };
+		return { box.min - offset, box.max + offset };
+	}
+
+	void aabb_tree::insert_leaf(int leaf) noexcept {
+		if (root == null_node) {
+			root = leaf;
+			nodes[root].parent = null_node;
+			return;
+		}
+
+		// Find the sibling that minimizes the total area of the tree
+		const auto leaf_box = nodes[leaf].box;
+		auto sibling = root;
+		while (!nodes[sibling].is_leaf()) {
+			const auto & current = nodes[sibling];
+			const auto area = get_area(current.box);
+			const auto combined_area = get_area(combine(current.box, leaf_box));
+
+			// Cost of creating a new parent for this node and the leaf
+			const auto cost = 2.f * combined_area;
+			// Minimum cost of pushing the leaf further down the tree
+			const auto inheritance_cost = 2.f * (combined_area - area);
+
+			const auto get_child_cost = [&](int child) noexcept {
+				const auto & child_node = nodes[child];
+				const auto child_combined_area = get_area(combine(leaf_box, child_node.box));
+				if (child_node.is_leaf())
+					return child_combined_area + inheritance_cost;
+				return child_combined_area - get_area(child_node.box) + inheritance_cost;
+			};
+
+			const auto cost0 = get_child_cost(current.children[0]);
+			const auto cost1 = get_child_cost(current.children[1]);
+			if (cost < cost0 && cost < cost1)
+				break;
+
+			sibling = cost0 < cost1 ? current.children[0] : current.children[1];
+		}
+
+		// Create a new parent for the sibling and the leaf. `nodes` may be reallocated, so don't keep references across this
+		const auto old_parent = nodes[sibling].parent;
+		const auto new_parent = allocate_node();
+		nodes[new_parent].parent = old_parent;
+		nodes[new_parent].box = combine(leaf_box, nodes[sibling].box);
+		nodes[new_parent].height = nodes[sibling].height + 1;
+		nodes[new_parent].children[0] = sibling;
+		nodes[new_parent].children[1] = leaf;
+		nodes[sibling].parent = new_parent;
+		nodes[leaf].parent = new_parent;
+
+		if (old_parent != null_node)
+			child_slot(nodes[old_parent], sibling) = new_parent;
+		else
+			root = new_parent;
+
+		refit(new_parent);
+	}
+
+	void aabb_tree::remove_leaf(int leaf) noexcept {
+		if (leaf == root) {
+			root = null_node;
+			return;
+		}
+
+		const auto parent = nodes[leaf].parent;
+		const auto grand_parent = nodes[parent].parent;
+		const auto sibling = nodes[parent].children[0] == leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+		// Replace the parent by the sibling
+		nodes[sibling].parent = grand_parent;
+		free_node(parent);
+		if (grand_parent == null_node) {
+			root = sibling;
+			return;
+		}
+
+		child_slot(nodes[grand_parent], parent) = sibling;
+		refit(grand_parent);
+	}
+
+	// Walks up from `index`, rebalancing and fixing heights and boxes
+	void aabb_tree::refit(int index) noexcept {
+		while (index != null_node) {
+			index = balance(index);
+
+			auto & current = nodes[index];
+			const auto & child0 = nodes[current.children[0]];
+			const auto & child1 = nodes[current.children[1]];
+			current.height = 1 + std::max(child0.height, child1.height);
+			current.box = combine(child0.box, child1.box);
+
+			index = current.parent;
+		}
+	}
+
+	// Rotates the taller child of `index` up if the subtree is imbalanced, and returns the subtree's new root
+	int aabb_tree::balance(int index) noexcept {
+		const auto & current = nodes[index];
+		if (current.is_leaf() || current.height < 2)
+			return index;
+
+		const auto child0 = current.children[0];
+		const auto child1 = current.children[1];
+		const auto difference = nodes[child1].height - nodes[child0].height;
+		if (difference > 1)
+			return rotate(index, child1, child0);
+		if (difference < -1)
+			return rotate(index, child0, child1);
+		return index;
+	}
+
+	int aabb_tree::rotate(int index, int high_child, int low_child) noexcept {
+		auto & current = nodes[index];
+		auto & high = nodes[high_child];
+
+		// high_child takes index's place
+		high.parent = current.parent;
+		current.parent = high_child;
+		if (high.parent != null_node)
+			child_slot(nodes[high.parent], index) = high_child;
+		else
+			root = high_child;
+
+		// high_child's taller child stays under it, the other one replaces high_child under index
+		const auto grand_child0 = high.children[0];
+		const auto grand_child1 = high.children[1];
+		const auto kept = nodes[grand_child0].height > nodes[grand_child1].height ? grand_child0 : grand_child1;
+		const auto moved = kept == grand_child0 ? grand_child1 : grand_child0;
+
+		high.children[0] = index;
+		high.children[1] = kept;
+		child_slot(current, high_child) = moved;
+		nodes[moved].parent = index;
+
+		current.box = combine(nodes[low_child].box, nodes[moved].box);
+		current.height = 1 + std::max(nodes[low_child].height, nodes[moved].height);
+		high.box = combine(current.box, nodes[kept].box);
+		high.height = 1 + std::max(current.height, nodes[kept].height);
+
+		return high_child;
+	}
+
+	void aabb_tree::add_all_leaves(int index, std::vector<entt::entity> & out) const noexcept {
+		std::vector<int> stack{ index };
+		while (!stack.empty()) {
+			const auto & current = nodes[stack.back()];
+			stack.pop_back();
+
+			if (current.is_leaf())
+				out.push_back(current.entity);
+			else {
+				stack.push_back(current.children[0]);
+				stack.push_back(current.children[1]);
+			}
+		}
+	}
+}
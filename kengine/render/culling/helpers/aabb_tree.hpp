@@ -0,0 +1,57 @@
+#pragma once
+
+// stl
+#include <vector>
+
+// entt
+#include <entt/entity/entity.hpp>
+
+// kengine
+#include "kengine/render/culling/helpers/frustum.hpp"
+
+namespace kengine::render::culling {
+	// Dynamic bounding volume hierarchy. Leaves are enlarged by `margin`, so that small movements don't require updating the tree
+	struct KENGINE_RENDER_CULLING_EXPORT aabb_tree {
+		static constexpr int null_node = -1;
+
+		aabb_tree(float margin = .1f) noexcept;
+
+		int insert(const aabb & box, entt::entity entity) noexcept;
+		void remove(int proxy) noexcept;
+		bool move(int proxy, const aabb & box) noexcept;
+
+		void query(const frustum & frustum, std::vector<entt::entity> & out) const noexcept;
+		void query(const aabb & box, std::vector<entt::entity> & out) const noexcept;
+
+		size_t size() const noexcept;
+		int get_height() const noexcept;
+		const aabb & get_fat_aabb(int proxy) const noexcept;
+
+		struct node {
+			aabb box;
+			entt::entity entity = entt::null;
+			int parent = null_node; // Next free node when in the free list
+			int children[2] = { null_node, null_node };
+			int height = 0; // 0 for leaves
+
+			bool is_leaf() const noexcept { return children[0] == null_node; }
+		};
+
+		int allocate_node() noexcept;
+		void free_node(int index) noexcept;
+		aabb fatten(const aabb & box) const noexcept;
+
+		void insert_leaf(int leaf) noexcept;
+		void remove_leaf(int leaf) noexcept;
+		void refit(int index) noexcept;
+		int balance(int index) noexcept;
+		int rotate(int index, int high_child, int low_child) noexcept;
+		void add_all_leaves(int index, std::vector<entt::entity> & out) const noexcept;
+
+		std::vector<node> nodes;
+		int root = null_node;
+		int free_list = null_node;
+		size_t proxy_count = 0;
+		float margin;
+	};
+}
@@ -0,0 +1,104 @@
+#include "frustum.hpp"
+
+// stl
+#include <algorithm>
+#include <cmath>
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/render/helpers/get_facings.hpp"
+
+namespace kengine::render::culling {
+	static float dot(const putils::vec3f & lhs, const putils::vec3f & rhs) noexcept {
+		return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+	}
+
+	static frustum::plane make_plane(putils::vec3f normal, const putils::point3f & point) noexcept {
+		putils::normalize(normal);
+		return { normal, -dot(normal, point) };
+	}
+
+	frustum get_frustum(const camera & camera, const viewport & viewport) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		const auto & position = camera.frustum.position;
+
+		// Renderers ignore roll when building the view matrix, so do the same here
+		const auto facings = get_facings(camera);
+		const auto & front = facings.front;
+		const auto & right = facings.right;
+		auto up = putils::cross(right, front);
+		putils::normalize(up);
+
+		// frustum.size.y is the vertical field of view
+		const auto half_height = std::tan(camera.frustum.size.y / 2.f);
+		const auto aspect_ratio = viewport.resolution.y != 0 ? float(viewport.resolution.x) / float(viewport.resolution.y) : 1.f;
+		const auto half_width = half_height * aspect_ratio;
+
+		frustum ret;
+		ret.planes[0] = make_plane(front, position + front * camera.near_plane);
+		ret.planes[1] = make_plane(front * -1.f, position + front * camera.far_plane);
+		ret.planes[2] = make_plane(right + front * half_width, position);
+		ret.planes[3] = make_plane(right * -1.f + front * half_width, position);
+		ret.planes[4] = make_plane(up + front * half_height, position);
+		ret.planes[5] = make_plane(up * -1.f + front * half_height, position);
+		return ret;
+	}
+
+	intersection intersect(const frustum & frustum, const aabb & box) noexcept {
+		const putils::point3f center = (box.min + box.max) / 2.f;
+		const putils::vec3f extents = (box.max - box.min) / 2.f;
+
+		auto ret = intersection::inside;
+		for (const auto & plane : frustum.planes) {
+			const auto radius = std::abs(plane.normal.x) * extents.x + std::abs(plane.normal.y) * extents.y + std::abs(plane.normal.z) * extents.z;
+			const auto distance = dot(plane.normal, center) + plane.distance;
+			if (distance < -radius)
+				return intersection::outside;
+			if (distance < radius)
+				ret = intersection::intersecting;
+		}
+		return ret;
+	}
+
+	void intersect(const frustum & frustum, std::span<const aabb> boxes, std::span<std::uint8_t> visible) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		// Boxes are transposed into fixed-size batches of plain arrays, which the compiler vectorizes
+		static constexpr size_t batch_size = 8;
+		for (size_t first = 0; first < boxes.size(); first += batch_size) {
+			const auto count = std::min(batch_size, boxes.size() - first);
+
+			float center_x[batch_size] = {};
+			float center_y[batch_size] = {};
+			float center_z[batch_size] = {};
+			float extent_x[batch_size] = {};
+			float extent_y[batch_size] = {};
+			float extent_z[batch_size] = {};
+			for (size_t i = 0; i < count; ++i) {
+				const auto & box = boxes[first + i];
+				center_x[i] = (box.min.x + box.max.x) * .5f;
+				center_y[i] = (box.min.y + box.max.y) * .5f;
+				center_z[i] = (box.min.z + box.max.z) * .5f;
+				extent_x[i] = (box.max.x - box.min.x) * .5f;
+				extent_y[i] = (box.max.y - box.min.y) * .5f;
+				extent_z[i] = (box.max.z - box.min.z) * .5f;
+			}
+
+			bool outside[batch_size] = {};
+			for (const auto & plane : frustum.planes) {
+				const auto abs_x = std::abs(plane.normal.x);
+				const auto abs_y = std::abs(plane.normal.y);
+				const auto abs_z = std::abs(plane.normal.z);
+				for (size_t i = 0; i < batch_size; ++i) {
+					const auto radius = abs_x * extent_x[i] + abs_y * extent_y[i] + abs_z * extent_z[i];
+					const auto distance = plane.normal.x * center_x[i] + plane.normal.y * center_y[i] + plane.normal.z * center_z[i] + plane.distance;
+					outside[i] |= distance < -radius;
+				}
+			}
+
+			for (size_t i = 0; i < count; ++i)
+				visible[first + i] = !outside[i];
+		}
+	}
+}
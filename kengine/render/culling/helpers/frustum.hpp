@@ -0,0 +1,39 @@
+#pragma once
+
+// stl
+#include <cstdint>
+#include <span>
+
+// putils
+#include "putils/point.hpp"
+
+// kengine
+#include "kengine/render/data/camera.hpp"
+#include "kengine/render/data/viewport.hpp"
+
+namespace kengine::render::culling {
+	struct aabb {
+		putils::point3f min;
+		putils::point3f max;
+	};
+
+	struct frustum {
+		// Planes face inwards: a point `p` is in front of a plane if `dot(normal, p) + distance >= 0`
+		struct plane {
+			putils::vec3f normal;
+			float distance = 0.f;
+		};
+
+		plane planes[6];
+	};
+
+	enum class intersection {
+		outside,
+		intersecting,
+		inside,
+	};
+
+	KENGINE_RENDER_CULLING_EXPORT frustum get_frustum(const camera & camera, const viewport & viewport) noexcept;
+	KENGINE_RENDER_CULLING_EXPORT intersection intersect(const frustum & frustum, const aabb & box) noexcept;
+	KENGINE_RENDER_CULLING_EXPORT void intersect(const frustum & frustum, std::span<const aabb> boxes, std::span<std::uint8_t> visible) noexcept;
+}
@@ -0,0 +1,135 @@
+// stl
+#include <algorithm>
+#include <cmath>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/render/culling/helpers/aabb_tree.hpp"
+
+using namespace kengine::render::culling;
+
+static aabb make_box(float x, float y, float z, float size = 1.f) noexcept {
+	return { { x, y, z }, { x + size, y + size, z + size } };
+}
+
+static bool contains(const std::vector<entt::entity> & entities, entt::entity e) noexcept {
+	return std::ranges::find(entities, e) != entities.end();
+}
+
+TEST(aabb_tree, empty) {
+	const aabb_tree tree;
+	EXPECT_EQ(tree.size(), 0);
+	EXPECT_EQ(tree.get_height(), 0);
+
+	std::vector<entt::entity> result;
+	tree.query(make_box(0.f, 0.f, 0.f, 100.f), result);
+	EXPECT_TRUE(result.empty());
+}
+
+TEST(aabb_tree, query_box) {
+	aabb_tree tree{ 0.f };
+	tree.insert(make_box(0.f, 0.f, 0.f), entt::entity{ 0 });
+	tree.insert(make_box(10.f, 0.f, 0.f), entt::entity{ 1 });
+	tree.insert(make_box(20.f, 0.f, 0.f), entt::entity{ 2 });
+	EXPECT_EQ(tree.size(), 3);
+
+	std::vector<entt::entity> result;
+	tree.query(make_box(9.f, 0.f, 0.f, 5.f), result);
+	ASSERT_EQ(result.size(), 1);
+	EXPECT_EQ(result[0], entt::entity{ 1 });
+}
+
+TEST(aabb_tree, fat_aabb) {
+	aabb_tree tree{ 1.f };
+	const auto proxy = tree.insert(make_box(0.f, 0.f, 0.f), entt::entity{ 0 });
+
+	const auto & fat_box = tree.get_fat_aabb(proxy);
+	EXPECT_EQ(fat_box.min.x, -1.f);
+	EXPECT_EQ(fat_box.max.x, 2.f);
+}
+
+TEST(aabb_tree, move_within_margin) {
+	aabb_tree tree{ 1.f };
+	const auto proxy = tree.insert(make_box(0.f, 0.f, 0.f), entt::entity{ 0 });
+	EXPECT_FALSE(tree.move(proxy, make_box(.5f, 0.f, 0.f)));
+}
+
+TEST(aabb_tree, move_outside_margin) {
+	aabb_tree tree{ 1.f };
+	const auto proxy = tree.insert(make_box(0.f, 0.f, 0.f), entt::entity{ 0 });
+	tree.insert(make_box(50.f, 0.f, 0.f), entt::entity{ 1 });
+	EXPECT_TRUE(tree.move(proxy, make_box(100.f, 0.f, 0.f)));
+
+	std::vector<entt::entity> result;
+	tree.query(make_box(0.f, 0.f, 0.f), result);
+	EXPECT_TRUE(result.empty());
+
+	tree.query(make_box(100.f, 0.f, 0.f), result);
+	ASSERT_EQ(result.size(), 1);
+	EXPECT_EQ(result[0], entt::entity{ 0 });
+}
+
+TEST(aabb_tree, remove) {
+	aabb_tree tree{ 0.f };
+	const auto first = tree.insert(make_box(0.f, 0.f, 0.f), entt::entity{ 0 });
+	tree.insert(make_box(0.f, 0.f, 0.f), entt::entity{ 1 });
+	tree.remove(first);
+	EXPECT_EQ(tree.size(), 1);
+
+	std::vector<entt::entity> result;
+	tree.query(make_box(0.f, 0.f, 0.f), result);
+	ASSERT_EQ(result.size(), 1);
+	EXPECT_EQ(result[0], entt::entity{ 1 });
+}
+
+TEST(aabb_tree, balanced) {
+	aabb_tree tree{ 0.f };
+	// Sorted insertions would degenerate into a list without rebalancing
+	for (int i = 0; i < 1024; ++i)
+		tree.insert(make_box(float(i) * 2.f, 0.f, 0.f), entt::entity(i));
+	EXPECT_EQ(tree.size(), 1024);
+	EXPECT_LE(tree.get_height(), 20);
+
+	std::vector<entt::entity> result;
+	tree.query(make_box(-1.f, -1.f, -1.f, 5000.f), result);
+	EXPECT_EQ(result.size(), 1024);
+}
+
+TEST(aabb_tree, reuses_nodes) {
+	aabb_tree tree{ 0.f };
+	for (int i = 0; i < 16; ++i)
+		tree.insert(make_box(float(i), 0.f, 0.f), entt::entity(i));
+	const auto node_count = tree.nodes.size();
+
+	const auto proxy = tree.insert(make_box(100.f, 0.f, 0.f), entt::entity{ 100 });
+	tree.remove(proxy);
+	tree.insert(make_box(100.f, 0.f, 0.f), entt::entity{ 100 });
+	EXPECT_EQ(tree.nodes.size(), node_count + 2);
+}
+
+TEST(aabb_tree, query_frustum) {
+	aabb_tree tree{ 0.f };
+	for (int i = 0; i < 100; ++i) {
+		// One row of boxes in front of the camera, one behind it
+		tree.insert(make_box(-.5f, -.5f, 2.f + float(i)), entt::entity(i));
+		tree.insert(make_box(-.5f, -.5f, -2.f - float(i)), entt::entity(1000 + i));
+	}
+
+	kengine::render::camera camera;
+	camera.frustum.size.y = 1.f;
+	camera.near_plane = 1.f;
+	camera.far_plane = 50.f;
+	kengine::render::viewport viewport;
+	viewport.resolution = { 100, 100 };
+
+	std::vector<entt::entity> result;
+	tree.query(get_frustum(camera, viewport), result);
+
+	EXPECT_TRUE(contains(result, entt::entity{ 0 }));
+	EXPECT_TRUE(contains(result, entt::entity{ 40 }));
+	EXPECT_FALSE(contains(result, entt::entity{ 60 })); // Past the far plane
+	for (int i = 0; i < 100; ++i)
+		EXPECT_FALSE(contains(result, entt::entity(1000 + i)));
+}
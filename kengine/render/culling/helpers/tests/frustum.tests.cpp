@@ -0,0 +1,63 @@
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/render/culling/helpers/frustum.hpp"
+
+using namespace kengine::render::culling;
+
+static frustum get_default_frustum() noexcept {
+	kengine::render::camera camera;
+	camera.frustum.size.y = 1.f;
+	camera.near_plane = 1.f;
+	camera.far_plane = 100.f;
+
+	kengine::render::viewport viewport;
+	viewport.resolution = { 100, 100 };
+	return get_frustum(camera, viewport);
+}
+
+static aabb make_box(float x, float y, float z, float size = 1.f) noexcept {
+	return { { x - size / 2.f, y - size / 2.f, z - size / 2.f }, { x + size / 2.f, y + size / 2.f, z + size / 2.f } };
+}
+
+TEST(frustum, inside) {
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(0.f, 0.f, 10.f)), intersection::inside);
+}
+
+TEST(frustum, behind) {
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(0.f, 0.f, -10.f)), intersection::outside);
+}
+
+TEST(frustum, past_far_plane) {
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(0.f, 0.f, 200.f)), intersection::outside);
+}
+
+TEST(frustum, to_the_side) {
+	// Half the field of view is .5 radians, so x = 10 is well outside at z = 10
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(10.f, 0.f, 10.f)), intersection::outside);
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(-10.f, 0.f, 10.f)), intersection::outside);
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(0.f, 10.f, 10.f)), intersection::outside);
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(0.f, -10.f, 10.f)), intersection::outside);
+}
+
+TEST(frustum, intersecting) {
+	EXPECT_EQ(intersect(get_default_frustum(), make_box(0.f, 0.f, 100.f, 4.f)), intersection::intersecting);
+}
+
+TEST(frustum, batch) {
+	const auto frustum = get_default_frustum();
+
+	// More than a batch, with a partial one at the end
+	std::vector<aabb> boxes;
+	for (int i = 0; i < 21; ++i)
+		boxes.push_back(make_box(0.f, 0.f, i % 2 ? 10.f : -10.f));
+
+	std::vector<std::uint8_t> visible(boxes.size());
+	intersect(frustum, boxes, visible);
+
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		EXPECT_EQ(bool(visible[i]), i % 2 == 1);
+		EXPECT_EQ(bool(visible[i]), intersect(frustum, boxes[i]) != intersection::outside);
+	}
+}
@@ -0,0 +1,193 @@
+#include "system.hpp"
+
+// stl
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// putils
+#include "putils/forward_to.hpp"
+#include "putils/range.hpp"
+#include "putils/thread_name.hpp"
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/render/culling/helpers/aabb_tree.hpp"
+#include "kengine/render/culling/helpers/frustum.hpp"
+#include "kengine/render/data/camera.hpp"
+#include "kengine/render/data/culling.hpp"
+#include "kengine/render/data/drawable.hpp"
+#include "kengine/render/data/sprite.hpp"
+#include "kengine/render/data/viewport.hpp"
+#include "kengine/render/functions/update_culling.hpp"
+
+#ifndef KENGINE_RENDER_CULLING_AABB_MARGIN
+#define KENGINE_RENDER_CULLING_AABB_MARGIN .1f
+#endif
+
+namespace kengine::render::culling {
+	static constexpr auto log_category = "render_culling";
+	static constexpr size_t max_cameras = sizeof(std::uint64_t) * 8;
+
+	struct system {
+		entt::registry & r;
+		aabb_tree tree{ KENGINE_RENDER_CULLING_AABB_MARGIN };
+
+		// Leaf of the entity in `tree`
+		struct proxy {
+			int index = aabb_tree::null_node;
+		};
+
+		std::uint64_t used_camera_indices = 0;
+		bool warned_about_cameras = false;
+
+		const entt::scoped_connection connections[5] = {
+			r.on_destroy<proxy>().connect<&system::remove_from_tree>(this),
+			r.on_destroy<core::transform>().connect<&system::stop_tracking>(this),
+			r.on_destroy<render::drawable>().connect<&system::stop_tracking>(this),
+			r.on_construct<render::sprite_2d>().connect<&system::stop_tracking>(this),
+			r.on_destroy<culling_camera>().connect<&system::release_camera>(this),
+		};
+
+		system(entt::handle e) noexcept
+			: r(*e.registry()) {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, log, log_category, "Initializing");
+
+			e.emplace<update_culling>(putils_forward_to_this(update));
+		}
+
+		void update() noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Updating");
+
+			track_new_entities();
+			update_moved_entities();
+			track_new_cameras();
+			update_cameras();
+		}
+
+		// On-screen sprites aren't in world space, so they're never culled
+		void track_new_entities() noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto view = r.view<core::transform, render::drawable>(entt::exclude<proxy, render::sprite_2d>);
+			for (const auto e : view) {
+				kengine_logf(r, very_verbose, log_category, "Tracking {}", e);
+
+				const auto & transform = view.get<core::transform>(e);
+				r.emplace<proxy>(e, tree.insert(get_aabb(transform), e));
+				r.emplace<culled_entity>(e);
+			}
+		}
+
+		// Transforms are commonly modified in place rather than through `patch`, so compare them with the tree's leaves instead of relying on `on_update`.
+		// Leaves are enlarged, so most moves don't touch the tree
+		void update_moved_entities() noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			for (const auto & [e, proxy, transform] : r.view<proxy, core::transform>().each())
+				if (tree.move(proxy.index, get_aabb(transform)))
+					kengine_logf(r, very_verbose, log_category, "Re-inserted {}", e);
+		}
+
+		static aabb get_aabb(const core::transform & transform) noexcept {
+			const auto & box = transform.bounding_box;
+			putils::vec3f half_size{ std::abs(box.size.x) / 2.f, std::abs(box.size.y) / 2.f, std::abs(box.size.z) / 2.f };
+
+			// Rotated entities may extend past their bounding box, so use its bounding sphere instead
+			if (transform.yaw != 0.f || transform.pitch != 0.f || transform.roll != 0.f) {
+				const auto radius = std::sqrt(half_size.x * half_size.x + half_size.y * half_size.y + half_size.z * half_size.z);
+				half_size = { radius, radius, radius };
+			}
+
+			return { box.position - half_size, box.position + half_size };
+		}
+
+		void track_new_cameras() noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto view = r.view<render::camera, render::viewport>(entt::exclude<culling_camera>);
+			for (const auto camera_entity : view) {
+				if (used_camera_indices == ~std::uint64_t(0)) {
+					if (!warned_about_cameras)
+						kengine_logf(r, warning, log_category, "More than {} cameras, {} and any further ones won't be culled", max_cameras, camera_entity);
+					warned_about_cameras = true;
+					continue;
+				}
+
+				const auto index = size_t(std::countr_one(used_camera_indices));
+				kengine_logf(r, verbose, log_category, "Culling for camera {} with index {}", camera_entity, index);
+				used_camera_indices |= std::uint64_t(1) << index;
+				r.emplace<culling_camera>(camera_entity).index = index;
+			}
+		}
+
+		void update_cameras() noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto view = r.view<render::camera, render::viewport, culling_camera>();
+			for (const auto & [camera_entity, camera, viewport, culling] : view.each())
+				clear_visible_bits(culling);
+
+			// Queries only read the tree, so cameras can be processed in parallel
+			std::for_each(std::execution::par, putils_range(view), [&](entt::entity camera_entity) noexcept {
+				const putils::scoped_thread_name thread_name("Frustum culling");
+				const auto & [camera, viewport, culling] = view.get(camera_entity);
+
+				kengine_logf(r, very_verbose, log_category, "Culling for camera {}", camera_entity);
+				culling.visible_entities.clear();
+				tree.query(get_frustum(camera, viewport), culling.visible_entities);
+			});
+
+			for (const auto & [camera_entity, camera, viewport, culling] : view.each()) {
+				const auto bit = std::uint64_t(1) << culling.index;
+				for (const auto e : culling.visible_entities)
+					r.get<culled_entity>(e).visible_cameras |= bit;
+			}
+		}
+
+		void clear_visible_bits(const culling_camera & culling) noexcept {
+			const auto bit = std::uint64_t(1) << culling.index;
+			// Entities may have been destroyed or stopped being tracked since the last update
+			for (const auto e : culling.visible_entities)
+				if (const auto culled = r.try_get<culled_entity>(e))
+					culled->visible_cameras &= ~bit;
+		}
+
+		void remove_from_tree(entt::registry &, entt::entity e) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, very_verbose, log_category, "Removing {} from tree", e);
+
+			tree.remove(r.get<proxy>(e).index);
+		}
+
+		void stop_tracking(entt::registry &, entt::entity e) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			r.remove<proxy, culled_entity>(e);
+		}
+
+		void release_camera(entt::registry &, entt::entity camera_entity) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, verbose, log_category, "Releasing camera {}", camera_entity);
+
+			const auto & culling = r.get<culling_camera>(camera_entity);
+			clear_visible_bits(culling);
+			used_camera_indices &= ~(std::uint64_t(1) << culling.index);
+		}
+	};
+
+	DEFINE_KENGINE_SYSTEM_CREATOR(
+		system,
+		system::proxy
+	)
+}
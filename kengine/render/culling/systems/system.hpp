@@ -0,0 +1,8 @@
+#pragma once
+
+// kengine
+#include "kengine/system_creator/helpers/system_creator_helper.hpp"
+
+namespace kengine::render::culling {
+	DECLARE_KENGINE_SYSTEM_CREATOR(KENGINE_RENDER_CULLING_EXPORT, system)
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// stl
+#include <cstdint>
+#include <vector>
+
+// entt
+#include <entt/entity/entity.hpp>
+
+namespace kengine::render {
+	//! putils reflect all
+	struct culled_entity { // Tracked by a culling system
+		std::uint64_t visible_cameras = 0; // Bit `i` is set if the entity is in the frustum of the camera whose culling_camera::index is `i`
+	};
+
+	//! putils reflect all
+	struct culling_camera {
+		size_t index = 0;
+		std::vector<entt::entity> visible_entities;
+	};
+}
+
+#include "culling.rpp"
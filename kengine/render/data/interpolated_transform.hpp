@@ -0,0 +1,15 @@
+#pragma once
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+
+namespace kengine::render {
+	//! putils reflect all
+	//! used_types: [kengine::core::transform]
+	struct interpolated_transform {
+		core::transform previous;
+		core::transform current;
+	};
+}
+
+#include "interpolated_transform.rpp"
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+// kengine
+#include "kengine/base_function.hpp"
+
+namespace kengine::render {
+	using update_culling_signature = void();
+	//! putils reflect all
+	//! parents: [refltype::base]
+	struct update_culling : base_function<update_culling_signature> {};
+}
+
+#include "update_culling.rpp"
@@ -15,7 +15,7 @@
 
 // kengine
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
@@ -34,10 +34,10 @@ namespace kengine::render::glfw {
 		input_handler input;
 
 		struct processed_input_buffer {};
-		kengine::new_entity_processor<processed_input_buffer, input::buffer> input_buffer_processor{ r, putils_forward_to_this(set_input_buffer) };
+		kengine::reactive_entity_processor<processed_input_buffer, input::buffer> input_buffer_processor{ r, putils_forward_to_this(set_input_buffer) };
 
 		struct processed_window {};
-		kengine::new_entity_processor<processed_window, render::window, window_init> window_processor{ r, putils_forward_to_this(create_window) };
+		kengine::reactive_entity_processor<processed_window, render::window, window_init> window_processor{ r, putils_forward_to_this(create_window) };
 
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
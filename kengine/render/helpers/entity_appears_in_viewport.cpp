@@ -3,6 +3,7 @@
 // kengine
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/render/data/culling.hpp"
 #include "kengine/render/functions/appears_in_viewport.hpp"
 
 namespace kengine::render {
@@ -21,6 +22,16 @@ namespace kengine::render {
 			return true;
 		};
 
-		return wants_to_appear(entity, viewport_entity) && wants_to_appear(viewport_entity, entity);
+		if (!wants_to_appear(entity, viewport_entity) || !wants_to_appear(viewport_entity, entity))
+			return false;
+
+		const auto culled = r.try_get<culled_entity>(entity);
+		const auto camera = r.try_get<culling_camera>(viewport_entity);
+		if (culled && camera && !(culled->visible_cameras & (std::uint64_t(1) << camera->index))) {
+			kengine_logf(r, very_verbose, log_category, "{} is outside of {}'s frustum", entity, viewport_entity);
+			return false;
+		}
+
+		return true;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "interpolate_transform.hpp"
+
+// stl
+#include <cmath>
+#include <numbers>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/render/data/interpolated_transform.hpp"
+
+namespace kengine::render {
+	void record_transforms(entt::registry & r) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_log(r, very_verbose, "render", "Recording transforms");
+
+		for (const auto & [e, transform] : r.view<core::transform>().each()) {
+			if (const auto interpolated = r.try_get<interpolated_transform>(e)) {
+				interpolated->previous = interpolated->current;
+				interpolated->current = transform;
+			}
+			else
+				// Nothing to interpolate from until the next step
+				r.emplace<interpolated_transform>(e, transform, transform);
+		}
+
+		for (const auto e : r.view<interpolated_transform>(entt::exclude<core::transform>))
+			r.remove<interpolated_transform>(e);
+	}
+
+	static float interpolate_angle(float previous, float current, float alpha) noexcept {
+		// Take the shortest way around the circle
+		const auto delta = std::remainder(current - previous, 2.f * std::numbers::pi_v<float>);
+		return previous + delta * alpha;
+	}
+
+	core::transform interpolate_transform(const core::transform & previous, const core::transform & current, float alpha) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		core::transform ret;
+		ret.bounding_box.position = previous.bounding_box.position + (current.bounding_box.position - previous.bounding_box.position) * alpha;
+		ret.bounding_box.size = previous.bounding_box.size + (current.bounding_box.size - previous.bounding_box.size) * alpha;
+		ret.yaw = interpolate_angle(previous.yaw, current.yaw, alpha);
+		ret.pitch = interpolate_angle(previous.pitch, current.pitch, alpha);
+		ret.roll = interpolate_angle(previous.roll, current.roll, alpha);
+		return ret;
+	}
+
+	core::transform get_interpolated_transform(const entt::registry & r, entt::entity e, const core::transform & transform, float alpha) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (alpha >= 1.f)
+			return transform;
+
+		const auto interpolated = r.try_get<interpolated_transform>(e);
+		if (!interpolated)
+			return transform;
+
+		return interpolate_transform(interpolated->previous, interpolated->current, alpha);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+// entt
+#include <entt/entity/fwd.hpp>
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+
+namespace kengine::render {
+	KENGINE_RENDER_EXPORT void record_transforms(entt::registry & r) noexcept;
+	KENGINE_RENDER_EXPORT core::transform interpolate_transform(const core::transform & previous, const core::transform & current, float alpha) noexcept;
+	KENGINE_RENDER_EXPORT core::transform get_interpolated_transform(const entt::registry & r, entt::entity e, const core::transform & transform, float alpha) noexcept;
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <entt/entity/registry.hpp>
 
 // kengine
+#include "kengine/render/data/culling.hpp"
 #include "kengine/render/functions/appears_in_viewport.hpp"
 #include "kengine/render/helpers/entity_appears_in_viewport.hpp"
 
@@ -121,3 +122,29 @@ TEST(render, entity_appears_in_viewport_entity_refuses_viewport_accepts) {
 
 	EXPECT_FALSE(kengine::render::entity_appears_in_viewport(r, e, viewport));
 }
+
+TEST(render, entity_appears_in_viewport_culled) {
+	entt::registry r;
+	const auto e = r.create();
+	r.emplace<kengine::render::culled_entity>(e).visible_cameras = 0b01;
+
+	const auto visible_viewport = r.create();
+	r.emplace<kengine::render::culling_camera>(visible_viewport).index = 0;
+	EXPECT_TRUE(kengine::render::entity_appears_in_viewport(r, e, visible_viewport));
+
+	const auto culled_viewport = r.create();
+	r.emplace<kengine::render::culling_camera>(culled_viewport).index = 1;
+	EXPECT_FALSE(kengine::render::entity_appears_in_viewport(r, e, culled_viewport));
+
+	const auto unculled_viewport = r.create();
+	EXPECT_TRUE(kengine::render::entity_appears_in_viewport(r, e, unculled_viewport));
+}
+
+TEST(render, entity_appears_in_viewport_not_culled) {
+	entt::registry r;
+	const auto e = r.create();
+
+	const auto viewport = r.create();
+	r.emplace<kengine::render::culling_camera>(viewport).index = 0;
+	EXPECT_TRUE(kengine::render::entity_appears_in_viewport(r, e, viewport));
+}
@@ -0,0 +1,65 @@
+// stl
+#include <cmath>
+#include <numbers>
+
+// gtest
+#include <gtest/gtest.h>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/render/data/interpolated_transform.hpp"
+#include "kengine/render/helpers/interpolate_transform.hpp"
+
+TEST(render, interpolate_transform) {
+	const kengine::core::transform previous{
+		.bounding_box = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f } },
+		.yaw = 0.f,
+	};
+	const kengine::core::transform current{
+		.bounding_box = { { 2.f, 4.f, 6.f }, { 3.f, 3.f, 3.f } },
+		.yaw = 1.f,
+	};
+
+	const auto transform = kengine::render::interpolate_transform(previous, current, .5f);
+	EXPECT_EQ(transform.bounding_box.position, (putils::point3f{ 1.f, 2.f, 3.f }));
+	EXPECT_EQ(transform.bounding_box.size, (putils::vec3f{ 2.f, 2.f, 2.f }));
+	EXPECT_FLOAT_EQ(transform.yaw, .5f);
+}
+
+TEST(render, interpolate_transform_shortest_angle) {
+	const auto pi = std::numbers::pi_v<float>;
+	const kengine::core::transform previous{ .yaw = pi - .1f };
+	const kengine::core::transform current{ .yaw = -pi + .1f };
+
+	// Going through pi rather than through 0
+	const auto transform = kengine::render::interpolate_transform(previous, current, .5f);
+	EXPECT_NEAR(std::abs(transform.yaw), pi, .001f);
+}
+
+TEST(render, record_transforms) {
+	entt::registry r;
+
+	const auto e = r.create();
+	auto & transform = r.emplace<kengine::core::transform>(e);
+	transform.bounding_box.position.x = 0.f;
+	kengine::render::record_transforms(r);
+
+	transform.bounding_box.position.x = 2.f;
+	kengine::render::record_transforms(r);
+
+	// Moved after the last step, so ignored until the next one
+	transform.bounding_box.position.x = 42.f;
+
+	const auto & interpolated = r.get<kengine::render::interpolated_transform>(e);
+	EXPECT_EQ(interpolated.previous.bounding_box.position.x, 0.f);
+	EXPECT_EQ(interpolated.current.bounding_box.position.x, 2.f);
+
+	EXPECT_FLOAT_EQ(kengine::render::get_interpolated_transform(r, e, transform, .5f).bounding_box.position.x, 1.f);
+	EXPECT_FLOAT_EQ(kengine::render::get_interpolated_transform(r, e, transform, 1.f).bounding_box.position.x, 42.f);
+
+	r.remove<kengine::core::transform>(e);
+	kengine::render::record_transforms(r);
+	EXPECT_FALSE(r.all_of<kengine::render::interpolated_transform>(e));
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// stl
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <variant>
+#include <vector>
+
+// entt
+#include <entt/entity/entity.hpp>
+
+// kreogl
+#include "kreogl/world.hpp"
+
+// impl
+#include "debug_graphics.hpp"
+
+namespace kengine::render::kreogl {
+	// Persistent world attached to each window, whose objects are only added or removed when entities change
+	//! putils reflect name
+	//! class_name: kreogl_world
+	struct world {
+		using object_ptr = std::variant<
+			::kreogl::animated_object *,
+			::kreogl::sprite_2d *,
+			::kreogl::sprite_3d *,
+			::kreogl::text_2d *,
+			::kreogl::text_3d *,
+			kreogl::debug_graphics *,
+			::kreogl::directional_light *,
+			::kreogl::point_light *,
+			::kreogl::spot_light *>;
+
+		static constexpr size_t no_entry = std::numeric_limits<size_t>::max();
+
+		struct entry {
+			entt::entity entity = entt::null;
+			object_ptr object;
+			bool restricted = false; // The entity has an appears_in_viewport, so its visibility must be checked for each camera
+			bool culled = false; // The entity has a culled_entity, so it's only added for the cameras whose culling_camera sees it
+			std::uint64_t visible_cameras = ~std::uint64_t(0); // Bit `i` is set if the entity appears in the window's `i`th camera
+			size_t visibility_stamp = 0; // Last value of `world::visibility_stamp` for which a culling camera saw the entity
+			size_t next_entry_of_entity = no_entry; // Entities with several objects have several entries
+			bool in_world = false;
+		};
+
+		std::unique_ptr<::kreogl::world> ptr = std::make_unique<::kreogl::world>();
+		std::vector<entry> entries;
+		std::vector<size_t> first_entry_of_entity; // Indexed by entity id, as culling cameras only give us entities
+		std::vector<size_t> restricted_entries;
+		std::vector<size_t> culled_entries; // Culled entries which aren't restricted
+		std::vector<size_t> culled_entries_in_world;
+		std::vector<size_t> visible_culled_entries; // Scratch buffer, swapped with `culled_entries_in_world` for each camera
+		size_t visibility_stamp = 0;
+		bool needs_rebuild = true; // Objects were created or destroyed, so the pointers in `entries` may be stale
+		bool had_restricted_camera = false;
+		bool check_all_entries = false; // A camera has an appears_in_viewport, so every entry's visibility must be checked this frame
+	};
+}
+
+#include "world.rpp"
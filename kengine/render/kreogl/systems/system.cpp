@@ -3,8 +3,12 @@
 // stl
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <execution>
-#include <future>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 // entt
 #include <entt/entity/handle.hpp>
@@ -31,15 +35,18 @@
 #include "kreogl/world.hpp"
 
 // kengine
+#include "kengine/async/data/task.hpp"
 #include "kengine/async/helpers/process_results.hpp"
 #include "kengine/async/helpers/start_task.hpp"
 #include "kengine/config/data/configurable.hpp"
 #include "kengine/core/data/name.hpp"
 #include "kengine/core/data/transform.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
-#include "kengine/glm/helpers/get_model_matrix.hpp"
+#include "kengine/glm/data/world_matrix.hpp"
+#include "kengine/glm/helpers/batch_transform.hpp"
+#include "kengine/glm/helpers/get_world_matrix.hpp"
 #include "kengine/glm/helpers/glm_formatter.hpp"
 #include "kengine/imgui/data/context.hpp"
 #include "kengine/imgui/data/scale.hpp"
@@ -49,14 +56,18 @@
 #include "kengine/model/helpers/try_get.hpp"
 #include "kengine/main_loop/data/keep_alive.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
+#include "kengine/main_loop/helpers/declare_access.hpp"
 #include "kengine/render/animation/data/animation.hpp"
 #include "kengine/render/animation/data/files.hpp"
 #include "kengine/render/animation/data/model_animation.hpp"
 #include "kengine/render/data/asset.hpp"
 #include "kengine/render/data/camera.hpp"
+#include "kengine/render/data/culling.hpp"
 #include "kengine/render/data/debug_graphics.hpp"
 #include "kengine/render/data/drawable.hpp"
 #include "kengine/render/data/god_rays.hpp"
+#include "kengine/render/data/interpolated_transform.hpp"
 #include "kengine/render/data/light.hpp"
 #include "kengine/render/data/model_data.hpp"
 #include "kengine/render/data/no_shadow.hpp"
@@ -65,16 +76,20 @@
 #include "kengine/render/data/text.hpp"
 #include "kengine/render/data/viewport.hpp"
 #include "kengine/render/data/window.hpp"
+#include "kengine/render/functions/appears_in_viewport.hpp"
 #include "kengine/render/functions/get_entity_in_pixel.hpp"
 #include "kengine/render/functions/get_position_in_pixel.hpp"
+#include "kengine/render/functions/update_culling.hpp"
 #include "kengine/render/glfw/data/window.hpp"
 #include "kengine/render/helpers/convert_to_screen_percentage.hpp"
 #include "kengine/render/helpers/entity_appears_in_viewport.hpp"
 #include "kengine/render/helpers/get_facings.hpp"
 #include "kengine/render/helpers/get_viewport_for_pixel.hpp"
+#include "kengine/render/helpers/interpolate_transform.hpp"
 #include "kengine/render/kreogl/data/animation_files.hpp"
 #include "kengine/render/kreogl/data/debug_graphics.hpp"
 #include "kengine/render/kreogl/data/model.hpp"
+#include "kengine/render/kreogl/data/world.hpp"
 #include "kengine/render/kreogl/helpers/putils_to_glm.hpp"
 #include "kengine/render/kreogl/shaders/highlight_shader.hpp"
 #include "kengine/skeleton/data/bone_names.hpp"
@@ -87,16 +102,16 @@ namespace kengine::render::kreogl {
 		entt::registry & r;
 
 		struct processed_window {};
-		kengine::new_entity_processor<processed_window, render::window> window_processor{ r, putils_forward_to_this(create_window) };
+		kengine::reactive_entity_processor<processed_window, render::window> window_processor{ r, putils_forward_to_this(create_window) };
 
 		struct processed_model {};
-		kengine::new_entity_processor<processed_model, render::asset> model_processor{ r, putils_forward_to_this(create_model_from_disk) };
+		kengine::reactive_entity_processor<processed_model, render::asset> model_processor{ r, putils_forward_to_this(create_model_from_disk) };
 
 		struct processed_animation_files {};
-		kengine::new_entity_processor<processed_animation_files, render::animation::files> animation_files_processor{ r, putils_forward_to_this(load_animation_files) };
+		kengine::reactive_entity_processor<processed_animation_files, render::animation::files> animation_files_processor{ r, putils_forward_to_this(load_animation_files) };
 
 		struct processed_sky_box {};
-		kengine::new_entity_processor<processed_sky_box, render::sky_box_model> sky_box_processor{ r, putils_forward_to_this(create_sky_box_from_disk) };
+		kengine::reactive_entity_processor<processed_sky_box, render::sky_box_model> sky_box_processor{ r, putils_forward_to_this(create_sky_box_from_disk) };
 
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
@@ -104,6 +119,7 @@ namespace kengine::render::kreogl {
 			kengine_log(r, log, log_category, "Initializing");
 
 			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute_frame));
 
 			e.emplace<core::name>("kreogl");
 			e.emplace<config::configurable>();
@@ -112,6 +128,33 @@ namespace kengine::render::kreogl {
 			e.emplace<render::get_entity_in_pixel>(putils_forward_to_this(get_entity_in_pixel));
 			e.emplace<render::get_position_in_pixel>(putils_forward_to_this(get_position_in_pixel));
 
+			// OpenGL and ImGui calls have to be made from the main thread
+			main_loop::declare_access(
+				e,
+				main_loop::reads<
+					core::transform, kengine::model::instance, imgui::scale, glfw::window,
+					render::asset, render::model_data, render::drawable, render::camera, render::debug_graphics, render::god_rays, render::no_shadow,
+					render::dir_light, render::point_light, render::spot_light, render::sky_box, render::sky_box_model,
+					render::sprite_2d, render::sprite_3d, render::text_2d, render::text_3d, render::animation::files,
+					render::appears_in_viewport>{},
+				main_loop::writes<
+					processed_window, processed_model, processed_animation_files, processed_sky_box,
+					// update_culling moves entities in the culling system's tree and fills these components
+					render::update_culling, render::culled_entity, render::culling_camera,
+					render::window, render::viewport, render::animation::animation, render::animation::model_animation,
+					skeleton::bone_names, skeleton::bone_matrices, glm::world_matrix, render::interpolated_transform, glfw::window_init, imgui::context, async::task,
+					animation_files, debug_graphics, model, world,
+					::kreogl::animated_object, ::kreogl::camera, ::kreogl::directional_light, ::kreogl::point_light, ::kreogl::spot_light,
+					::kreogl::skybox_texture, ::kreogl::sprite_2d, ::kreogl::sprite_3d, ::kreogl::text_2d, ::kreogl::text_3d,
+					::kreogl::texture, ::kreogl::window>{},
+				true
+			);
+
+			kengine::async::prepare_tasks<::kreogl::texture_data>(r);
+			kengine::async::prepare_tasks<::kreogl::assimp_model_data>(r);
+			kengine::async::prepare_tasks<animation_files_task_result>(r);
+			kengine::async::prepare_tasks<sky_box_task_result>(r);
+
 			window_processor.process();
 			model_processor.process();
 			animation_files_processor.process();
@@ -181,7 +224,14 @@ namespace kengine::render::kreogl {
 			load_models_to_opengl();
 			create_missing_objects();
 			tick_animations(delta_time);
-			draw();
+			record_transforms(r);
+		}
+
+		void execute_frame(float delta_time, float alpha) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Executing frame");
+
+			draw(alpha);
 		}
 
 		void create_model_from_disk(entt::entity model_entity, const render::asset & asset) noexcept {
@@ -190,31 +240,32 @@ namespace kengine::render::kreogl {
 
 			const auto & file = asset.file.c_str();
 
+			// Tasks may start long after this returns, so they capture a copy of the file name instead of pointing into the component
 			if (::kreogl::texture_data::is_supported_format(file))
 				kengine::async::start_task(
 					r, model_entity,
 					async::task::string("kreogl: load {}", file),
-					std::async(std::launch::async, [&file] {
+					[file = asset.file] {
 						KENGINE_PROFILING_SCOPE;
-						const putils::scoped_thread_name thread_name(putils::string<64>("Load {}", file));
-						return ::kreogl::texture_data(file);
-					})
+						const putils::scoped_thread_name thread_name(putils::string<64>("Load {}", file.c_str()));
+						return ::kreogl::texture_data(file.c_str());
+					}
 				);
 			else if (::kreogl::assimp::is_supported_file_format(asset.file.c_str()))
 				kengine::async::start_task(
 					r, model_entity,
 					async::task::string("kreogl: load {}", file),
-					std::async(std::launch::async, [&file] {
+					[file = asset.file] {
 						KENGINE_PROFILING_SCOPE;
-						const putils::scoped_thread_name thread_name(putils::string<64>("Load {}", file));
-						return ::kreogl::assimp::load_model_data(file);
-					})
+						const putils::scoped_thread_name thread_name(putils::string<64>("Load {}", file.c_str()));
+						return ::kreogl::assimp::load_model_data(file.c_str());
+					}
 				);
 		}
 
 		struct animation_files_task_result {
 			struct animation_file {
-				const char * file_name;
+				std::string file_name;
 				std::unique_ptr<::kreogl::animation_file> kreogl_animation_file;
 			};
 			entt::entity model_entity;
@@ -229,13 +280,13 @@ namespace kengine::render::kreogl {
 			kengine::async::start_task(
 				r, task_entity,
 				async::task::string("kreogl: load animation files for {}", model_entity),
-				std::async(std::launch::async, [&animation_files, model_entity] {
+				[files = animation_files.list, model_entity] {
 					KENGINE_PROFILING_SCOPE;
 					const putils::scoped_thread_name thread_name(putils::string<64>("Load animation files for {}", model_entity));
 
 					animation_files_task_result result;
 					result.model_entity = model_entity;
-					result.animation_files.resize(animation_files.list.size());
+					result.animation_files.resize(files.size());
 
 					// Profiling this shows that:
 					// * with par_unseq, each thread takes ~700ms
@@ -243,15 +294,16 @@ namespace kengine::render::kreogl {
 					// This isn't a performance loss so I'm leaving it as is, but I haven't found an explanation so far
 					std::transform(
 						std::execution::par_unseq,
-						putils_range(animation_files.list),
+						putils_range(files),
 						result.animation_files.begin(),
 						[](const std::string & file) {
 							const putils::scoped_thread_name thread_name(putils::string<128>("Animation loader for {}", file));
-							return animation_files_task_result::animation_file{ file.c_str(), ::kreogl::assimp::load_animation_file(file.c_str()) };
+							return animation_files_task_result::animation_file{ file, ::kreogl::assimp::load_animation_file(file.c_str()) };
 						}
 					);
 					return result;
-				})
+				},
+				async::priority::low
 			);
 		}
 
@@ -289,7 +341,7 @@ namespace kengine::render::kreogl {
 			kengine::async::start_task(
 				r, task_entity,
 				async::task::string("kreogl: load sky_box for {}", sky_box_entity),
-				std::async(std::launch::async, [sky_box_entity, &sky_box] {
+				[sky_box_entity, sky_box] {
 					KENGINE_PROFILING_SCOPE;
 					const putils::scoped_thread_name thread_name(putils::string<64>("Load sky_box for {}", sky_box_entity));
 
@@ -299,7 +351,7 @@ namespace kengine::render::kreogl {
 						sky_box.top.c_str(), sky_box.bottom.c_str(),
 						sky_box.front.c_str(), sky_box.back.c_str()
 					};
-				})
+				}
 			);
 		}
 
@@ -318,11 +370,13 @@ namespace kengine::render::kreogl {
 				const auto & asset = r.get<render::asset>(e);
 				add_animations_to_model_animation_component(r.get_or_emplace<animation::model_animation>(e), asset.file.c_str(), *model_data.animations);
 				if (model_data.skeleton) {
-					auto & bone_names = r.emplace<skeleton::bone_names>(e);
+					// Fill the names before emplacing them, so that on_construct listeners see the complete skeleton
+					skeleton::bone_names bone_names;
 					for (const auto & mesh : model_data.skeleton->meshes)
 						bone_names.meshes.push_back(skeleton::bone_names::mesh{
 							.bone_names = mesh.bone_names,
 						});
+					r.emplace<skeleton::bone_names>(e, std::move(bone_names));
 				}
 
 				r.emplace<model>(e, ::kreogl::assimp::load_animated_model(std::move(model_data)));
@@ -332,7 +386,7 @@ namespace kengine::render::kreogl {
 				auto & model_animation = r.get_or_emplace<animation::model_animation>(result.model_entity);
 				auto & kreogl_animation_files = r.emplace<animation_files>(result.model_entity);
 				for (auto & animation_file : result.animation_files) {
-					add_animations_to_model_animation_component(model_animation, animation_file.file_name, *animation_file.kreogl_animation_file);
+					add_animations_to_model_animation_component(model_animation, animation_file.file_name.c_str(), *animation_file.kreogl_animation_file);
 					kreogl_animation_files.files.push_back(std::move(animation_file.kreogl_animation_file));
 				}
 				r.destroy(task_entity);
@@ -411,9 +465,13 @@ namespace kengine::render::kreogl {
 				if (const auto kreogl_model = r.try_get<model>(model_entity)) {
 					kengine_logf(r, verbose, log_category, "Creating animated_object to {}", entity);
 					r.emplace<::kreogl::animated_object>(entity).model = kreogl_model->ptr.get();
-					if (r.all_of<skeleton::bone_names>(model_entity)) {
+					if (const auto bone_names = r.try_get<skeleton::bone_names>(model_entity)) {
 						kengine_logf(r, verbose, log_category, "Adding skeleton to {}", entity);
-						r.emplace<skeleton::bone_matrices>(entity);
+						auto & skeleton = r.emplace<skeleton::bone_matrices>(entity);
+						// Sized to the model's actual bone count, so that animations never reallocate
+						skeleton.meshes.resize(bone_names->meshes.size());
+						for (size_t i = 0; i < bone_names->meshes.size(); ++i)
+							skeleton.meshes[i].bone_mats_mesh_space.resize(bone_names->meshes[i].bone_names.size());
 					}
 				}
 
@@ -464,8 +522,9 @@ namespace kengine::render::kreogl {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Ticking animations");
 
+			// Not vectorized, as ticking may allocate and naming threads may lock
 			const auto view = r.view<::kreogl::animated_object, animation::animation>();
-			std::for_each(std::execution::par_unseq, putils_range(view), [&](entt::entity entity) noexcept {
+			std::for_each(std::execution::par, putils_range(view), [&](entt::entity entity) noexcept {
 				const putils::scoped_thread_name thread_name("Animation ticker");
 				const auto & [kreogl_object, animation] = view.get(entity);
 				tick_object_animation(delta_time, entity, kreogl_object, animation);
@@ -487,21 +546,19 @@ namespace kengine::render::kreogl {
 			kengine_logf(r, very_verbose, log_category, "Syncing animation time and skeleton for {}", entity);
 			animation.current_time = kreogl_object.animation->current_time;
 
+			// Bone-space matrices are only used for skinning, so they stay in kreogl. Only mesh-space matrices are exposed to other systems
 			auto & skeleton = r.get<skeleton::bone_matrices>(entity);
 			const auto nb_meshes = kreogl_object.skeleton.meshes.size();
 			skeleton.meshes.resize(nb_meshes);
 			for (size_t i = 0; i < nb_meshes; ++i) {
 				const auto & kreogl_mesh = kreogl_object.skeleton.meshes[i];
 				auto & mesh = skeleton.meshes[i];
-
-				kengine_assert(r, kreogl_mesh.bone_mats_bone_space.size() < putils::lengthof(mesh.bone_mats_bone_space));
-				std::ranges::copy(kreogl_mesh.bone_mats_bone_space, mesh.bone_mats_bone_space);
-				kengine_assert(r, kreogl_mesh.bone_mats_mesh_space.size() < putils::lengthof(mesh.bone_mats_mesh_space));
-				std::ranges::copy(kreogl_mesh.bone_mats_mesh_space, mesh.bone_mats_mesh_space);
+				// Doesn't reallocate once sized to the bone count
+				mesh.bone_mats_mesh_space.assign(kreogl_mesh.bone_mats_mesh_space.begin(), kreogl_mesh.bone_mats_mesh_space.end());
 			}
 		}
 
-		void draw() noexcept {
+		void draw(float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Drawing");
 
@@ -512,6 +569,12 @@ namespace kengine::render::kreogl {
 			update_imgui_scale();
 			ImGui::Render();
 
+			for (const auto & [culling_entity, update] : r.view<update_culling>().each())
+				update();
+
+			sync_all_objects(alpha);
+			sync_all_lights(alpha);
+
 			for (const auto & [window_entity, kreogl_window] : view.each()) {
 				kengine_logf(r, very_verbose, log_category, "Drawing to {}", window_entity);
 				kreogl_window.prepare_for_draw();
@@ -551,26 +614,38 @@ namespace kengine::render::kreogl {
 				ImGui::NewFrame();
 		}
 
+		std::vector<entt::entity> window_cameras; // Scratch buffer for draw_to_cameras
 		void draw_to_cameras(entt::entity window_entity, ::kreogl::window & kreogl_window) noexcept {
 			KENGINE_PROFILING_SCOPE;
 
+			window_cameras.clear();
 			for (auto [camera_entity, camera, viewport] : r.view<camera, viewport>().each()) {
 				if (viewport.window != entt::null && viewport.window != window_entity) {
 					kengine_logf(r, very_verbose, log_category, "Skipping camera {} because its viewport's window ({}) doesn't match", camera_entity, viewport.window);
 					continue;
 				}
 
-				kengine_logf(r, very_verbose, log_category, "Drawing to camera {}", camera_entity);
-
 				if (viewport.window == entt::null) {
 					kengine_logf(r, verbose, log_category, "Setting target window for viewport in {}", camera_entity);
 					viewport.window = window_entity;
 					create_kreogl_camera(camera_entity, viewport);
 				}
 
-				auto & kreogl_camera = r.get<::kreogl::camera>(camera_entity);
+				window_cameras.push_back(camera_entity);
+			}
+
+			auto & world = r.get_or_emplace<kreogl::world>(window_entity);
+			if (world.needs_rebuild)
+				rebuild_world(world);
+			update_visibility(world);
+
+			for (size_t camera_index = 0; camera_index < window_cameras.size(); ++camera_index) {
+				const auto camera_entity = window_cameras[camera_index];
+				kengine_logf(r, very_verbose, log_category, "Drawing to camera {}", camera_entity);
+
+				const auto & [camera, viewport, kreogl_camera] = r.get<render::camera, render::viewport, ::kreogl::camera>(camera_entity);
 				sync_camera_properties(kreogl_camera, camera, viewport);
-				draw_to_camera(kreogl_window, camera_entity, kreogl_camera);
+				draw_to_camera(kreogl_window, world, camera_entity, camera_index, kreogl_camera);
 			}
 		}
 
@@ -610,11 +685,12 @@ namespace kengine::render::kreogl {
 		std::optional<kreogl::highlight_shader> highlight_shader;
 		std::optional<::kreogl::shader_pipeline> shader_pipeline;
 
-		void draw_to_camera(::kreogl::window & kreogl_window, entt::entity camera_entity, const ::kreogl::camera & kreogl_camera) noexcept {
+		void draw_to_camera(::kreogl::window & kreogl_window, kreogl::world & world, entt::entity camera_entity, size_t camera_index, const ::kreogl::camera & kreogl_camera) noexcept {
 			KENGINE_PROFILING_SCOPE;
 
-			::kreogl::world kreogl_world;
-			sync_everything(kreogl_world, camera_entity);
+			apply_visibility(world, camera_index, camera_entity);
+			sync_on_screen_properties(camera_entity);
+			sync_sky_box(*world.ptr, camera_entity);
 
 			if (!shader_pipeline) {
 				highlight_shader = kreogl::highlight_shader{ r };
@@ -626,68 +702,367 @@ namespace kengine::render::kreogl {
 				}();
 			}
 
-			kreogl_window.draw_world_to_camera(kreogl_world, kreogl_camera, *shader_pipeline);
+			kreogl_window.draw_world_to_camera(*world.ptr, kreogl_camera, *shader_pipeline);
+		}
+
+		void invalidate_worlds(entt::registry &, entt::entity) noexcept {
+			for (auto [window_entity, world] : r.view<kreogl::world>().each())
+				world.needs_rebuild = true;
+		}
+
+		// Worlds reference objects by pointer, and only contain entities with the right components, so any of these being created or destroyed invalidates them
+		template<typename... Comps>
+		std::vector<entt::scoped_connection> connect_world_invalidation() noexcept {
+			std::vector<entt::scoped_connection> ret;
+			(ret.emplace_back(r.on_construct<Comps>().template connect<&system::invalidate_worlds>(this)), ...);
+			(ret.emplace_back(r.on_destroy<Comps>().template connect<&system::invalidate_worlds>(this)), ...);
+			return ret;
 		}
 
-		void sync_everything(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		const std::vector<entt::scoped_connection> world_connections = connect_world_invalidation<
+			::kreogl::animated_object,
+			::kreogl::sprite_2d,
+			::kreogl::sprite_3d,
+			::kreogl::text_2d,
+			::kreogl::text_3d,
+			kreogl::debug_graphics,
+			::kreogl::directional_light,
+			::kreogl::point_light,
+			::kreogl::spot_light,
+			kengine::model::instance,
+			core::transform,
+			render::drawable,
+			render::sprite_2d,
+			render::sprite_3d,
+			render::text_2d,
+			render::text_3d,
+			render::debug_graphics,
+			render::dir_light,
+			render::point_light,
+			render::spot_light,
+			render::appears_in_viewport,
+			render::culled_entity>();
+
+		void rebuild_world(kreogl::world & world) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing everything for camera {}", camera_entity);
+			kengine_log(r, verbose, log_category, "Rebuilding world");
+
+			world.ptr = std::make_unique<::kreogl::world>();
+			world.entries.clear();
+			world.restricted_entries.clear();
+			world.culled_entries.clear();
+			world.culled_entries_in_world.clear();
+			std::ranges::fill(world.first_entry_of_entity, kreogl::world::no_entry);
+			world.needs_rebuild = false;
+
+			const auto add_entry = [&](entt::entity entity, kreogl::world::object_ptr object) noexcept {
+				const auto index = world.entries.size();
+				auto & entry = world.entries.emplace_back();
+				entry.entity = entity;
+				entry.object = object;
+
+				const auto entity_id = size_t(entt::to_entity(entity));
+				if (entity_id >= world.first_entry_of_entity.size())
+					world.first_entry_of_entity.resize(entity_id + 1, kreogl::world::no_entry);
+				entry.next_entry_of_entity = world.first_entry_of_entity[entity_id];
+				world.first_entry_of_entity[entity_id] = index;
+
+				// Restricted and culled entries are added once we know which cameras they appear in
+				entry.restricted = r.all_of<appears_in_viewport>(entity);
+				entry.culled = r.all_of<culled_entity>(entity);
+				if (entry.restricted)
+					world.restricted_entries.push_back(index);
+				else if (entry.culled)
+					world.culled_entries.push_back(index);
+				else {
+					add_to_world(*world.ptr, object);
+					entry.in_world = true;
+				}
+			};
 
-			sync_all_objects(kreogl_world, camera_entity);
-			sync_all_lights(kreogl_world, camera_entity);
+			for (const auto & [entity, instance, transform, drawable, kreogl_object] : r.view<kengine::model::instance, core::transform, render::drawable, ::kreogl::animated_object>().each())
+				add_entry(entity, &kreogl_object);
+			for (const auto & [entity, instance, transform, drawable, sprite_2d, kreogl_sprite_2d] : r.view<kengine::model::instance, core::transform, render::drawable, sprite_2d, ::kreogl::sprite_2d>().each())
+				add_entry(entity, &kreogl_sprite_2d);
+			for (const auto & [entity, instance, transform, drawable, sprite_3d, kreogl_sprite_3d] : r.view<kengine::model::instance, core::transform, render::drawable, sprite_3d, ::kreogl::sprite_3d>().each())
+				add_entry(entity, &kreogl_sprite_3d);
+			for (const auto & [entity, transform, text_2d, kreogl_text_2d] : r.view<core::transform, text_2d, ::kreogl::text_2d>().each())
+				add_entry(entity, &kreogl_text_2d);
+			for (const auto & [entity, transform, text_3d, kreogl_text_3d] : r.view<core::transform, text_3d, ::kreogl::text_3d>().each())
+				add_entry(entity, &kreogl_text_3d);
+			for (const auto & [entity, transform, debug_graphics, kreogl_debug_graphics] : r.view<core::transform, render::debug_graphics, kreogl::debug_graphics>().each())
+				add_entry(entity, &kreogl_debug_graphics);
+			for (const auto & [entity, dir_light, kreogl_dir_light] : r.view<dir_light, ::kreogl::directional_light>().each())
+				add_entry(entity, &kreogl_dir_light);
+			for (const auto & [entity, transform, point_light, kreogl_point_light] : r.view<core::transform, point_light, ::kreogl::point_light>().each())
+				add_entry(entity, &kreogl_point_light);
+			for (const auto & [entity, transform, spot_light, kreogl_spot_light] : r.view<core::transform, spot_light, ::kreogl::spot_light>().each())
+				add_entry(entity, &kreogl_spot_light);
+		}
+
+		static void add_to_world(::kreogl::world & kreogl_world, const kreogl::world::object_ptr & object) noexcept {
+			std::visit(
+				[&](auto * ptr) noexcept {
+					if constexpr (std::is_same_v<std::decay_t<decltype(*ptr)>, kreogl::debug_graphics>) {
+						for (const auto & element : ptr->elements)
+							kreogl_world.add(element);
+					}
+					else
+						kreogl_world.add(*ptr);
+				},
+				object
+			);
+		}
+
+		static void remove_from_world(::kreogl::world & kreogl_world, const kreogl::world::object_ptr & object) noexcept {
+			std::visit(
+				[&](auto * ptr) noexcept {
+					if constexpr (std::is_same_v<std::decay_t<decltype(*ptr)>, kreogl::debug_graphics>) {
+						for (const auto & element : ptr->elements)
+							kreogl_world.remove(element);
+					}
+					else
+						kreogl_world.remove(*ptr);
+				},
+				object
+			);
 		}
 
-		void sync_common_properties(auto & kreogl_object, entt::entity entity, const kengine::model::instance * instance, const core::transform & transform, const auto & colored_component, ::kreogl::world & kreogl_world) noexcept {
+		static constexpr size_t max_cameras_per_window = sizeof(std::uint64_t) * 8;
+
+		// Computes the cameras each restricted entry appears in
+		void update_visibility(kreogl::world & world) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing common properties for {}", entity);
+			kengine_log(r, very_verbose, log_category, "Updating visibility");
+
+			if (window_cameras.size() > max_cameras_per_window)
+				kengine_logf(r, warning, log_category, "Window has more than {} cameras, visibility won't be checked for the extra ones", max_cameras_per_window);
+
+			bool has_restricted_camera = false;
+			for (const auto camera_entity : window_cameras)
+				if (r.all_of<appears_in_viewport>(camera_entity))
+					has_restricted_camera = true;
+
+			// Restricted cameras may refuse any entity. Once they stop being restricted, all entries must be checked one last time to restore them
+			world.check_all_entries = has_restricted_camera || world.had_restricted_camera;
+			world.had_restricted_camera = has_restricted_camera;
+
+			const auto nb_cameras = std::min(window_cameras.size(), max_cameras_per_window);
+			const auto compute_visible_cameras = [&](kreogl::world::entry & entry) noexcept {
+				entry.visible_cameras = ~std::uint64_t(0);
+				for (size_t i = 0; i < nb_cameras; ++i)
+					if (!entity_appears_in_viewport(r, entry.entity, window_cameras[i]))
+						entry.visible_cameras &= ~(std::uint64_t(1) << i);
+			};
+
+			if (world.check_all_entries)
+				for (auto & entry : world.entries)
+					compute_visible_cameras(entry);
+			else
+				for (const auto index : world.restricted_entries)
+					compute_visible_cameras(world.entries[index]);
+		}
+
+		static void set_in_world(kreogl::world & world, kreogl::world::entry & entry, bool visible) noexcept {
+			if (visible == entry.in_world)
+				return;
+
+			if (visible)
+				add_to_world(*world.ptr, entry.object);
+			else
+				remove_from_world(*world.ptr, entry.object);
+			entry.in_world = visible;
+		}
+
+		// Adds and removes the entries whose visibility differs from the previous camera's
+		void apply_visibility(kreogl::world & world, size_t camera_index, entt::entity camera_entity) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto is_visible = [&](const kreogl::world::entry & entry) noexcept {
+				return camera_index >= max_cameras_per_window || (entry.visible_cameras & (std::uint64_t(1) << camera_index));
+			};
+
+			if (world.check_all_entries) {
+				world.culled_entries_in_world.clear();
+				for (size_t index = 0; index < world.entries.size(); ++index) {
+					auto & entry = world.entries[index];
+					set_in_world(world, entry, is_visible(entry));
+					if (entry.culled && !entry.restricted && entry.in_world)
+						world.culled_entries_in_world.push_back(index);
+				}
+				return;
+			}
+
+			for (const auto index : world.restricted_entries) {
+				auto & entry = world.entries[index];
+				set_in_world(world, entry, is_visible(entry));
+			}
+
+			apply_culling(world, camera_entity);
+		}
+
+		// Only goes through the entities seen by the camera and by the previous one, so that cost scales with what's on screen rather than with the size of the world
+		void apply_culling(kreogl::world & world, entt::entity camera_entity) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			if (world.culled_entries.empty())
+				return;
+
+			const auto culling = r.try_get<culling_camera>(camera_entity);
+			if (!culling) {
+				kengine_logf(r, very_verbose, log_category, "Camera {} isn't culled, adding all culled entries", camera_entity);
+				for (const auto index : world.culled_entries)
+					set_in_world(world, world.entries[index], true);
+				world.culled_entries_in_world = world.culled_entries;
+				return;
+			}
+
+			++world.visibility_stamp;
+			world.visible_culled_entries.clear();
+			for (const auto entity : culling->visible_entities) {
+				const auto entity_id = size_t(entt::to_entity(entity));
+				if (entity_id >= world.first_entry_of_entity.size())
+					continue;
+
+				for (auto index = world.first_entry_of_entity[entity_id]; index != kreogl::world::no_entry; index = world.entries[index].next_entry_of_entity) {
+					auto & entry = world.entries[index];
+					// An entity's entries share its flags, and its id may have been recycled since the last rebuild
+					if (entry.entity != entity || !entry.culled || entry.restricted)
+						break;
+
+					entry.visibility_stamp = world.visibility_stamp;
+					set_in_world(world, entry, true);
+					world.visible_culled_entries.push_back(index);
+				}
+			}
 
+			for (const auto index : world.culled_entries_in_world) {
+				auto & entry = world.entries[index];
+				if (entry.visibility_stamp != world.visibility_stamp)
+					set_in_world(world, entry, false);
+			}
+
+			std::swap(world.culled_entries_in_world, world.visible_culled_entries);
+		}
+
+		// Objects whose model matrix must be computed, gathered so that they can all be computed at once by the batch layer
+		struct model_matrix_batch {
+			std::vector<core::transform> transforms;
+			std::vector<const core::transform *> model_transforms;
+			std::vector<::glm::mat4> matrices;
+			std::vector<::glm::mat4 *> targets;
+			// Entities whose world_matrix cache is refreshed with the result, or null for moving objects
+			std::vector<entt::entity> cached_entities;
+		};
+		model_matrix_batch model_matrices;
+
+		static bool same_transform(const core::transform & lhs, const core::transform & rhs) noexcept {
+			return std::memcmp(&lhs, &rhs, sizeof(core::transform)) == 0;
+		}
+
+		// Objects are only moving between simulation steps if their last two recorded transforms differ
+		bool is_moving(entt::entity entity, float alpha) const noexcept {
+			if (alpha >= 1.f)
+				return false;
+			const auto interpolated = r.try_get<render::interpolated_transform>(entity);
+			return interpolated && !same_transform(interpolated->previous, interpolated->current);
+		}
+
+		// Matrices of objects that aren't moving come from their world_matrix cache. Moving objects, and those whose cache is out of date, are queued for the batch
+		void queue_model_matrix(::glm::mat4 & target, entt::entity entity, const kengine::model::instance * instance, const core::transform & transform, float alpha) noexcept {
 			const core::transform * model_transform = nullptr;
 			if (instance)
 				model_transform = kengine::model::try_get<core::transform>(r, *instance);
-			kreogl_object.transform = glm::get_model_matrix(transform, model_transform);
+
+			const auto moving = is_moving(entity, alpha);
+			if (!moving) {
+				if (const auto cached = glm::try_get_world_matrix({ r, entity }, transform, model_transform)) {
+					target = cached->model_to_world;
+					return;
+				}
+			}
+
+			model_matrices.transforms.push_back(transform);
+			model_matrices.model_transforms.push_back(model_transform);
+			model_matrices.targets.push_back(&target);
+			model_matrices.cached_entities.push_back(moving ? entt::null : entity);
+		}
+
+		// Interpolated transforms change every frame for moving objects, so their matrices are recomputed in batches rather than cached.
+		// Other objects' results are cached, so they're only recomputed once their transform changes
+		void sync_model_matrices() noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, very_verbose, log_category, "Syncing {} model matrices", model_matrices.targets.size());
+
+			model_matrices.matrices.resize(model_matrices.transforms.size());
+			glm::batch::get_model_matrices(model_matrices.transforms, model_matrices.model_transforms, model_matrices.matrices);
+			for (size_t i = 0; i < model_matrices.targets.size(); ++i) {
+				*model_matrices.targets[i] = model_matrices.matrices[i];
+				if (model_matrices.cached_entities[i] != entt::null)
+					glm::set_world_matrix({ r, model_matrices.cached_entities[i] }, model_matrices.transforms[i], model_matrices.model_transforms[i], model_matrices.matrices[i]);
+			}
+
+			model_matrices.transforms.clear();
+			model_matrices.model_transforms.clear();
+			model_matrices.targets.clear();
+			model_matrices.cached_entities.clear();
+		}
+
+		void sync_common_properties(auto & kreogl_object, entt::entity entity, const auto & colored_component) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, very_verbose, log_category, "Syncing common properties for {}", entity);
+
 			kreogl_object.color = toglm(colored_component.color);
 			kreogl_object.user_data[0] = float(entity);
-
-			kreogl_world.add(kreogl_object);
 		};
 
-		void sync_all_objects(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		// Objects are drawn between their last two simulation steps, according to alpha
+		void sync_all_objects(float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing all objects for camera {}", camera_entity);
+			kengine_log(r, very_verbose, log_category, "Syncing all objects");
+
+			// Entities outside of every camera's frustum don't need to be synced, unless some cameras aren't culled
+			const auto unculled_cameras = r.view<render::camera>(entt::exclude<culling_camera>);
+			const auto all_cameras_culled = unculled_cameras.begin() == unculled_cameras.end();
+			const auto is_culled_everywhere = [&](entt::entity entity) noexcept {
+				if (!all_cameras_culled)
+					return false;
+				const auto culled = r.try_get<culled_entity>(entity);
+				return culled && culled->visible_cameras == 0;
+			};
 
 			for (const auto & [entity, instance, transform, drawable, kreogl_object] : r.view<kengine::model::instance, core::transform, render::drawable, ::kreogl::animated_object>().each()) {
-				if (!entity_appears_in_viewport(r, entity, camera_entity))
+				if (is_culled_everywhere(entity))
 					continue;
-				sync_common_properties(kreogl_object, entity, &instance, transform, drawable, kreogl_world);
+
+				queue_model_matrix(kreogl_object.transform, entity, &instance, get_interpolated_transform(r, entity, transform, alpha), alpha);
+				sync_common_properties(kreogl_object, entity, drawable);
 				sync_animation_properties(kreogl_object, entity, instance);
 				kreogl_object.cast_shadows = !r.all_of<no_shadow>(entity);
 			}
 
-			sync_sprite_2d_properties(kreogl_world, camera_entity);
+			// On-screen objects' matrices depend on the camera, so they're computed in sync_on_screen_properties
+			for (const auto & [sprite_entity, instance, transform, drawable, sprite_2d, kreogl_sprite_2d] : r.view<kengine::model::instance, core::transform, render::drawable, sprite_2d, ::kreogl::sprite_2d>().each())
+				sync_common_properties(kreogl_sprite_2d, sprite_entity, drawable);
+
 			for (const auto & [sprite_entity, instance, transform, drawable, kreogl_sprite_3d] : r.view<kengine::model::instance, core::transform, render::drawable, sprite_3d, ::kreogl::sprite_3d>().each()) {
-				if (!entity_appears_in_viewport(r, sprite_entity, camera_entity))
+				if (is_culled_everywhere(sprite_entity))
 					continue;
-				sync_common_properties(kreogl_sprite_3d, sprite_entity, &instance, transform, drawable, kreogl_world);
-			}
 
-			sync_text_2d_properties(kreogl_world, camera_entity);
-			for (const auto & [text_entity, transform, text_3d, kreogl_text_3d] : r.view<core::transform, text_3d, ::kreogl::text_3d>().each()) {
-				if (!entity_appears_in_viewport(r, text_entity, camera_entity))
-					continue;
-				sync_text_properties(kreogl_text_3d, text_entity, transform, text_3d, kreogl_world);
+				queue_model_matrix(kreogl_sprite_3d.transform, sprite_entity, &instance, get_interpolated_transform(r, sprite_entity, transform, alpha), alpha);
+				sync_common_properties(kreogl_sprite_3d, sprite_entity, drawable);
 			}
 
-			sync_debug_graphics_properties(kreogl_world, camera_entity);
+			for (const auto & [text_entity, transform, text_2d, kreogl_text_2d] : r.view<core::transform, text_2d, ::kreogl::text_2d>().each())
+				sync_text_properties(kreogl_text_2d, text_entity, text_2d);
 
-			for (const auto & [sky_box_entity, sky_box, instance] : r.view<sky_box, kengine::model::instance>().each()) {
-				if (!entity_appears_in_viewport(r, sky_box_entity, camera_entity))
-					continue;
-				const auto kreogl_skybox = kengine::model::try_get<::kreogl::skybox_texture>(r, instance);
-				if (!kreogl_skybox)
-					continue;
-				kreogl_world.skybox.color = toglm(sky_box.color);
-				kreogl_world.skybox.texture = kreogl_skybox;
+			for (const auto & [text_entity, transform, text_3d, kreogl_text_3d] : r.view<core::transform, text_3d, ::kreogl::text_3d>().each()) {
+				queue_model_matrix(kreogl_text_3d.transform, text_entity, nullptr, get_interpolated_transform(r, text_entity, transform, alpha), alpha);
+				sync_text_properties(kreogl_text_3d, text_entity, text_3d);
 			}
+
+			sync_model_matrices();
+			sync_debug_graphics_properties();
 		}
 
 		void sync_animation_properties(::kreogl::animated_object & kreogl_object, entt::entity entity, const kengine::model::instance & instance) noexcept {
@@ -753,35 +1128,20 @@ namespace kengine::render::kreogl {
 			return nullptr;
 		}
 
-		void sync_sprite_2d_properties(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		void sync_on_screen_properties(entt::entity camera_entity) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing sprite_2d properties for camera {}", camera_entity);
-
-			for (const auto & [sprite_entity, instance, transform, drawable, sprite_2d, kreogl_sprite_2d] : r.view<kengine::model::instance, core::transform, render::drawable, sprite_2d, ::kreogl::sprite_2d>().each()) {
-				if (!entity_appears_in_viewport(r, sprite_entity, camera_entity))
-					continue;
+			kengine_logf(r, very_verbose, log_category, "Syncing on-screen properties for camera {}", camera_entity);
 
-				sync_common_properties(kreogl_sprite_2d, sprite_entity, &instance, transform, drawable, kreogl_world);
+			const auto & viewport = r.get<render::viewport>(camera_entity);
 
+			for (const auto & [sprite_entity, instance, transform, drawable, sprite_2d, kreogl_sprite_2d] : r.view<kengine::model::instance, core::transform, render::drawable, sprite_2d, ::kreogl::sprite_2d>().each()) {
 				kengine_logf(r, very_verbose, log_category, "Syncing sprite_2d properties for {}", sprite_entity);
-				const auto & viewport = r.get<render::viewport>(camera_entity);
 				const auto & box = convert_to_screen_percentage(transform.bounding_box, viewport.resolution, sprite_2d);
 				kreogl_sprite_2d.transform = get_on_screen_matrix(transform, box.position, box.size, sprite_2d);
 			}
-		}
-
-		void sync_text_2d_properties(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
-			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing text_2d properties for camera {}", camera_entity);
 
 			for (const auto & [text_entity, transform, text_2d, kreogl_text_2d] : r.view<core::transform, text_2d, ::kreogl::text_2d>().each()) {
-				if (!entity_appears_in_viewport(r, text_entity, camera_entity))
-					continue;
-
-				sync_text_properties(kreogl_text_2d, text_entity, transform, text_2d, kreogl_world);
-
 				kengine_logf(r, very_verbose, log_category, "Syncing text_2d properties for {}", text_entity);
-				const auto & viewport = r.get<render::viewport>(camera_entity);
 				const auto & box = convert_to_screen_percentage(transform.bounding_box, viewport.resolution, text_2d);
 				auto scale = transform.bounding_box.size.y;
 				switch (text_2d.coordinates) {
@@ -797,16 +1157,35 @@ namespace kengine::render::kreogl {
 			}
 		}
 
-		void sync_debug_graphics_properties(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		void sync_sky_box(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing debug_graphics properties for camera {}", camera_entity);
+			kengine_logf(r, very_verbose, log_category, "Syncing sky_box for camera {}", camera_entity);
 
-			for (const auto & [debug_entity, transform, debug_graphics, kreogl_debug_graphics] : r.view<core::transform, render::debug_graphics, kreogl::debug_graphics>().each()) {
-				if (!entity_appears_in_viewport(r, debug_entity, camera_entity))
+			kreogl_world.skybox.texture = nullptr;
+			for (const auto & [sky_box_entity, sky_box, instance] : r.view<sky_box, kengine::model::instance>().each()) {
+				if (!entity_appears_in_viewport(r, sky_box_entity, camera_entity))
 					continue;
+				const auto kreogl_skybox = kengine::model::try_get<::kreogl::skybox_texture>(r, instance);
+				if (!kreogl_skybox)
+					continue;
+				kreogl_world.skybox.color = toglm(sky_box.color);
+				kreogl_world.skybox.texture = kreogl_skybox;
+			}
+		}
 
+		void sync_debug_graphics_properties() noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Syncing debug_graphics properties");
+
+			for (const auto & [debug_entity, transform, debug_graphics, kreogl_debug_graphics] : r.view<core::transform, render::debug_graphics, kreogl::debug_graphics>().each()) {
 				kengine_logf(r, very_verbose, log_category, "Syncing debug_graphics properties for {}", debug_entity);
-				kreogl_debug_graphics.elements.resize(debug_graphics.elements.size());
+
+				if (kreogl_debug_graphics.elements.size() != debug_graphics.elements.size()) {
+					// Resizing invalidates the element pointers held by worlds
+					kreogl_debug_graphics.elements.resize(debug_graphics.elements.size());
+					invalidate_worlds(r, debug_entity);
+				}
+
 				for (size_t i = 0; i < debug_graphics.elements.size(); ++i) {
 					const auto & element = debug_graphics.elements[i];
 					auto & kreogl_element = kreogl_debug_graphics.elements[i];
@@ -833,8 +1212,6 @@ namespace kengine::render::kreogl {
 							kengine_assert_failed(r, "Non-exhaustive switch");
 							break;
 					}
-
-					kreogl_world.add(kreogl_element);
 				}
 			}
 		}
@@ -870,10 +1247,10 @@ namespace kengine::render::kreogl {
 			return model;
 		}
 
-		void sync_text_properties(auto & kreogl_text, entt::entity text_entity, const core::transform & transform, const text & text, ::kreogl::world & kreogl_world) noexcept {
+		void sync_text_properties(auto & kreogl_text, entt::entity text_entity, const text & text) noexcept {
 			KENGINE_PROFILING_SCOPE;
 
-			sync_common_properties(kreogl_text, text_entity, nullptr, transform, text, kreogl_world);
+			sync_common_properties(kreogl_text, text_entity, text);
 			kreogl_text.font = text.font;
 			kreogl_text.value = text.value;
 			kreogl_text.font_size = text.font_size;
@@ -894,24 +1271,21 @@ namespace kengine::render::kreogl {
 			}
 		}
 
-		void sync_all_lights(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		void sync_all_lights(float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing all lights for camera {}", camera_entity);
+			kengine_log(r, very_verbose, log_category, "Syncing all lights");
 
-			sync_all_dir_lights(kreogl_world, camera_entity);
-			sync_all_point_lights(kreogl_world, camera_entity);
-			sync_all_spot_lights(kreogl_world, camera_entity);
+			sync_all_dir_lights();
+			sync_all_point_lights(alpha);
+			sync_all_spot_lights(alpha);
 		}
 
-		void sync_all_dir_lights(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		void sync_all_dir_lights() noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing all directional lights for camera {}", camera_entity);
+			kengine_log(r, very_verbose, log_category, "Syncing all directional lights");
 
 			for (const auto & [light_entity, dir_light, kreogl_dir_light] : r.view<dir_light, ::kreogl::directional_light>().each()) {
-				if (!entity_appears_in_viewport(r, light_entity, camera_entity))
-					continue;
-
-				sync_light_properties(light_entity, kreogl_dir_light, dir_light, kreogl_world);
+				sync_light_properties(light_entity, kreogl_dir_light, dir_light);
 
 				kengine_logf(r, very_verbose, log_category, "Syncing directional light properties for {}", light_entity);
 				kreogl_dir_light.direction = toglm(dir_light.direction);
@@ -925,26 +1299,21 @@ namespace kengine::render::kreogl {
 			}
 		}
 
-		void sync_all_point_lights(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		void sync_all_point_lights(float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing all point lights for camera {}", camera_entity);
+			kengine_log(r, very_verbose, log_category, "Syncing all point lights");
 
 			for (const auto & [light_entity, transform, point_light, kreogl_point_light] : r.view<core::transform, point_light, ::kreogl::point_light>().each()) {
-				if (!entity_appears_in_viewport(r, light_entity, camera_entity))
-					continue;
-				sync_point_light_properties(light_entity, transform, kreogl_point_light, point_light, kreogl_world);
+				sync_point_light_properties(light_entity, get_interpolated_transform(r, light_entity, transform, alpha), kreogl_point_light, point_light);
 			}
 		}
 
-		void sync_all_spot_lights(::kreogl::world & kreogl_world, entt::entity camera_entity) noexcept {
+		void sync_all_spot_lights(float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
-			kengine_logf(r, very_verbose, log_category, "Syncing all spot lights for camera {}", camera_entity);
+			kengine_log(r, very_verbose, log_category, "Syncing all spot lights");
 
 			for (const auto & [light_entity, transform, spot_light, kreogl_spot_light] : r.view<core::transform, spot_light, ::kreogl::spot_light>().each()) {
-				if (!entity_appears_in_viewport(r, light_entity, camera_entity))
-					continue;
-
-				sync_point_light_properties(light_entity, transform, kreogl_spot_light, spot_light, kreogl_world);
+				sync_point_light_properties(light_entity, get_interpolated_transform(r, light_entity, transform, alpha), kreogl_spot_light, spot_light);
 
 				kengine_logf(r, very_verbose, log_category, "Syncing spot light properties for {}", light_entity);
 				kreogl_spot_light.direction = toglm(spot_light.direction);
@@ -953,7 +1322,7 @@ namespace kengine::render::kreogl {
 			}
 		}
 
-		void sync_light_properties(entt::entity light_entity, auto & kreogl_light, const light & light, ::kreogl::world & kreogl_world) noexcept {
+		void sync_light_properties(entt::entity light_entity, auto & kreogl_light, const light & light) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(r, very_verbose, log_category, "Syncing light properties for {}", light_entity);
 
@@ -976,15 +1345,13 @@ namespace kengine::render::kreogl {
 			}
 			else
 				kreogl_light.volumetric_lighting.reset();
-
-			kreogl_world.add(kreogl_light);
 		}
 
-		void sync_point_light_properties(entt::entity light_entity, const core::transform & transform, ::kreogl::point_light & kreogl_light, const point_light & light, ::kreogl::world & kreogl_world) noexcept {
+		void sync_point_light_properties(entt::entity light_entity, const core::transform & transform, ::kreogl::point_light & kreogl_light, const point_light & light) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(r, very_verbose, log_category, "Syncing point light properties for {}", light_entity);
 
-			sync_light_properties(light_entity, kreogl_light, light, kreogl_world);
+			sync_light_properties(light_entity, kreogl_light, light);
 
 			kreogl_light.position = toglm(transform.bounding_box.position);
 			kreogl_light.attenuation_constant = light.attenuation_constant;
@@ -1086,6 +1453,7 @@ namespace kengine::render::kreogl {
 		animation_files,
 		debug_graphics,
 		model,
+		world,
 		::kreogl::animated_object,
 		::kreogl::camera,
 		::kreogl::directional_light,
@@ -0,0 +1,127 @@
+// stl
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// entt
+#include <entt/entity/registry.hpp>
+
+// glfw
+#include <GLFW/glfw3.h>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kreogl
+#include "kreogl/window.hpp"
+
+// kengine
+#include "kengine/core/data/transform.hpp"
+#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
+#include "kengine/model/data/instance.hpp"
+#include "kengine/render/data/camera.hpp"
+#include "kengine/render/data/drawable.hpp"
+#include "kengine/render/data/model_data.hpp"
+#include "kengine/render/data/viewport.hpp"
+#include "kengine/render/data/window.hpp"
+#include "kengine/render/glfw/systems/system.hpp"
+#include "kengine/render/kreogl/systems/system.hpp"
+
+struct cube_vertex {
+	float position[3];
+	float color[3];
+};
+
+static const cube_vertex cube_vertices[] = {
+	{ { -.5f, -.5f, -.5f }, { 1.f, 0.f, 0.f } },
+	{ { .5f, -.5f, -.5f }, { 0.f, 1.f, 0.f } },
+	{ { .5f, .5f, -.5f }, { 0.f, 0.f, 1.f } },
+	{ { -.5f, .5f, -.5f }, { 1.f, 1.f, 0.f } },
+	{ { -.5f, -.5f, .5f }, { 1.f, 0.f, 1.f } },
+	{ { .5f, -.5f, .5f }, { 0.f, 1.f, 1.f } },
+	{ { .5f, .5f, .5f }, { 1.f, 1.f, 1.f } },
+	{ { -.5f, .5f, .5f }, { 0.f, 0.f, 0.f } }
+};
+
+static const unsigned int cube_indices[] = {
+	0, 2, 1, 0, 3, 2,
+	4, 5, 6, 4, 6, 7,
+	0, 1, 5, 0, 5, 4,
+	3, 7, 6, 3, 6, 2,
+	0, 4, 7, 0, 7, 3,
+	1, 2, 6, 1, 6, 5
+};
+
+static void run_frame(entt::registry & r) noexcept {
+	constexpr auto delta_time = 1.f / 60.f;
+	for (const auto & [e, execute] : r.view<kengine::main_loop::execute>().each())
+		execute(delta_time);
+	for (const auto & [e, execute_frame] : r.view<kengine::main_loop::execute_frame>().each())
+		execute_frame(delta_time, 1.f);
+}
+
+// Benchmark measuring frame times with objects that never move, which shouldn't need to be synced to kreogl again.
+// Disabled by default, run it with --gtest_also_run_disabled_tests. Needs a display, as it opens a window
+TEST(kreogl, DISABLED_benchmark_static_objects) {
+	if (glfwInit() != GLFW_TRUE)
+		GTEST_SKIP() << "GLFW could not be initialized";
+
+	// The GLFW system only supports a single registry, so all object counts are measured in this one
+	entt::registry r;
+	kengine::render::glfw::add_system(r);
+	kengine::render::kreogl::add_system(r);
+
+	const auto window = r.create();
+	r.emplace<kengine::render::window>(window).name = "kreogl benchmark";
+
+	const auto camera = r.create();
+	r.emplace<kengine::render::camera>(camera).frustum.position = { 0.f, 0.f, -10.f };
+	r.emplace<kengine::render::viewport>(camera);
+
+	const auto model = r.create();
+	auto & model_data = r.emplace<kengine::render::model_data>(model);
+	model_data.vertex_attributes.push_back({ "position", offsetof(cube_vertex, position), putils::meta::type<float[3]>::index });
+	model_data.vertex_attributes.push_back({ "color", offsetof(cube_vertex, color), putils::meta::type<float[3]>::index });
+	model_data.vertex_size = sizeof(cube_vertex);
+	model_data.meshes.push_back({
+		.vertices = { std::size(cube_vertices), sizeof(cube_vertex), cube_vertices },
+		.indices = { std::size(cube_indices), sizeof(unsigned int), cube_indices },
+		.index_type = putils::meta::type<unsigned int>::index
+	});
+
+	run_frame(r);
+	if (!r.all_of<::kreogl::window>(window))
+		GTEST_SKIP() << "No window could be created";
+
+	std::vector<entt::entity> objects;
+	for (const size_t object_count : { 1'000, 10'000, 100'000 }) {
+		const auto side = size_t(std::ceil(std::sqrt(float(object_count))));
+		for (size_t i = 0; i < object_count; ++i) {
+			const auto e = r.create();
+			auto & transform = r.emplace<kengine::core::transform>(e);
+			transform.bounding_box.position = { float(i % side) * 2.f, float(i / side) * 2.f, 0.f };
+			r.emplace<kengine::model::instance>(e, model);
+			r.emplace<kengine::render::drawable>(e);
+			objects.push_back(e);
+		}
+
+		// Let the system create the kreogl objects and build its world
+		for (int i = 0; i < 10; ++i)
+			run_frame(r);
+
+		constexpr size_t frames = 20;
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < frames; ++i)
+			run_frame(r);
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		const auto milliseconds_per_frame = double(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000. / double(frames);
+		testing::Test::RecordProperty("frame_" + std::to_string(object_count) + "_static_objects", std::to_string(milliseconds_per_frame));
+
+		r.destroy(objects.begin(), objects.end());
+		objects.clear();
+	}
+}
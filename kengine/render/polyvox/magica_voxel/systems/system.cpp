@@ -3,7 +3,6 @@
 // stl
 #include <filesystem>
 #include <fstream>
-#include <future>
 #include <unordered_map>
 
 // entt
@@ -24,7 +23,7 @@
 #include "kengine/async/helpers/start_task.hpp"
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
 #include "kengine/core/data/transform.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
@@ -47,7 +46,7 @@ namespace kengine::render::polyvox::magica_voxel {
 		entt::registry & r;
 
 		struct processed {};
-		kengine::new_entity_processor<processed, render::asset> processor{ r, putils_forward_to_this(load_model) };
+		kengine::reactive_entity_processor<processed, render::asset> processor{ r, putils_forward_to_this(load_model) };
 
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
@@ -55,6 +54,7 @@ namespace kengine::render::polyvox::magica_voxel {
 			kengine_log(r, log, log_category, "Initializing");
 
 			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			kengine::async::prepare_tasks<async_loaded_data>(r);
 			processor.process();
 		}
 
@@ -93,10 +93,10 @@ namespace kengine::render::polyvox::magica_voxel {
 			kengine::async::start_task(
 				r, e,
 				async::task::string("magica_voxel: load {}", f),
-				std::async(std::launch::async, [this, e, &f] {
-					const putils::scoped_thread_name thread_name(putils::string<64>("Load {}", f));
-					return load_model_data(e, f);
-				})
+				[this, e, file = asset.file] {
+					const putils::scoped_thread_name thread_name(putils::string<64>("Load {}", file.c_str()));
+					return load_model_data(e, file.c_str());
+				}
 			);
 		}
 
@@ -1,5 +1,8 @@
 #include "system.hpp"
 
+// stl
+#include <cmath>
+
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
@@ -26,7 +29,7 @@
 #include "kengine/config/data/configurable.hpp"
 #include "kengine/core/data/name.hpp"
 #include "kengine/core/data/transform.hpp"
-#include "kengine/core/helpers/new_entity_processor.hpp"
+#include "kengine/core/helpers/reactive_entity_processor.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/imgui/data/context.hpp"
@@ -34,6 +37,7 @@
 #include "kengine/input/data/buffer.hpp"
 #include "kengine/model/helpers/try_get.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 #include "kengine/main_loop/helpers/is_running.hpp"
 #include "kengine/render/data/asset.hpp"
 #include "kengine/render/data/camera.hpp"
@@ -42,6 +46,7 @@
 #include "kengine/render/data/viewport.hpp"
 #include "kengine/render/data/window.hpp"
 #include "kengine/render/helpers/convert_to_screen_percentage.hpp"
+#include "kengine/render/helpers/interpolate_transform.hpp"
 #include "kengine/render/sfml/data/texture.hpp"
 #include "kengine/render/sfml/data/window.hpp"
 
@@ -81,10 +86,10 @@ namespace kengine::render::sfml {
 		input::buffer * input_buffer = nullptr;
 
 		struct processed_window {};
-		kengine::new_entity_processor<processed_window, render::window> window_processor{ r, putils_forward_to_this(create_window) };
+		kengine::reactive_entity_processor<processed_window, render::window> window_processor{ r, putils_forward_to_this(create_window) };
 
 		struct processed_model {};
-		kengine::new_entity_processor<processed_model, render::asset> model_processor{ r, putils_forward_to_this(create_texture) };
+		kengine::reactive_entity_processor<processed_model, render::asset> model_processor{ r, putils_forward_to_this(create_texture) };
 
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
@@ -92,6 +97,7 @@ namespace kengine::render::sfml {
 			kengine_log(r, log, log_category, "Initializing");
 
 			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute_frame));
 
 			e.emplace<core::name>("Render/SFML");
 			e.emplace<config::configurable>();
@@ -114,6 +120,13 @@ namespace kengine::render::sfml {
 			window_processor.process();
 			model_processor.process();
 
+			record_transforms(r);
+		}
+
+		void execute_frame(float delta_time, float alpha) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, very_verbose, log_category, "Executing frame");
+
 			const auto sf_delta_time = delta_clock.restart();
 
 			if (input_buffer == nullptr) {
@@ -131,7 +144,7 @@ namespace kengine::render::sfml {
 					continue;
 				// We process events after rendering, even though it's not the expected order, because
 				// of how the SFML-ImGui binding handles input :(
-				render(window, sf_window);
+				render(window, sf_window, alpha);
 				process_events(window, *sf_window.ptr, sf_delta_time);
 			}
 		}
@@ -242,7 +255,7 @@ namespace kengine::render::sfml {
 			}
 		}
 
-		void render(entt::entity window_entity, window & sf_window) noexcept {
+		void render(entt::entity window_entity, window & sf_window, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(r, very_verbose, log_category, "Rendering to {}", window_entity);
 
@@ -275,7 +288,7 @@ namespace kengine::render::sfml {
 				}
 
 				render_texture->setView(sf::View{ convertVector(cam.frustum.position), convertVector(cam.frustum.size) });
-				render_to_texture(*render_texture);
+				render_to_texture(*render_texture, cam, alpha);
 				to_blit.push_back(viewport_to_blit{ render_texture, &viewport });
 			}
 
@@ -292,7 +305,7 @@ namespace kengine::render::sfml {
 			sf_window.ptr->display();
 		}
 
-		void render_to_texture(sf::RenderTexture & render_texture) noexcept {
+		void render_to_texture(sf::RenderTexture & render_texture, const camera & cam, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Rendering to texture");
 
@@ -324,7 +337,14 @@ namespace kengine::render::sfml {
 			} drawables;
 
 			kengine_log(r, very_verbose, log_category, "Queueing sprites");
-			for (const auto & [e, transform, drawable] : r.view<core::transform, render::drawable>().each()) {
+			for (const auto & [e, current_transform, drawable] : r.view<core::transform, render::drawable>().each()) {
+				// Drawn between its last two simulation steps
+				const auto transform = get_interpolated_transform(r, e, current_transform, alpha);
+				if (!is_in_view(transform, cam)) {
+					kengine_logf(r, very_verbose, log_category, "Skipping {} as it's outside of the view", e);
+					continue;
+				}
+
 				auto sprite = create_entity_sprite(e, transform, drawable);
 				if (sprite != std::nullopt) {
 					kengine_logf(r, very_verbose, log_category, "Queueing sprite for {}", e);
@@ -440,6 +460,22 @@ namespace kengine::render::sfml {
 			render_texture.display();
 		}
 
+		// The view is orthographic, so test against its rectangle
+		static bool is_in_view(const core::transform & transform, const camera & cam) noexcept {
+			const auto & box = transform.bounding_box;
+
+			auto half_width = std::abs(box.size.x) / 2.f;
+			auto half_height = std::abs(box.size.y) / 2.f;
+			if (transform.yaw != 0.f) {
+				// Sprites are rotated around their top-left corner, which is half a diagonal away from their center
+				const auto diagonal = std::sqrt(box.size.x * box.size.x + box.size.y * box.size.y);
+				half_width = half_height = diagonal * 1.5f;
+			}
+
+			return std::abs(box.position.x - cam.frustum.position.x) <= std::abs(cam.frustum.size.x) / 2.f + half_width &&
+				   std::abs(box.position.y - cam.frustum.position.y) <= std::abs(cam.frustum.size.y) / 2.f + half_height;
+		}
+
 		std::optional<sf::Sprite> create_entity_sprite(entt::entity e, const core::transform & transform, const render::drawable & drawable) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_logf(r, very_verbose, log_category, "Creating entity sprite for {}", e);
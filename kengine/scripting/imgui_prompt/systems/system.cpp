@@ -21,7 +21,7 @@
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/imgui/helpers/set_context.hpp"
 #include "kengine/imgui/tool/data/tool.hpp"
-#include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/functions/execute_frame.hpp"
 
 #ifdef KENGINE_SCRIPTING_LUA
 #include "kengine/scripting/lua/data/state.hpp"
@@ -52,14 +52,14 @@ namespace kengine::scripting::imgui_prompt {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, log, log_category, "Initializing");
 
-			e.emplace<main_loop::execute>(putils_forward_to_this(execute));
+			e.emplace<main_loop::execute_frame>(putils_forward_to_this(execute));
 
 			e.emplace<core::name>("Prompt");
 			auto & tool = e.emplace<imgui::tool::tool>();
 			enabled = &tool.enabled;
 		}
 
-		void execute(float delta_time) noexcept {
+		void execute(float delta_time, float alpha) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
@@ -0,0 +1,13 @@
+#pragma once
+
+// kengine
+#include "kengine/scripting/data/scripts.hpp"
+
+namespace kengine::scripting::lua {
+	//! putils reflect all
+	//! class_name: lua_batch_scripts
+	//! parents: [kengine::scripting::scripts]
+	struct batch_scripts : scripting::scripts {};
+}
+
+#include "batch_scripts.rpp"
@@ -1,5 +1,11 @@
 #include "system.hpp"
 
+// stl
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
@@ -9,10 +15,13 @@
 
 // kengine
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
+#include "kengine/core/helpers/string_hash.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/helpers/declare_access.hpp"
 #include "kengine/scripting/helpers/init_bindings.hpp"
+#include "kengine/scripting/lua/data/batch_scripts.hpp"
 #include "kengine/scripting/lua/data/scripts.hpp"
 #include "kengine/scripting/lua/helpers/log_category.hpp"
 #include "kengine/scripting/lua/helpers/register_function.hpp"
@@ -34,6 +43,9 @@ namespace kengine::scripting::lua {
 			state = new sol::state;
 			e.emplace<lua::state>(state);
 
+			// Scripts may access any component, and create or destroy entities
+			main_loop::declare_access(e, main_loop::reads<scripts, batch_scripts>{}, main_loop::writes<lua::state>{}).exclusive = true;
+
 			kengine_log(r, verbose, log_category, "Opening libraries");
 			state->open_libraries();
 
@@ -54,8 +66,15 @@ namespace kengine::scripting::lua {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
+			time_since_script_check += delta_time;
+			if (time_since_script_check >= script_check_interval) {
+				time_since_script_check = 0.f;
+				check_cached_scripts();
+			}
+
 			const auto view = r.view<scripts>();
-			if (!view.empty()) {
+			const auto batch_view = r.view<batch_scripts>();
+			if (!view.empty() || !batch_view.empty()) {
 				kengine_log(r, very_verbose, log_category, "Setting delta_time in Lua state");
 				(*state)["delta_time"] = delta_time;
 			}
@@ -66,13 +85,121 @@ namespace kengine::scripting::lua {
 
 				for (const auto & s : comp.files) {
 					kengine_logf(r, very_verbose, log_category, "Running script {} for {}", s, e);
+					if (const auto script = get_script(s.c_str()))
+						call_script(s.c_str(), *script);
+				}
+			}
 
-					state->safe_script_file(s.c_str(), [this](lua_State *, sol::protected_function_result pfr) {
-						const sol::error err = pfr;
-						kengine_assert_failed(r, err.what());
-						return pfr;
-					});
+			run_batches(batch_view);
+		}
+
+		// Scripts are compiled once, then re-compiled only if their file is modified
+		struct cached_script {
+			sol::protected_function function; // Invalid if the script failed to compile
+			std::filesystem::file_time_type last_write_time; // file_time_type::min() if the file was missing
+			bool used = false; // Since the last check, so that scripts no entity uses anymore get released
+		};
+
+		string_map<cached_script> script_cache;
+
+		// Checking files means querying the filesystem, so it isn't done every frame
+		static constexpr float script_check_interval = 1.f;
+		float time_since_script_check = 0.f;
+
+		const sol::protected_function * get_script(const char * path) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			auto it = script_cache.find(std::string_view(path));
+			if (it == script_cache.end())
+				it = script_cache.emplace(path, load_script(path)).first;
+			it->second.used = true;
+
+			const auto & function = it->second.function;
+			return function.valid() ? &function : nullptr;
+		}
+
+		cached_script load_script(const char * path) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, verbose, log_category, "Compiling script {}", path);
+
+			cached_script ret;
+
+			std::error_code error;
+			ret.last_write_time = std::filesystem::last_write_time(path, error);
+
+			const sol::load_result loaded = state->load_file(path);
+			if (!loaded.valid()) {
+				const sol::error err = loaded;
+				kengine_assert_failed(r, "Failed to compile Lua script '{}': {}", path, err.what());
+				return ret;
+			}
+
+			ret.function = loaded.get<sol::protected_function>();
+			return ret;
+		}
+
+		// Releases scripts which weren't used since the last check, and reloads modified ones
+		void check_cached_scripts() noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto released = std::erase_if(script_cache, [](const auto & entry) noexcept { return !entry.second.used; });
+			if (released > 0) {
+				kengine_logf(r, verbose, log_category, "Released {} unused scripts", released);
+				std::erase_if(batches, [this](const auto & entry) noexcept { return !script_cache.contains(entry.first); });
+			}
+
+			for (auto & [path, script] : script_cache) {
+				script.used = false;
+
+				// Missing files have no write time, so they're reloaded as soon as they're created
+				std::error_code error;
+				const auto last_write_time = std::filesystem::last_write_time(path, error);
+				if (error || last_write_time == script.last_write_time)
+					continue;
+
+				kengine_logf(r, log, log_category, "Reloading modified script {}", path);
+				script = load_script(path.c_str());
+			}
+		}
+
+		void call_script(const char * path, const sol::protected_function & script) noexcept {
+			const sol::protected_function_result result = script();
+			if (!result.valid()) {
+				const sol::error err = result;
+				kengine_assert_failed(r, "Error in Lua script '{}': {}", path, err.what());
+			}
+		}
+
+		// Entities for each batch script, kept across frames to avoid re-allocating
+		string_map<std::vector<entt::entity>> batches;
+
+		template<typename View>
+		void run_batches(const View & batch_view) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			for (const auto & [e, comp] : batch_view.each())
+				for (const auto & s : comp.files) {
+					auto it = batches.find(std::string_view(s.c_str()));
+					if (it == batches.end())
+						it = batches.emplace(s.c_str(), std::vector<entt::entity>{}).first;
+					it->second.push_back(e);
 				}
+
+			for (auto & [path, entities] : batches) {
+				if (entities.empty())
+					continue;
+
+				kengine_logf(r, very_verbose, log_category, "Running batch script {} for {} entities", path, entities.size());
+				if (const auto script = get_script(path.c_str())) {
+					auto table = state->create_table(int(entities.size()), 0);
+					for (size_t i = 0; i < entities.size(); ++i)
+						table[i + 1] = entt::handle{ r, entities[i] };
+					(*state)["entities"] = table;
+
+					call_script(path.c_str(), *script);
+				}
+
+				entities.clear();
 			}
 		}
 	};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "kengine/scripting/data/scripts.hpp"
+
+namespace kengine::scripting::python {
+	//! putils reflect all
+	//! class_name: python_batch_scripts
+	//! parents: [kengine::scripting::scripts]
+	struct batch_scripts : scripting::scripts {};
+}
+
+#include "batch_scripts.rpp"
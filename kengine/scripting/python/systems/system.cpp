@@ -1,5 +1,13 @@
 #include "system.hpp"
 
+// stl
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
 // entt
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
@@ -9,10 +17,13 @@
 
 // kengine
 #include "kengine/core/assert/helpers/kengine_assert.hpp"
+#include "kengine/core/helpers/string_hash.hpp"
 #include "kengine/core/log/helpers/kengine_log.hpp"
 #include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
 #include "kengine/main_loop/functions/execute.hpp"
+#include "kengine/main_loop/helpers/declare_access.hpp"
 #include "kengine/scripting/helpers/init_bindings.hpp"
+#include "kengine/scripting/python/data/batch_scripts.hpp"
 #include "kengine/scripting/python/data/scripts.hpp"
 #include "kengine/scripting/python/helpers/log_category.hpp"
 #include "kengine/scripting/python/helpers/register_types.hpp"
@@ -22,6 +33,11 @@ namespace kengine::scripting::python {
 		entt::registry & r;
 		py::module_ * module_;
 
+		// Setting items directly in the module's dict, with pre-built keys, avoids an attribute lookup for each entity
+		py::dict module_dict;
+		py::str self_key;
+		py::str entities_key;
+
 		system(entt::handle e) noexcept
 			: r(*e.registry()) {
 			KENGINE_PROFILING_SCOPE;
@@ -32,9 +48,15 @@ namespace kengine::scripting::python {
 			kengine_log(r, verbose, log_category, "Creating Python state");
 			auto & state = e.emplace<python::state>();
 
+			// Scripts may access any component, and create or destroy entities. The interpreter's lock is held by the main thread
+			main_loop::declare_access(e, main_loop::reads<scripts, batch_scripts>{}, main_loop::writes<python::state>{}, true).exclusive = true;
+
 			kengine_log(r, verbose, log_category, "Registering script_language_helper functions");
 			py::globals()["kengine"] = state.module_;
 			module_ = &state.module_;
+			module_dict = py::reinterpret_borrow<py::dict>(PyModule_GetDict(module_->ptr()));
+			self_key = py::reinterpret_steal<py::str>(PyUnicode_InternFromString("self"));
+			entities_key = py::reinterpret_steal<py::str>(PyUnicode_InternFromString("entities"));
 			scripting::init_bindings(
 				r,
 				[&](auto &&... args) noexcept {
@@ -47,13 +69,32 @@ namespace kengine::scripting::python {
 			);
 		}
 
+		~system() noexcept {
+			// The interpreter may have been finalized before us, in which case our objects can't be released properly
+			if (Py_IsInitialized())
+				return;
+
+			module_dict.release();
+			self_key.release();
+			entities_key.release();
+			for (auto & [path, script] : script_cache)
+				script.code.release();
+		}
+
 		void execute(float delta_time) noexcept {
 			KENGINE_PROFILING_SCOPE;
 			kengine_log(r, very_verbose, log_category, "Executing");
 
+			time_since_script_check += delta_time;
+			if (time_since_script_check >= script_check_interval) {
+				time_since_script_check = 0.f;
+				check_cached_scripts();
+			}
+
 			const auto view = r.view<scripts>();
+			const auto batch_view = r.view<batch_scripts>();
 
-			if (view.empty())
+			if (view.empty() && batch_view.empty())
 				return;
 
 			kengine_log(r, very_verbose, log_category, "Setting delta_time");
@@ -61,17 +102,146 @@ namespace kengine::scripting::python {
 
 			for (auto [e, comp] : view.each()) {
 				kengine_logf(r, very_verbose, log_category, "Setting 'self' to {}", e);
-				module_->attr("self") = entt::handle{ r, e };
+				try {
+					module_dict[self_key] = entt::handle{ r, e };
+				}
+				catch (const std::exception & e) {
+					kengine_assert_failed(r, "{}", e.what());
+					continue;
+				}
 
 				for (const auto & s : comp.files) {
 					kengine_logf(r, very_verbose, log_category, "Running script {} for {}", s, e);
+					if (const auto code = get_script(s.c_str()))
+						run_script(s.c_str(), *code);
+				}
+			}
+
+			run_batches(batch_view);
+		}
+
+		// Scripts are compiled once, then re-compiled only if their file is modified
+		struct cached_script {
+			py::object code; // None if the script failed to compile
+			std::filesystem::file_time_type last_write_time; // file_time_type::min() if the file was missing
+			bool used = false; // Since the last check, so that scripts no entity uses anymore get released
+		};
+
+		string_map<cached_script> script_cache;
+
+		// Checking files means querying the filesystem, so it isn't done every frame
+		static constexpr float script_check_interval = 1.f;
+		float time_since_script_check = 0.f;
+
+		const py::object * get_script(const char * path) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			auto it = script_cache.find(std::string_view(path));
+			if (it == script_cache.end())
+				it = script_cache.emplace(path, compile_script(path)).first;
+			it->second.used = true;
+
+			const auto & code = it->second.code;
+			return code.is_none() ? nullptr : &code;
+		}
+
+		cached_script compile_script(const char * path) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, verbose, log_category, "Compiling script {}", path);
+
+			cached_script ret;
+
+			std::error_code error;
+			ret.last_write_time = std::filesystem::last_write_time(path, error);
+
+			std::ifstream file(path);
+			if (!file) {
+				kengine_assert_failed(r, "Failed to open Python script '{}'", path);
+				return ret;
+			}
+
+			std::stringstream source;
+			source << file.rdbuf();
+
+			try {
+				const auto compile = py::module_::import("builtins").attr("compile");
+				ret.code = compile(source.str(), path, "exec");
+			}
+			catch (const std::exception & e) {
+				kengine_assert_failed(r, "Failed to compile Python script '{}': {}", path, e.what());
+			}
+			return ret;
+		}
+
+		// Releases scripts which weren't used since the last check, and reloads modified ones
+		void check_cached_scripts() noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			const auto released = std::erase_if(script_cache, [](const auto & entry) noexcept { return !entry.second.used; });
+			if (released > 0) {
+				kengine_logf(r, verbose, log_category, "Released {} unused scripts", released);
+				std::erase_if(batches, [this](const auto & entry) noexcept { return !script_cache.contains(entry.first); });
+			}
+
+			for (auto & [path, script] : script_cache) {
+				script.used = false;
+
+				// Missing files have no write time, so they're reloaded as soon as they're created
+				std::error_code error;
+				const auto last_write_time = std::filesystem::last_write_time(path, error);
+				if (error || last_write_time == script.last_write_time)
+					continue;
+
+				kengine_logf(r, log, log_category, "Reloading modified script {}", path);
+				script = compile_script(path.c_str());
+			}
+		}
+
+		void run_script(const char * path, const py::object & code) noexcept {
+			const auto globals = py::globals();
+			const auto result = py::reinterpret_steal<py::object>(PyEval_EvalCode(code.ptr(), globals.ptr(), globals.ptr()));
+			if (result)
+				return;
+
+			const py::error_already_set error;
+			kengine_assert_failed(r, "Error in Python script '{}': {}", path, error.what());
+		}
+
+		// Entities for each batch script, kept across frames to avoid re-allocating
+		string_map<std::vector<entt::entity>> batches;
+
+		template<typename View>
+		void run_batches(const View & batch_view) noexcept {
+			KENGINE_PROFILING_SCOPE;
+
+			for (const auto & [e, comp] : batch_view.each())
+				for (const auto & s : comp.files) {
+					auto it = batches.find(std::string_view(s.c_str()));
+					if (it == batches.end())
+						it = batches.emplace(s.c_str(), std::vector<entt::entity>{}).first;
+					it->second.push_back(e);
+				}
+
+			for (auto & [path, entities] : batches) {
+				if (entities.empty())
+					continue;
+
+				kengine_logf(r, very_verbose, log_category, "Running batch script {} for {} entities", path, entities.size());
+				if (const auto code = get_script(path.c_str())) {
 					try {
-						py::eval_file(s.c_str(), py::globals());
+						py::list handles(entities.size());
+						for (size_t i = 0; i < entities.size(); ++i)
+							handles[i] = entt::handle{ r, entities[i] };
+						module_dict[entities_key] = handles;
+
+						run_script(path.c_str(), *code);
 					}
 					catch (const std::exception & e) {
-						kengine_assert_failed(r, e.what());
+						kengine_assert_failed(r, "{}", e.what());
 					}
 				}
+
+				entities.clear();
 			}
 		}
 	};
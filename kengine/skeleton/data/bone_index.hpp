@@ -0,0 +1,23 @@
+#pragma once
+
+// reflection
+#include "putils/reflection.hpp"
+
+// kengine
+#include "kengine/core/helpers/string_hash.hpp"
+
+namespace kengine::skeleton {
+	//! putils reflect all
+	struct bone_indices {
+		unsigned int mesh_index = 0;
+		unsigned int bone_index = 0;
+	};
+
+	// Lookup table built from a model's bone_names, so that bones can be found without comparing strings
+	//! putils reflect name
+	struct bone_index {
+		string_map<bone_indices> bones;
+	};
+}
+
+#include "bone_index.rpp"
\ No newline at end of file
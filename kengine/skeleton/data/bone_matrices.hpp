@@ -1,6 +1,7 @@
 #pragma once
 
 // stl
+#include <memory_resource>
 #include <vector>
 
 // glm
@@ -9,9 +10,8 @@
 // reflection
 #include "putils/reflection.hpp"
 
-#ifndef KENGINE_SKELETON_MAX_BONES
-#define KENGINE_SKELETON_MAX_BONES 100
-#endif
+// kengine
+#include "kengine/skeleton/helpers/get_pose_pool.hpp"
 
 namespace kengine::skeleton {
 	//! putils reflect all
@@ -20,8 +20,8 @@ namespace kengine::skeleton {
 		//! putils reflect all
 		//! class_name: skeleton_mesh
 		struct mesh {
-			::glm::mat4 bone_mats_bone_space[KENGINE_SKELETON_MAX_BONES]; // Used by shader
-			::glm::mat4 bone_mats_mesh_space[KENGINE_SKELETON_MAX_BONES]; // Used to get bone matrix in world space
+			// Sized to the mesh's bone count
+			std::pmr::vector<::glm::mat4> bone_mats_mesh_space{ get_pose_pool() }; // Used to get bone matrix in world space
 		};
 		std::vector<mesh> meshes;
 	};
@@ -0,0 +1,19 @@
+#include "build_bone_index.hpp"
+
+// kengine
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+
+namespace kengine::skeleton {
+	bone_index build_bone_index(const bone_names & names) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		bone_index ret;
+		for (unsigned int mesh_index = 0; mesh_index < names.meshes.size(); ++mesh_index) {
+			const auto & mesh = names.meshes[mesh_index];
+			for (unsigned int i = 0; i < mesh.bone_names.size(); ++i)
+				// Keep the first occurrence, like get_bone_index does when scanning names
+				ret.bones.try_emplace(mesh.bone_names[i], bone_indices{ mesh_index, i });
+		}
+		return ret;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+// kengine
+#include "kengine/skeleton/data/bone_index.hpp"
+#include "kengine/skeleton/data/bone_names.hpp"
+
+namespace kengine::skeleton {
+	KENGINE_SKELETON_EXPORT bone_index build_bone_index(const bone_names & names) noexcept;
+}
\ No newline at end of file
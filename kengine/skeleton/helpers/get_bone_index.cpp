@@ -31,4 +31,16 @@ namespace kengine::skeleton {
 		kengine_assert_failed(r, "'{}' bone not found", bone);
 		return indexes;
 	}
+
+	bone_indices get_bone_index(const entt::registry & r, const char * bone, const bone_index & index) noexcept {
+		KENGINE_PROFILING_SCOPE;
+		kengine_logf(r, very_verbose, log_category, "Getting bone index for {} from index", bone);
+
+		const auto it = index.bones.find(std::string_view(bone));
+		if (it != index.bones.end())
+			return it->second;
+
+		kengine_assert_failed(r, "'{}' bone not found", bone);
+		return {};
+	}
 }
\ No newline at end of file
@@ -7,9 +7,11 @@
 #include <glm/glm.hpp>
 
 // kengine
+#include "kengine/skeleton/data/bone_index.hpp"
 #include "kengine/skeleton/data/bone_matrices.hpp"
 #include "kengine/skeleton/data/bone_names.hpp"
 
 namespace kengine::skeleton {
 	KENGINE_SKELETON_EXPORT ::glm::mat4 get_bone_matrix(const entt::registry & r, const char * bone, const bone_matrices & matrices, const bone_names & names) noexcept;
+	KENGINE_SKELETON_EXPORT ::glm::mat4 get_bone_matrix(const bone_indices & indices, const bone_matrices & matrices) noexcept;
 }
\ No newline at end of file
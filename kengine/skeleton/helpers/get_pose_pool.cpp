@@ -0,0 +1,9 @@
+#include "get_pose_pool.hpp"
+
+namespace kengine::skeleton {
+	std::pmr::memory_resource * get_pose_pool() noexcept {
+		// Leaked on purpose, so that skeletons destroyed during static destruction can still release their memory
+		static const auto pool = new std::pmr::synchronized_pool_resource;
+		return pool;
+	}
+}
\ No newline at end of file
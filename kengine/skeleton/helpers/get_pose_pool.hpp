@@ -0,0 +1,8 @@
+#pragma once
+
+// stl
+#include <memory_resource>
+
+namespace kengine::skeleton {
+	KENGINE_SKELETON_EXPORT std::pmr::memory_resource * get_pose_pool() noexcept;
+}
\ No newline at end of file
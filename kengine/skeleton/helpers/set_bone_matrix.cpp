@@ -13,11 +13,19 @@ namespace kengine::skeleton {
 		KENGINE_PROFILING_SCOPE;
 		kengine_logf(r, very_verbose, log_category, "Setting bone matrix for {}", bone);
 
-		const auto indexes = get_bone_index(r, bone, names);
-		if (indexes.mesh_index >= matrices.meshes.size())
+		set_bone_matrix(get_bone_index(r, bone, names), m, matrices);
+	}
+
+	void set_bone_matrix(const bone_indices & indices, const glm::mat4 & m, bone_matrices & matrices) noexcept {
+		KENGINE_PROFILING_SCOPE;
+
+		if (indices.mesh_index >= matrices.meshes.size())
+			return;
+
+		auto & mesh = matrices.meshes[indices.mesh_index];
+		if (indices.bone_index >= mesh.bone_mats_mesh_space.size())
 			return;
 
-		auto & mesh = matrices.meshes[indexes.mesh_index];
-		mesh.bone_mats_mesh_space[indexes.bone_index] = m;
+		mesh.bone_mats_mesh_space[indices.bone_index] = m;
 	}
 }
\ No newline at end of file
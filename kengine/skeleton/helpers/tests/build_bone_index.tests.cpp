@@ -0,0 +1,26 @@
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/skeleton/helpers/build_bone_index.hpp"
+
+TEST(skeleton_helper, build_bone_index) {
+	const kengine::skeleton::bone_names names{
+		.meshes = {
+			{ { "root", "arm" } },
+			{ { "arm", "leg" } },
+		}
+	};
+
+	const auto index = kengine::skeleton::build_bone_index(names);
+	EXPECT_EQ(index.bones.size(), 3);
+
+	// First occurrence wins
+	const auto & arm = index.bones.find(std::string_view("arm"))->second;
+	EXPECT_EQ(arm.mesh_index, 0);
+	EXPECT_EQ(arm.bone_index, 1);
+
+	const auto & leg = index.bones.find(std::string_view("leg"))->second;
+	EXPECT_EQ(leg.mesh_index, 1);
+	EXPECT_EQ(leg.bone_index, 1);
+}
\ No newline at end of file
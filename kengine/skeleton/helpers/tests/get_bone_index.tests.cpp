@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 // kengine
+#include "kengine/skeleton/helpers/build_bone_index.hpp"
 #include "kengine/skeleton/helpers/get_bone_index.hpp"
 
 TEST(skeleton_helper, get_bone_index) {
@@ -32,4 +33,23 @@ TEST(skeleton_helper, get_bone_index) {
 	index = kengine::skeleton::get_bone_index(r, "1.1", names);
 	EXPECT_EQ(index.mesh_index, 1);
 	EXPECT_EQ(index.bone_index, 1);
+}
+
+TEST(skeleton_helper, get_bone_index_from_index) {
+	const kengine::skeleton::bone_names names{
+		.meshes = {
+			{ { "0.0", "0.1" } },
+			{ { "1.0", "1.1" } },
+		}
+	};
+
+	const auto bone_index = kengine::skeleton::build_bone_index(names);
+	const entt::registry r;
+
+	for (const auto & name : { "0.0", "0.1", "1.0", "1.1" }) {
+		const auto expected = kengine::skeleton::get_bone_index(r, name, names);
+		const auto index = kengine::skeleton::get_bone_index(r, name, bone_index);
+		EXPECT_EQ(index.mesh_index, expected.mesh_index);
+		EXPECT_EQ(index.bone_index, expected.bone_index);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,12 @@
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/skeleton/data/bone_matrices.hpp"
+#include "kengine/skeleton/helpers/get_pose_pool.hpp"
+
+TEST(skeleton_helper, get_pose_pool) {
+	kengine::skeleton::bone_matrices::mesh mesh;
+	mesh.bone_mats_mesh_space.resize(42);
+	EXPECT_EQ(mesh.bone_mats_mesh_space.get_allocator().resource(), kengine::skeleton::get_pose_pool());
+}
\ No newline at end of file
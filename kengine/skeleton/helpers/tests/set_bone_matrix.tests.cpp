@@ -13,7 +13,7 @@ TEST(skeleton_helper, set_bone_matrix) {
 	const auto bone_name = "bone";
 
 	kengine::skeleton::bone_matrices matrices{
-		.meshes = { {} }
+		.meshes = { { .bone_mats_mesh_space = { glm::mat4{ 1.f } } } }
 	};
 
 	const kengine::skeleton::bone_names names{
@@ -0,0 +1,51 @@
+#include "system.hpp"
+
+// entt
+#include <entt/entity/handle.hpp>
+#include <entt/entity/registry.hpp>
+
+// kengine
+#include "kengine/core/log/helpers/kengine_log.hpp"
+#include "kengine/core/profiling/helpers/kengine_profiling_scope.hpp"
+#include "kengine/skeleton/data/bone_index.hpp"
+#include "kengine/skeleton/data/bone_names.hpp"
+#include "kengine/skeleton/helpers/build_bone_index.hpp"
+
+namespace kengine::skeleton::index {
+	static constexpr auto log_category = "skeleton_index";
+
+	struct system {
+		entt::registry & r;
+
+		const entt::scoped_connection connections[3] = {
+			r.on_construct<bone_names>().connect<&system::index_bones>(this),
+			r.on_update<bone_names>().connect<&system::index_bones>(this),
+			r.on_destroy<bone_names>().connect<&system::remove_index>(this),
+		};
+
+		system(entt::handle e) noexcept
+			: r(*e.registry()) {
+			KENGINE_PROFILING_SCOPE;
+			kengine_log(r, log, log_category, "Initializing");
+
+			for (const auto & [entity, names] : r.view<bone_names>().each())
+				index_bones(r, entity);
+		}
+
+		void index_bones(entt::registry &, entt::entity e) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, verbose, log_category, "Indexing bones for {}", e);
+
+			r.emplace_or_replace<bone_index>(e, build_bone_index(r.get<bone_names>(e)));
+		}
+
+		void remove_index(entt::registry &, entt::entity e) noexcept {
+			KENGINE_PROFILING_SCOPE;
+			kengine_logf(r, verbose, log_category, "Removing bone index for {}", e);
+
+			r.remove<bone_index>(e);
+		}
+	};
+
+	DEFINE_KENGINE_SYSTEM_CREATOR(system)
+}
\ No newline at end of file
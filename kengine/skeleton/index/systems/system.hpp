@@ -0,0 +1,8 @@
+#pragma once
+
+// kengine
+#include "kengine/system_creator/helpers/system_creator_helper.hpp"
+
+namespace kengine::skeleton::index {
+	DECLARE_KENGINE_SYSTEM_CREATOR(KENGINE_SKELETON_INDEX_EXPORT, system)
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+// entt
+#include <entt/entity/registry.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// kengine
+#include "kengine/skeleton/data/bone_index.hpp"
+#include "kengine/skeleton/data/bone_names.hpp"
+#include "kengine/skeleton/index/systems/system.hpp"
+
+TEST(skeleton_index, follows_bone_names) {
+	entt::registry r;
+	kengine::skeleton::index::add_system(r);
+
+	const auto e = r.create();
+	r.emplace<kengine::skeleton::bone_names>(e, kengine::skeleton::bone_names{ .meshes = { { { "root", "arm" } } } });
+	ASSERT_TRUE(r.all_of<kengine::skeleton::bone_index>(e));
+	EXPECT_EQ(r.get<kengine::skeleton::bone_index>(e).bones.size(), 2);
+
+	r.patch<kengine::skeleton::bone_names>(e, [](kengine::skeleton::bone_names & names) noexcept { names.meshes[0].bone_names.push_back("leg"); });
+	EXPECT_EQ(r.get<kengine::skeleton::bone_index>(e).bones.size(), 3);
+
+	r.remove<kengine::skeleton::bone_names>(e);
+	EXPECT_FALSE(r.all_of<kengine::skeleton::bone_index>(e));
+}
\ No newline at end of file